@@ -443,6 +443,17 @@ tool "slang-test"
     includedirs { "." }
     links { "core", "slang" }
 
+--
+-- The `slang-bench` benchmark measures end-to-end compiler throughput.
+-- Like `slang-test` it uses the `core` library along with the
+-- public Slang API:
+--
+
+tool "slang-bench"
+    uuid "A6E5D3F1-4C1B-4E8A-9D2B-7F3C51B0E2A4"
+    includedirs { "." }
+    links { "core", "slang" }
+
 --
 -- The reflection test harness `slang-reflection-test` is pretty
 -- simple, in that it only needs to link against the slang library
@@ -571,8 +582,10 @@ standardProject "slang"
     dependson { "slang-generate" }
 
     filter { "system:linux" }
+        -- Parsing can use threads (see `SLANG_COMPILE_FLAG_PARALLEL_PARSE`)
+        links { "dl", "pthread" }
 	-- might be able to do pic(true)
-        buildoptions{"-fPIC"}
+        buildoptions{"-fPIC", "-pthread"}
        
     -- Next, we want to add a custom build rule for each of the
     -- files that makes up the standard library. Those are
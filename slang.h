@@ -448,6 +448,20 @@ extern "C"
         /* Skip code generation step, just check the code and generate layout */
         SLANG_COMPILE_FLAG_NO_CODEGEN           = 1 << 4,
 
+        /* Only check (and generate code for) the bodies of global functions that are
+        reachable from the requested entry points, or that are marked `public`. */
+        SLANG_COMPILE_FLAG_LAZY_FUNCTION_BODIES = 1 << 5,
+
+        /* Preprocess the translation units in parallel (when there is more than one).
+        The results are identical to those of preprocessing them one at a time. */
+        SLANG_COMPILE_FLAG_PARALLEL_PARSE       = 1 << 6,
+
+        /* Check the bodies of global functions in parallel (once the declarations they
+        depend on have been checked). The diagnostics are produced in the same order as
+        when checking the bodies one at a time. Has no effect with
+        SLANG_COMPILE_FLAG_LAZY_FUNCTION_BODIES. */
+        SLANG_COMPILE_FLAG_PARALLEL_CHECK       = 1 << 7,
+
         /* Deprecated flags: kept around to allow existing applications to
         compile. Note that the relevant features will still be left in
         their default state. */
@@ -466,6 +480,10 @@ extern "C"
            @deprecated This behavior is now enabled unconditionally.
         */
         SLANG_TARGET_FLAG_PARAMETER_BLOCKS_USE_REGISTER_SPACES = 1 << 4,
+
+        /* Don't inline calls to small functions when generating code for the target.
+           Calls to functions marked `[forceInline]` are still inlined. */
+        SLANG_TARGET_FLAG_NO_INLINING = 1 << 5,
     };
 
     /*!
@@ -1066,6 +1084,15 @@ extern "C"
         SlangCompileRequest*    request,
         int                     enable);
 
+    /*!
+    @brief Set whether to record statistics (time, instruction counts, memory) for each IR pass.
+
+    The statistics can be queried after compilation with `spGetIRPassStatCount` and `spGetIRPassStat`.
+    */
+    SLANG_API void spSetRecordIRPassStats(
+        SlangCompileRequest*    request,
+        int                     enable);
+
     /*!
     @brief Set whether (and how) `#line` directives should be output.
     */
@@ -1414,6 +1441,86 @@ extern "C"
         SlangCompileRequest*    request,
         int                     index);
 
+    /** Statistics recorded for a single run of an IR pass.
+    */
+    struct SlangIRPassStat
+    {
+        char const* passName;           ///< The name of the pass (valid for the lifetime of the request)
+        double      timeInSeconds;      ///< Wall-clock time spent in the pass
+        SlangUInt   instCountBefore;    ///< Number of IR instructions in the module before the pass
+        SlangUInt   instCountAfter;     ///< Number of IR instructions in the module after the pass
+        SlangUInt   memoryUsedBefore;   ///< Bytes used by the module's IR storage before the pass
+        SlangUInt   memoryUsedAfter;    ///< Bytes used by the module's IR storage after the pass
+    };
+
+    /** Get the number of IR passes that statistics were recorded for.
+
+    Statistics are only recorded if enabled with `spSetRecordIRPassStats`.
+    Front-end passes (run once per translation unit) come first, followed
+    by back-end passes (run for each entry point and target).
+    */
+    SLANG_API int
+    spGetIRPassStatCount(
+        SlangCompileRequest*    request);
+
+    /** Get the statistics recorded for an IR pass.
+    */
+    SLANG_API SlangResult
+    spGetIRPassStat(
+        SlangCompileRequest*    request,
+        int                     index,
+        SlangIRPassStat*        outStat);
+
+    /** Total time spent in one phase of compilation (e.g., `parse`, `check` or `emit`).
+    */
+    struct SlangCompilePhaseStat
+    {
+        char const* name;           ///< The name of the phase
+        double      timeInSeconds;  ///< Total wall-clock time over all runs of the phase
+        SlangUInt   count;          ///< The number of times the phase ran
+    };
+
+    /** A named counter recorded during compilation (e.g., the number of tokens parsed).
+    */
+    struct SlangCompileCounter
+    {
+        char const* name;
+        uint64_t    value;
+    };
+
+    /** Statistics recorded for a whole compile request.
+
+    Phases may nest (for example `parse` runs within `compile`), so their
+    times should not be summed.
+    */
+    struct SlangCompileStats
+    {
+        SlangUInt                       phaseCount;
+        SlangCompilePhaseStat const*    phases;
+        SlangUInt                       counterCount;
+        SlangCompileCounter const*      counters;
+    };
+
+    /*!
+    @brief Set whether to record timings and counters for the phases of compilation.
+
+    Must be called before `spCompile`. The results can be queried with `spGetCompileStats`.
+    */
+    SLANG_API void spSetRecordCompileStats(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /** Get the statistics recorded for a compile request.
+
+    The arrays referenced by `outStats` are owned by `request`, and are valid
+    until the next call to this function or until `request` is destroyed.
+    Returns `SLANG_FAIL` if recording was not enabled with `spSetRecordCompileStats`.
+    */
+    SLANG_API SlangResult
+    spGetCompileStats(
+        SlangCompileRequest*    request,
+        SlangCompileStats*      outStats);
+
     /** Get the number of translation units associated with the compilation request
     */
     SLANG_API int
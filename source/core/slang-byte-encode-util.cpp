@@ -1,6 +1,17 @@
 #include "slang-byte-encode-util.h"
 
+#if (SLANG_VC && SLANG_PROCESSOR_FAMILY_X86) || (SLANG_GCC_FAMILY && defined(__SSE2__))
+// SSE2 is always available on x86-64, and is the default target for 32 bit x86 on visual studio
+#   define SLANG_BYTE_ENCODE_USE_SSE2 1
+#   include <emmintrin.h>
+#   if SLANG_VC
+#       include <intrin.h>
+#   endif
+#endif
 
+#ifndef SLANG_BYTE_ENCODE_USE_SSE2
+#   define SLANG_BYTE_ENCODE_USE_SSE2 0
+#endif
 
 namespace Slang {
 
@@ -237,47 +248,142 @@ static const uint32_t s_unalignedUInt32Mask[5] =
     }
 }
 
-/* static */size_t ByteEncodeUtil::decodeLiteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut)
+// Decode a single value, returning the position after it
+SLANG_FORCE_INLINE static const uint8_t* _decodeLiteUInt32(const uint8_t* encodeIn, uint32_t* valueOut)
 {
-    const uint8_t* encodeStart = encodeIn;
+    typedef ByteEncodeUtil Util;
 
-    for (size_t i = 0; i < numValues; ++i)
+    uint8_t b0 = *encodeIn++;
+    if (b0 < Util::kLiteCut1)
+    {
+        *valueOut = uint32_t(b0);
+    }
+    else if (b0 < Util::kLiteCut2)
     {
-        uint8_t b0 = *encodeIn++;
-        if (b0 < kLiteCut1)
+        uint8_t b1 = *encodeIn++;
+        *valueOut = Util::kLiteCut1 + b1 + (uint32_t(b0 - Util::kLiteCut1) << 8);
+    }
+    else
+    {
+        int numBytesRemaining = b0 - Util::kLiteCut2 + 2 - 1;
+
+#if SLANG_BYTE_ENCODE_USE_UNALIGNED_ACCESS
+        const uint32_t mask = s_unalignedUInt32Mask[numBytesRemaining];
+        //const uint32_t mask = ~(uint32_t(0xffffff00) << ((numBytesRemaining - 1) * 8));
+        const uint32_t value = (*(const uint32_t*)encodeIn) & mask;
+#else
+        // This works on all cpus although slower
+        uint32_t value = encodeIn[0];
+        switch (numBytesRemaining)
         {
-            valuesOut[i] = uint32_t(b0);
+            case 4: value |= uint32_t(encodeIn[3]) << 24;         /* fall thru */
+            case 3: value |= uint32_t(encodeIn[2]) << 16;         /* fall thru */
+            case 2: value |= uint32_t(encodeIn[1]) << 8;          /* fall thru */
+            case 1: break;
         }
-        else if (b0 < kLiteCut2)
+#endif  
+        *valueOut = value;
+        encodeIn += numBytesRemaining;
+    }
+    return encodeIn;
+}
+
+/* static */size_t ByteEncodeUtil::decodeLiteUInt32Scalar(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut)
+{
+    const uint8_t* encodeStart = encodeIn;
+
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        encodeIn = _decodeLiteUInt32(encodeIn, valuesOut + i);
+    }
+
+    return size_t(encodeIn - encodeStart);
+}
+
+#if SLANG_BYTE_ENCODE_USE_SSE2
+
+// Returns the index of the least significant set bit. v cannot be 0.
+SLANG_FORCE_INLINE static int _calcLsb32(uint32_t v)
+{
+#if SLANG_VC
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return int(index);
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+/* static */size_t ByteEncodeUtil::decodeLiteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut)
+{
+    const uint8_t* encodeStart = encodeIn;
+
+    // Many values in the serialized IR (ops, small indices and counts) encode to a single byte, so we decode
+    // runs of single byte values 16 at a time.
+    //
+    // Every value takes at least one byte, so while there are at least 16 values left to decode, 16 bytes can be
+    // read from encodeIn, and 16 values written to valuesOut.
+
+    const __m128i zero = _mm_setzero_si128();
+    // SSE2 only has a signed byte compare, so bytes are offset by 128 (by flipping the top bit) to
+    // test b >= kLiteCut1 as a signed compare.
+    const __m128i signBit = _mm_set1_epi8(char(0x80));
+    const __m128i cutLimit = _mm_set1_epi8(char(kLiteCut1 - 1 - 0x80));
+
+    size_t i = 0;
+    while (numValues - i >= 16)
+    {
+        const __m128i bytes = _mm_loadu_si128((const __m128i*)encodeIn);
+        const __m128i isMultiByte = _mm_cmpgt_epi8(_mm_xor_si128(bytes, signBit), cutLimit);
+
+        // Number of single byte values at the start. Setting bit 16 means all 16 are single byte if no other bits are set.
+        const int numSingle = _calcLsb32(uint32_t(_mm_movemask_epi8(isMultiByte)) | 0x10000);
+        if (numSingle)
         {
-            uint8_t b1 = *encodeIn++;
-            valuesOut[i] = kLiteCut1 + b1 + (uint32_t(b0 - kLiteCut1) << 8);
+            // Widen all 16 bytes, even if not all of them are single byte values. Any values written
+            // past numSingle will be overwritten as decoding continues.
+            const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+            const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+            __m128i* dst = (__m128i*)(valuesOut + i);
+            _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(hi, zero));
+
+            encodeIn += numSingle;
+            i += numSingle;
         }
-        else
+        if (numSingle < 8)
         {
-            int numBytesRemaining = b0 - kLiteCut2 + 2 - 1;
-
-#if SLANG_BYTE_ENCODE_USE_UNALIGNED_ACCESS
-            const uint32_t mask = s_unalignedUInt32Mask[numBytesRemaining];
-            //const uint32_t mask = ~(uint32_t(0xffffff00) << ((numBytesRemaining - 1) * 8));
-            const uint32_t value = (*(const uint32_t*)encodeIn) & mask;
-#else
-            // This works on all cpus although slower
-            uint32_t value = encodeIn[0];
-            switch (numBytesRemaining)
+            // The run was short, which is typical of data where multi byte values are common. Testing for runs
+            // would then just add overhead, so decode the next 16 values (or as many as remain) a value at a time.
+            const size_t end = (numValues - i < 16) ? numValues : (i + 16);
+            for (; i < end; ++i)
             {
-                case 4: value |= uint32_t(encodeIn[3]) << 24;         /* fall thru */
-                case 3: value |= uint32_t(encodeIn[2]) << 16;         /* fall thru */
-                case 2: value |= uint32_t(encodeIn[1]) << 8;          /* fall thru */
-                case 1: break;
+                encodeIn = _decodeLiteUInt32(encodeIn, valuesOut + i);
             }
-#endif  
-            valuesOut[i] = value;
-            encodeIn += numBytesRemaining;
+        }
+        else if (numSingle < 16)
+        {
+            // Decode the multi byte value that ended the run
+            encodeIn = _decodeLiteUInt32(encodeIn, valuesOut + i);
+            i++;
         }
     }
 
+    // Decode whatever remains
+    encodeIn += decodeLiteUInt32Scalar(encodeIn, numValues - i, valuesOut + i);
     return size_t(encodeIn - encodeStart);
 }
 
+#else
+
+/* static */size_t ByteEncodeUtil::decodeLiteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut)
+{
+    return decodeLiteUInt32Scalar(encodeIn, numValues, valuesOut);
+}
+
+#endif
+
 } // namespace Slang
@@ -78,9 +78,13 @@ struct ByteEncodeUtil
         @param numValues The amount of values to be decoded (NOTE! This is the number of valuesOut, not encodeIn)
         @param valuesOut The buffer to hold the encoded value. MUST be large enough to hold the encoding
         @return The amount of bytes decoded
+        Uses SIMD (where available) to decode runs of single byte values.
         */
     static size_t decodeLiteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut); 
 
+        /// Same as decodeLiteUInt32, but decodes one value at a time without using SIMD
+    static size_t decodeLiteUInt32Scalar(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut);
+
         /// Table that maps 8 bits to it's most significant bit. If 0 returns -1.
     static const int8_t s_msb8[256];
 };
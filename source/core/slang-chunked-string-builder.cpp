@@ -0,0 +1,138 @@
+#include "slang-chunked-string-builder.h"
+
+namespace Slang {
+
+/* static */const UInt ChunkedStringBuilder::kMinChunkSize;
+/* static */const UInt ChunkedStringBuilder::kMaxChunkSize;
+
+void ChunkedStringBuilder::_finishChunk()
+{
+    if (m_chunkEnd)
+    {
+        StringRepresentation* rep = m_chunks.Last().getStringRepresentation();
+        rep->length = UInt(m_chunkCursor - rep->getData());
+        rep->getData()[rep->length] = 0;
+
+        m_chunkCursor = nullptr;
+        m_chunkEnd = nullptr;
+    }
+}
+
+void ChunkedStringBuilder::_appendToNewChunk(const char* text, UInt length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+    _finishChunk();
+
+    m_length += length;
+
+    // Chunks grow with the total length (so small strings don't take much memory, and large strings don't
+    // need many chunks), up to a limit, so that chunk allocations don't get too big.
+    UInt chunkSize = m_length;
+    chunkSize = (chunkSize < kMinChunkSize) ? kMinChunkSize : chunkSize;
+    chunkSize = (chunkSize > kMaxChunkSize) ? kMaxChunkSize : chunkSize;
+    chunkSize = (chunkSize < length) ? length : chunkSize;
+
+    StringRepresentation* rep = StringRepresentation::createWithCapacity(chunkSize);
+    m_chunks.Add(String(rep));
+
+    char* data = rep->getData();
+    memcpy(data, text, length);
+
+    m_chunkCursor = data + length;
+    m_chunkEnd = data + chunkSize;
+}
+
+void ChunkedStringBuilder::append(const char* text)
+{
+    if (text)
+    {
+        append(text, text + strlen(text));
+    }
+}
+
+void ChunkedStringBuilder::append(const String& string)
+{
+    const UInt length = string.Length();
+    if (length < kMinChunkSize)
+    {
+        append(string.begin(), string.end());
+        return;
+    }
+
+    _finishChunk();
+    m_chunks.Add(string);
+    m_length += length;
+}
+
+void ChunkedStringBuilder::prepend(const String& string)
+{
+    const UInt length = string.Length();
+    if (length)
+    {
+        m_chunks.Insert(0, string);
+        m_length += length;
+    }
+}
+
+void ChunkedStringBuilder::prepend(ChunkedStringBuilder& builder)
+{
+    if (builder.m_length)
+    {
+        builder._finishChunk();
+        m_chunks.InsertRange(0, builder.m_chunks.Buffer(), builder.m_chunks.Count());
+        m_length += builder.m_length;
+    }
+    builder.clear();
+}
+
+String ChunkedStringBuilder::produceString()
+{
+    _finishChunk();
+
+    // If there is only a single chunk, it can just be shared (as long as that doesn't hold on to a lot of unused memory)
+    if (m_chunks.Count() == 1)
+    {
+        StringRepresentation* rep = m_chunks[0].getStringRepresentation();
+        if (rep->capacity - rep->getLength() <= kMinChunkSize)
+        {
+            return m_chunks[0];
+        }
+    }
+
+    StringBuilder builder(m_length);
+    for (const auto& chunk : m_chunks)
+    {
+        builder.append(chunk.begin(), chunk.end());
+    }
+    return builder.ProduceString();
+}
+
+void ChunkedStringBuilder::clear()
+{
+    m_chunks.Clear();
+    m_length = 0;
+    m_chunkCursor = nullptr;
+    m_chunkEnd = nullptr;
+}
+
+void ChunkedStringBuilder::swapWith(ChunkedStringBuilder& rhs)
+{
+    m_chunks.SwapWith(rhs.m_chunks);
+
+    const UInt length = m_length;
+    m_length = rhs.m_length;
+    rhs.m_length = length;
+
+    char* chunkCursor = m_chunkCursor;
+    m_chunkCursor = rhs.m_chunkCursor;
+    rhs.m_chunkCursor = chunkCursor;
+
+    char* chunkEnd = m_chunkEnd;
+    m_chunkEnd = rhs.m_chunkEnd;
+    rhs.m_chunkEnd = chunkEnd;
+}
+
+} // namespace Slang
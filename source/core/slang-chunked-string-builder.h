@@ -0,0 +1,87 @@
+#ifndef SLANG_CHUNKED_STRING_BUILDER_H
+#define SLANG_CHUNKED_STRING_BUILDER_H
+
+#include "slang-string.h"
+#include "list.h"
+
+#include <string.h>
+
+namespace Slang {
+
+/* Builds up a (potentially very large) string as a list of chunks.
+
+Unlike a StringBuilder, text that has been appended is never moved when more is appended - a new chunk is started
+when the current one is full. Text can also be prepended (for example a header whose contents are only known once
+the body has been built) without moving anything.
+
+produceString copies all the chunks into a single String of exactly the right size, which is the only time the
+text is copied. That String can then be shared (e.g. by a blob) without any further copies. */
+class ChunkedStringBuilder
+{
+public:
+    static const UInt kMinChunkSize = 1024;
+    static const UInt kMaxChunkSize = 1024 * 1024;
+
+        /// Append the text from textBegin to textEnd
+    SLANG_FORCE_INLINE void append(const char* textBegin, const char* textEnd)
+    {
+        const UInt length = UInt(textEnd - textBegin);
+        if (length <= UInt(m_chunkEnd - m_chunkCursor))
+        {
+            memcpy(m_chunkCursor, textBegin, length);
+            m_chunkCursor += length;
+            m_length += length;
+        }
+        else
+        {
+            _appendToNewChunk(textBegin, length);
+        }
+    }
+    void append(const UnownedStringSlice& slice) { append(slice.begin(), slice.end()); }
+    void append(const char* text);
+        /// Append a string. Large strings are added as a chunk without being copied.
+    void append(const String& string);
+
+        /// Add string before all of the text appended (or prepended) so far. The string is not copied.
+    void prepend(const String& string);
+        /// Move all the text from builder before all of the text in this builder. Builder is cleared.
+    void prepend(ChunkedStringBuilder& builder);
+
+        /// Get the total length of the text in chars
+    UInt getLength() const { return m_length; }
+
+        /// Get the chunks that make up the text, in order
+    const List<String>& getChunks() { _finishChunk(); return m_chunks; }
+
+        /// Produce a string holding all of the text
+    String produceString();
+
+        /// Remove all of the text
+    void clear();
+
+        /// Swap the contents with rhs
+    void swapWith(ChunkedStringBuilder& rhs);
+
+        /// Ctor
+    ChunkedStringBuilder() {}
+        /// Copying would share the chunk being appended to
+    ChunkedStringBuilder(const ChunkedStringBuilder&) = delete;
+    void operator=(const ChunkedStringBuilder&) = delete;
+
+protected:
+    void _appendToNewChunk(const char* text, UInt length);
+        /// Sets the length of the chunk being appended to, and stops appending to it
+    void _finishChunk();
+
+    List<String> m_chunks;
+    UInt m_length = 0;
+
+    // Text is appended directly to the last chunk (if it can be), between m_chunkCursor and m_chunkEnd. The
+    // length of the chunk is only set when it is finished.
+    char* m_chunkCursor = nullptr;
+    char* m_chunkEnd = nullptr;
+};
+
+} // namespace Slang
+
+#endif // SLANG_CHUNKED_STRING_BUILDER_H
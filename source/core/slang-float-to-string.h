@@ -0,0 +1,36 @@
+#ifndef SLANG_FLOAT_TO_STRING_H
+#define SLANG_FLOAT_TO_STRING_H
+
+#include "../../slang.h"
+
+namespace Slang {
+
+/* Converts floating point values to the shortest decimal text that converts back (with a correctly rounding
+parser such as strtod/strtof) to exactly the same value.
+
+The digits are found with the Schubfach algorithm (R. Giulietti, "The Schubfach way to render doubles"), which
+like Ryu only needs integer arithmetic and a table of powers of 10, so is fast and doesn't depend on the current
+C locale.
+
+The text is always a valid literal in C-like languages (such as HLSL and GLSL) - it always contains a '.' so it
+cannot be mistaken for an integer, for example "2.0", "0.015625", "1.5e-7", "1.0e30". Infinities and NaNs are
+written as "inf", "-inf" and "nan". */
+struct FloatToStringUtil
+{
+    enum
+    {
+        kMaxChars = 32,                 ///< Enough space for the text of any float or double
+    };
+
+        /** Write the shortest text that round trips value to outChars. The text is *not* zero terminated.
+        @param value The value to convert
+        @param outChars Where to write the text, must have space for at least kMaxChars chars
+        @return The number of chars written */
+    static int toChars(double value, char* outChars);
+        /// Same as toChars for a double, but finds the shortest text that round trips as a float
+    static int toChars(float value, char* outChars);
+};
+
+} // namespace Slang
+
+#endif // SLANG_FLOAT_TO_STRING_H
@@ -0,0 +1,308 @@
+#include "slang-lz-compress-util.h"
+
+#include <string.h>
+
+namespace Slang {
+
+// The compressed format follows the rules of LZ4 blocks, which allow the decompressor to use fast copies
+// for everything but the end of the data:
+// * The last kLastLiterals bytes are always literals
+// * A match can't start in the last kMatchStartLimit bytes
+// * Input smaller than kMinCompressSize is stored as just literals
+
+static const size_t kLastLiterals = 5;
+static const size_t kMatchStartLimit = 12;
+static const size_t kMinCompressSize = kMatchStartLimit + 1;
+
+static const int kHashBits = 12;
+
+static const uint32_t kMaxTokenLength = 15;
+
+SLANG_FORCE_INLINE static uint32_t _readUInt32(const uint8_t* in)
+{
+    uint32_t value;
+    memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+SLANG_FORCE_INLINE static uint32_t _hash(uint32_t value)
+{
+    // Knuth's multiplicative hash
+    return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+// Write the remainder of a length that didn't fit in a token
+SLANG_FORCE_INLINE static uint8_t* _writeLength(uint8_t* out, size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        *out++ = 255;
+    }
+    *out++ = uint8_t(length);
+    return out;
+}
+
+// Read the remainder of a length that didn't fit in a token. Returns false if the end of in is reached.
+SLANG_FORCE_INLINE static bool _readLength(const uint8_t*& in, const uint8_t* inEnd, size_t& lengthInOut)
+{
+    uint8_t b;
+    do
+    {
+        if (in >= inEnd)
+        {
+            return false;
+        }
+        b = *in++;
+        lengthInOut += b;
+    }
+    while (b == 255);
+    return true;
+}
+
+// Write a sequence of numLiterals from literals, followed by a match (if matchLength > 0)
+static uint8_t* _writeSequence(uint8_t* out, const uint8_t* literals, size_t numLiterals, size_t offset, size_t matchLength)
+{
+    uint8_t* token = out++;
+
+    if (numLiterals >= kMaxTokenLength)
+    {
+        *token = uint8_t(kMaxTokenLength << 4);
+        out = _writeLength(out, numLiterals - kMaxTokenLength);
+    }
+    else
+    {
+        *token = uint8_t(numLiterals << 4);
+    }
+
+    memcpy(out, literals, numLiterals);
+    out += numLiterals;
+
+    if (matchLength)
+    {
+        SLANG_ASSERT(offset > 0 && offset <= LZCompressUtil::kMaxOffset && matchLength >= LZCompressUtil::kMinMatch);
+
+        out[0] = uint8_t(offset);
+        out[1] = uint8_t(offset >> 8);
+        out += 2;
+
+        const size_t length = matchLength - LZCompressUtil::kMinMatch;
+        if (length >= kMaxTokenLength)
+        {
+            *token |= uint8_t(kMaxTokenLength);
+            out = _writeLength(out, length - kMaxTokenLength);
+        }
+        else
+        {
+            *token |= uint8_t(length);
+        }
+    }
+    return out;
+}
+
+/* static */size_t LZCompressUtil::compress(const void* srcIn, size_t srcSize, void* dstIn)
+{
+    const uint8_t* src = (const uint8_t*)srcIn;
+    const uint8_t* srcEnd = src + srcSize;
+
+    uint8_t* dst = (uint8_t*)dstIn;
+    uint8_t* out = dst;
+
+    // The start of the literals that haven't been written yet
+    const uint8_t* anchor = src;
+
+    if (srcSize >= kMinCompressSize)
+    {
+        const uint8_t* matchStartLimit = srcEnd - kMatchStartLimit;
+        const uint8_t* matchEndLimit = srcEnd - kLastLiterals;
+
+        // Holds the offset from src of the last position with each hash of the 4 bytes found there
+        uint32_t table[1 << kHashBits];
+        memset(table, 0, sizeof(table));
+
+        const uint8_t* cur = src;
+        while (cur < matchStartLimit)
+        {
+            const uint32_t value = _readUInt32(cur);
+            const uint32_t hash = _hash(value);
+
+            const uint8_t* match = src + table[hash];
+            table[hash] = uint32_t(cur - src);
+
+            if (match >= cur || size_t(cur - match) > kMaxOffset || _readUInt32(match) != value)
+            {
+                // Step faster through data that doesn't compress, the longer we go without finding a match
+                cur += 1 + (size_t(cur - anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match backwards over literals
+            while (cur > anchor && match > src && cur[-1] == match[-1])
+            {
+                --cur;
+                --match;
+            }
+
+            // Extend the match forwards
+            const uint8_t* matchEnd = cur + kMinMatch;
+            match += kMinMatch;
+            while (matchEnd < matchEndLimit && *matchEnd == *match)
+            {
+                ++matchEnd;
+                ++match;
+            }
+
+            out = _writeSequence(out, anchor, size_t(cur - anchor), size_t(matchEnd - match), size_t(matchEnd - cur));
+
+            // Add a position inside the match, so there are more positions to match against
+            if (matchEnd - 2 > cur)
+            {
+                table[_hash(_readUInt32(matchEnd - 2))] = uint32_t(matchEnd - 2 - src);
+            }
+
+            cur = matchEnd;
+            anchor = cur;
+        }
+    }
+
+    // The remaining bytes are literals
+    out = _writeSequence(out, anchor, size_t(srcEnd - anchor), 0, 0);
+
+    SLANG_ASSERT(size_t(out - dst) <= calcMaxCompressedSize(srcSize));
+    return size_t(out - dst);
+}
+
+/* static */void LZCompressUtil::compress(const void* src, size_t srcSize, List<uint8_t>& dstOut)
+{
+    dstOut.SetSize(UInt(calcMaxCompressedSize(srcSize)));
+    const size_t dstSize = compress(src, srcSize, dstOut.begin());
+    dstOut.SetSize(UInt(dstSize));
+}
+
+/* static */SlangResult LZCompressUtil::decompress(const void* srcIn, size_t srcSize, void* dstIn, size_t dstSize)
+{
+    const uint8_t* in = (const uint8_t*)srcIn;
+    const uint8_t* inEnd = in + srcSize;
+
+    uint8_t* dst = (uint8_t*)dstIn;
+    uint8_t* out = dst;
+    uint8_t* outEnd = dst + dstSize;
+
+    for (;;)
+    {
+        if (in >= inEnd)
+        {
+            return SLANG_FAIL;
+        }
+        const uint32_t token = *in++;
+
+        // Literals
+        {
+            size_t numLiterals = token >> 4;
+            if (numLiterals == kMaxTokenLength && !_readLength(in, inEnd, numLiterals))
+            {
+                return SLANG_FAIL;
+            }
+
+            if (numLiterals > size_t(inEnd - in) || numLiterals > size_t(outEnd - out))
+            {
+                return SLANG_FAIL;
+            }
+
+            if (numLiterals <= 16 && size_t(inEnd - in) >= 16 && size_t(outEnd - out) >= 16)
+            {
+                // Short runs are copied with a single fixed size copy. It may copy past the literals, but anything
+                // written past them will be overwritten.
+                memcpy(out, in, 16);
+            }
+            else
+            {
+                memcpy(out, in, numLiterals);
+            }
+            in += numLiterals;
+            out += numLiterals;
+        }
+
+        // The last sequence only has literals
+        if (in == inEnd)
+        {
+            break;
+        }
+
+        // Match
+        {
+            if (size_t(inEnd - in) < 2)
+            {
+                return SLANG_FAIL;
+            }
+            size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+            in += 2;
+
+            if (offset == 0 || offset > size_t(out - dst))
+            {
+                return SLANG_FAIL;
+            }
+
+            size_t matchLength = token & kMaxTokenLength;
+            if (matchLength == kMaxTokenLength && !_readLength(in, inEnd, matchLength))
+            {
+                return SLANG_FAIL;
+            }
+            matchLength += kMinMatch;
+
+            if (matchLength > size_t(outEnd - out))
+            {
+                return SLANG_FAIL;
+            }
+
+            const uint8_t* match = out - offset;
+            uint8_t* matchEnd = out + matchLength;
+
+            if (offset < 8)
+            {
+                // The match overlaps the bytes it writes, and repeats with a period of offset bytes. Copy bytes one
+                // at a time until the pattern has been written out a whole number of times covering at least 8 bytes,
+                // from then on whole 8 bytes can be copied from that far back.
+                size_t step = offset;
+                while (step < 8)
+                {
+                    step += offset;
+                }
+
+                uint8_t* stepEnd = out + step;
+                if (stepEnd > matchEnd)
+                {
+                    stepEnd = matchEnd;
+                }
+                while (out < stepEnd)
+                {
+                    *out++ = *match++;
+                }
+                match = out - step;
+            }
+
+            if (size_t(outEnd - matchEnd) >= 8)
+            {
+                // Copy 8 bytes at a time, possibly writing up to 7 bytes past the end of the match (which will be
+                // overwritten)
+                while (out < matchEnd)
+                {
+                    memcpy(out, match, 8);
+                    out += 8;
+                    match += 8;
+                }
+            }
+            else
+            {
+                while (out < matchEnd)
+                {
+                    *out++ = *match++;
+                }
+            }
+            out = matchEnd;
+        }
+    }
+
+    return (out == outEnd) ? SLANG_OK : SLANG_FAIL;
+}
+
+} // namespace Slang
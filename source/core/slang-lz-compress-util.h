@@ -0,0 +1,60 @@
+#ifndef SLANG_LZ_COMPRESS_UTIL_H
+#define SLANG_LZ_COMPRESS_UTIL_H
+
+#include "list.h"
+
+#include "../../slang.h"
+
+namespace Slang {
+
+/* A fast byte oriented LZ77 style compressor.
+
+The compressed data is a sequence of 'sequences', each of which is a run of literal bytes followed by a match - a copy
+of bytes that have already been decompressed. The layout of a sequence is the same as that used by LZ4 blocks.
+
+token               - The top 4 bits are the literal length, the bottom 4 bits are the match length - kMinMatch.
+                      A length of 15 means the length continues in bytes that follow (each 255 means keep going)
+[literal length]    - Only if the literal length in the token is 15
+literals
+offset              - 2 bytes, little endian. The distance back from the current position to copy from (1 - 65535)
+[match length]      - Only if the match length in the token is 15
+
+The last sequence only has literals. The compressor favors decompression speed over compression ratio, there is no
+entropy coding, and all copies are of whole bytes.
+*/
+struct LZCompressUtil
+{
+    enum
+    {
+        kMinMatch = 4,                          ///< The shortest match that can be encoded
+        kMaxOffset = 0xffff,                    ///< The largest distance a match can be from the data it copies
+    };
+
+        /// The largest size in bytes that srcSize bytes could take up compressed
+    static size_t calcMaxCompressedSize(size_t srcSize) { return srcSize + srcSize / 255 + 16; }
+
+        /** Compress src
+        @param src The data to compress
+        @param srcSize The size of the data to compress in bytes
+        @param dst Buffer to write the compressed data to. MUST be at least calcMaxCompressedSize(srcSize) bytes
+        @return The size of the compressed data in bytes
+        */
+    static size_t compress(const void* src, size_t srcSize, void* dst);
+
+        /// Compress src, setting the contents of dstOut to the compressed data
+    static void compress(const void* src, size_t srcSize, List<uint8_t>& dstOut);
+
+        /** Decompress src.
+        @param src The compressed data
+        @param srcSize The size of the compressed data in bytes
+        @param dst Buffer to write the decompressed data to
+        @param dstSize The size of the data when decompressed. Must be exactly the size of the data that was compressed.
+        @return SLANG_OK if src was successfully decompressed into exactly dstSize bytes, otherwise SLANG_FAIL.
+        Decompression never reads outside of src, or writes outside of dst, even if src is invalid.
+        */
+    static SlangResult decompress(const void* src, size_t srcSize, void* dst, size_t dstSize);
+};
+
+} // namespace Slang
+
+#endif // SLANG_LZ_COMPRESS_UTIL_H
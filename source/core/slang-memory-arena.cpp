@@ -1,6 +1,8 @@
 
 #include "slang-memory-arena.h"
 
+#include "common.h"
+
 namespace Slang {
 
 MemoryArena::MemoryArena()
@@ -157,6 +159,19 @@ void MemoryArena::deallocateAll()
     _resetCurrentBlock();
 }
 
+void MemoryArena::swapWith(ThisType& rhs)
+{
+    Swap(m_start, rhs.m_start);
+    Swap(m_end, rhs.m_end);
+    Swap(m_current, rhs.m_current);
+    Swap(m_blockPayloadSize, rhs.m_blockPayloadSize);
+    Swap(m_blockAllocSize, rhs.m_blockAllocSize);
+    Swap(m_blockAlignment, rhs.m_blockAlignment);
+    Swap(m_availableBlocks, rhs.m_availableBlocks);
+    Swap(m_usedBlocks, rhs.m_usedBlocks);
+    m_blockFreeList.swapWith(rhs.m_blockFreeList);
+}
+
 void MemoryArena::reset()
 {
     _deallocateBlocksPayload(m_usedBlocks);
@@ -310,10 +325,10 @@ void* MemoryArena::_allocateAlignedFromNewBlock(size_t size, size_t alignment)
     // Make the current block 
     _addCurrentBlock(block);
 
-    // Allocated memory is just the start of this block
-    uint8_t* memory = m_current;
-    // It must already be aligned
-    assert((size_t(m_current) & alignMask) == 0);
+    // Allocated memory is the start of this block, aligned up. A normal block is only aligned
+    // to the block alignment, which may be less than the requested alignment (allocSize
+    // includes space for this adjustment).
+    uint8_t* memory = (uint8_t*)((size_t(m_current) + alignMask) & ~alignMask);
 
     // Do the aligned allocation (which must fit) by aligning the pointer
     // It must fit if the previous code is correct...
@@ -140,6 +140,9 @@ public:
         /// Rewind (and effectively deallocate) all allocations *after* the cursor
     void rewindToCursor(const void* cursor);
 
+        /// Swap the contents (all allocations and backing memory) with rhs
+    void swapWith(ThisType& rhs);
+
         /// Default Ctor
     MemoryArena();
         /// Construct with block size and alignment. Block alignment must be a power of 2.
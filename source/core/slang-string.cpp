@@ -1,4 +1,5 @@
 #include "slang-string.h"
+#include "slang-float-to-string.h"
 #include "text-io.h"
 
 namespace Slang
@@ -382,6 +383,13 @@ namespace Slang
 
     void String::append(float val, const char * format)
     {
+        if (!format)
+        {
+            char* data = prepareForAppend(FloatToStringUtil::kMaxChars);
+            appendInPlace(data, UInt(FloatToStringUtil::toChars(val, data)));
+            return;
+        }
+
         enum { kCount = 128 };
         char* data = prepareForAppend(kCount);
         sprintf_s(data, kCount, format, val);
@@ -390,6 +398,13 @@ namespace Slang
 
     void String::append(double val, const char * format)
     {
+        if (!format)
+        {
+            char* data = prepareForAppend(FloatToStringUtil::kMaxChars);
+            appendInPlace(data, UInt(FloatToStringUtil::toChars(val, data)));
+            return;
+        }
+
         enum { kCount = 128 };
         char* data = prepareForAppend(kCount);
         sprintf_s(data, kCount, format, val);
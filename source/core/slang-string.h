@@ -368,8 +368,10 @@ namespace Slang
         void append(uint32_t value, int radix = 10);
         void append(int64_t value, int radix = 10);
         void append(uint64_t value, int radix = 10);
-        void append(float val, const char * format = "%g");
-        void append(double val, const char * format = "%g");
+            /// Append a floating point value. If format is null, the shortest text that converts back to the same
+            /// value is used (see FloatToStringUtil), otherwise it is a printf style format.
+        void append(float val, const char * format = nullptr);
+        void append(double val, const char * format = nullptr);
 
         void append(char const* str);
         void append(const char* textBegin, char const* textEnd);
@@ -394,11 +396,11 @@ namespace Slang
 		{
             append(val, radix);
 		}
-		String(float val, const char * format = "%g")
+		String(float val, const char * format = nullptr)
 		{
             append(val, format);
 		}
-		String(double val, const char * format = "%g")
+		String(double val, const char * format = nullptr)
 		{
             append(val, format);
 		}
@@ -809,17 +811,11 @@ namespace Slang
 		}
 		void Append(float val)
 		{
-			char buf[128];
-			sprintf_s(buf, 128, "%g", val);
-			int len = (int)strnlen_s(buf, 128);
-			Append(buf, len);
+			append(val);
 		}
 		void Append(double val)
 		{
-			char buf[128];
-			sprintf_s(buf, 128, "%g", val);
-			int len = (int)strnlen_s(buf, 128);
-			Append(buf, len);
+			append(val);
 		}
 		void Append(Int32 value, int radix = 10)
 		{
@@ -0,0 +1,117 @@
+#include "slang-thread-pool.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Slang {
+
+struct ThreadPool::Impl
+{
+    void workerMain();
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;         ///< Signalled when a batch is started, or the pool is stopping
+    std::condition_variable batchFinished;         ///< Signalled when the last task of a batch completes
+
+    // The current batch. Only accessed whilst holding the mutex.
+    TaskFunc func = nullptr;
+    void* context = nullptr;
+    UInt taskCount = 0;
+    UInt nextTaskIndex = 0;                        ///< The next task that hasn't been started
+    UInt unfinishedTaskCount = 0;                  ///< The number of tasks that haven't completed
+
+    bool isStopping = false;
+
+    std::vector<std::thread> threads;
+};
+
+void ThreadPool::Impl::workerMain()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        workAvailable.wait(lock, [this]() { return isStopping || nextTaskIndex < taskCount; });
+        if (isStopping)
+        {
+            return;
+        }
+
+        // Take the next task, and run it without holding the lock
+        const UInt taskIndex = nextTaskIndex++;
+        TaskFunc taskFunc = func;
+        void* taskContext = context;
+
+        lock.unlock();
+        taskFunc(taskContext, taskIndex);
+        lock.lock();
+
+        if (--unfinishedTaskCount == 0)
+        {
+            batchFinished.notify_all();
+        }
+    }
+}
+
+/* static */UInt ThreadPool::getDefaultThreadCount()
+{
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? UInt(count) : 1;
+}
+
+ThreadPool::ThreadPool(UInt threadCount):
+    m_threadCount(threadCount),
+    m_impl(new Impl)
+{
+    SLANG_ASSERT(threadCount > 0);
+    m_impl->threads.reserve(threadCount);
+    for (UInt i = 0; i < threadCount; ++i)
+    {
+        Impl* impl = m_impl;
+        m_impl->threads.push_back(std::thread([impl]() { impl->workerMain(); }));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        m_impl->isStopping = true;
+    }
+    m_impl->workAvailable.notify_all();
+
+    for (auto& thread : m_impl->threads)
+    {
+        thread.join();
+    }
+    delete m_impl;
+}
+
+void ThreadPool::runTasks(UInt taskCount, TaskFunc func, void* context)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_impl->mutex);
+    SLANG_ASSERT(m_impl->unfinishedTaskCount == 0);
+
+    m_impl->func = func;
+    m_impl->context = context;
+    m_impl->taskCount = taskCount;
+    m_impl->nextTaskIndex = 0;
+    m_impl->unfinishedTaskCount = taskCount;
+
+    m_impl->workAvailable.notify_all();
+    m_impl->batchFinished.wait(lock, [this]() { return m_impl->unfinishedTaskCount == 0; });
+
+    // Reset, so the workers go back to waiting
+    m_impl->func = nullptr;
+    m_impl->context = nullptr;
+    m_impl->taskCount = 0;
+    m_impl->nextTaskIndex = 0;
+}
+
+} // namespace Slang
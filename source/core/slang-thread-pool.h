@@ -0,0 +1,61 @@
+#ifndef SLANG_THREAD_POOL_H
+#define SLANG_THREAD_POOL_H
+
+#include "smart-pointer.h"
+
+namespace Slang {
+
+/* A fixed set of worker threads that run batches of tasks.
+
+A batch is made up of a number of tasks, identified by index, and is run by calling a function for each index.
+The tasks of a batch can run in any order, and on any of the threads in the pool, so they must not share any state
+that isn't safe to access concurrently. Note that this includes reference counts - the reference counting of
+RefObject (and so String) is only thread safe whilst a `RefObject::ThreadSafeScope` exists, and the reference
+counting of COM objects is *not* thread safe.
+
+A task function must not throw - any exception should be caught by the task and passed back to the caller some
+other way, typically by storing it with the results of the task. */
+class ThreadPool
+{
+public:
+    typedef void (*TaskFunc)(void* context, UInt taskIndex);
+
+        /// Run `taskCount` tasks, calling `func(context, taskIndex)` for each task index, and wait for them all to finish.
+        /// Only one batch can be run at a time.
+    void runTasks(UInt taskCount, TaskFunc func, void* context);
+
+        /// Run `taskCount` tasks, calling `func(taskIndex)` for each, and wait for them all to finish.
+    template <typename F>
+    void runTasks(UInt taskCount, const F& func)
+    {
+        runTasks(taskCount, &_callFunc<F>, (void*)&func);
+    }
+
+        /// Get the number of worker threads
+    UInt getThreadCount() const { return m_threadCount; }
+
+        /// Get the number of threads that can usefully be used on the current machine (always at least 1)
+    static UInt getDefaultThreadCount();
+
+        /// Ctor. Starts `threadCount` worker threads, which wait for work until the pool is destroyed.
+    explicit ThreadPool(UInt threadCount);
+        /// Dtor. Stops and joins all the worker threads.
+    ~ThreadPool();
+
+private:
+    struct Impl;
+
+    template <typename F>
+    static void _callFunc(void* context, UInt taskIndex) { (*(const F*)context)(taskIndex); }
+
+        // Not copyable
+    ThreadPool(const ThreadPool&) = delete;
+    void operator=(const ThreadPool&) = delete;
+
+    UInt m_threadCount;
+    Impl* m_impl;
+};
+
+} // namespace Slang
+
+#endif // SLANG_THREAD_POOL_H
@@ -0,0 +1,17 @@
+#include "slang-timer.h"
+
+#include <chrono>
+
+namespace Slang {
+
+/* static */Timer::Ticks Timer::now()
+{
+    return Ticks(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+/* static */Timer::Ticks Timer::getTicksPerSecond()
+{
+    return Ticks(std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num);
+}
+
+} // namespace Slang
@@ -0,0 +1,24 @@
+#ifndef SLANG_TIMER_H
+#define SLANG_TIMER_H
+
+#include "../../slang.h"
+
+namespace Slang {
+
+    /// Reads a monotonic clock suitable for measuring elapsed (wall-clock) time.
+struct Timer
+{
+    typedef int64_t Ticks;
+
+        /// Get the current time in ticks
+    static Ticks now();
+        /// Get the number of ticks per second
+    static Ticks getTicksPerSecond();
+
+        /// Convert a tick count (typically a difference of two `now()` values) to seconds
+    static double toSeconds(Ticks ticks) { return double(ticks) / double(getTicksPerSecond()); }
+};
+
+} // namespace Slang
+
+#endif // SLANG_TIMER_H
@@ -0,0 +1,8 @@
+#include "smart-pointer.h"
+
+namespace Slang
+{
+
+/* static */std::atomic<int> RefObject::s_threadSafeScopeCount(0);
+
+} // namespace Slang
@@ -6,6 +6,7 @@
 #include "type-traits.h"
 
 #include <assert.h>
+#include <atomic>
 
 #include "../../slang.h"
 
@@ -16,10 +17,42 @@ namespace Slang
     typedef intptr_t Int;
 
     // Base class for all reference-counted objects
+    //
+    // Reference counts are normally updated with plain loads and stores. Whilst
+    // a `RefObject::ThreadSafeScope` exists (e.g., whilst function bodies are
+    // checked in parallel) they are updated with atomic read-modify-writes
+    // instead, so that an object can be referenced (and released) from more
+    // than one thread at a time. Nothing else about the object is made thread safe.
     class RefObject
     {
+    public:
+            /// Makes reference counting thread safe for as long as it exists.
+            /// Must be created before any other thread starts to share objects,
+            /// and destroyed only after they have all stopped.
+        struct ThreadSafeScope
+        {
+            ThreadSafeScope() { s_threadSafeScopeCount++; }
+            ~ThreadSafeScope() { s_threadSafeScopeCount--; }
+        };
+
     private:
-        UInt referenceCount;
+        std::atomic<UInt> referenceCount;
+
+        static std::atomic<int> s_threadSafeScopeCount;
+
+        static bool _isThreadSafe() { return s_threadSafeScopeCount.load(std::memory_order_relaxed) != 0; }
+
+            // Add `delta` to the reference count, returning the new count
+        UInt _changeReferenceCount(UInt delta)
+        {
+            if (_isThreadSafe())
+            {
+                return referenceCount.fetch_add(delta, std::memory_order_acq_rel) + delta;
+            }
+            const UInt count = referenceCount.load(std::memory_order_relaxed) + delta;
+            referenceCount.store(count, std::memory_order_relaxed);
+            return count;
+        }
 
     public:
         RefObject()
@@ -30,39 +63,46 @@ namespace Slang
             : referenceCount(0)
         {}
 
+            // Assigning doesn't change how many references there are to this object
+        RefObject& operator=(const RefObject &)
+        {
+            return *this;
+        }
+
         virtual ~RefObject()
         {}
 
         UInt addReference()
         {
-            return ++referenceCount;
+            return _changeReferenceCount(1);
         }
 
         UInt decreaseReference()
         {
-            return --referenceCount;
+            return _changeReferenceCount(UInt(-1));
         }
 
         UInt releaseReference()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            if(--referenceCount == 0)
+            SLANG_ASSERT(referenceCount.load(std::memory_order_relaxed) != 0);
+            const UInt count = _changeReferenceCount(UInt(-1));
+            if(count == 0)
             {
                 delete this;
-                return 0;
             }
-            return referenceCount;
+            return count;
         }
 
         bool isUniquelyReferenced()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            return referenceCount == 1;
+            const UInt count = referenceCount.load(std::memory_order_relaxed);
+            SLANG_ASSERT(count != 0);
+            return count == 1;
         }
 
         UInt debugGetReferenceCount()
         {
-            return referenceCount;
+            return referenceCount.load(std::memory_order_relaxed);
         }
     };
 
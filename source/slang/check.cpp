@@ -5,8 +5,12 @@
 #include "visitor.h"
 
 #include "../core/secure-crt.h"
+#include "../core/slang-thread-pool.h"
 #include <assert.h>
 
+#include <exception>
+#include <mutex>
+
 namespace Slang
 {
     RefPtr<TypeType> getTypeType(
@@ -157,19 +161,123 @@ namespace Slang
         }
     };
 
-    struct BasicTypeKeyPair
+    // A dense numbering of the scalar, vector, and matrix types over the
+    // built-in base types, used to index the conversion cost table.
+    //
+    // Scalars come first, then vectors (by element type and size), and
+    // then matrices (by element type, row count, and column count).
+    //
+    struct BasicTypeIndex
     {
-        BasicTypeKey type1, type2;
-        bool operator == (BasicTypeKeyPair p)
+        enum : UInt
+        {
+            kBaseTypeCount  = UInt(BaseType::CountOf),
+            kMaxVectorSize  = 4,
+            kMaxMatrixSize  = 4,
+
+            kScalarStart    = 0,
+            kVectorStart    = kScalarStart + kBaseTypeCount,
+            kMatrixStart    = kVectorStart + kBaseTypeCount * kMaxVectorSize,
+            kCount          = kMatrixStart + kBaseTypeCount * kMaxMatrixSize * kMaxMatrixSize,
+        };
+
+        static bool getBaseTypeIndex(Type* type, UInt& outIndex)
         {
-            return type1.aggVal == p.type1.aggVal && type2.aggVal == p.type2.aggVal;
+            auto basicType = as<BasicExpressionType>(type);
+            if (!basicType)
+                return false;
+            outIndex = UInt(basicType->baseType);
+            return outIndex < kBaseTypeCount;
         }
-        int GetHashCode()
+
+        static bool getSize(IntVal* val, UInt maxSize, UInt& outSize)
         {
-            return combineHash(type1.aggVal, type2.aggVal);
+            auto constVal = as<ConstantIntVal>(val);
+            if (!constVal || constVal->value < 1 || constVal->value > IntegerLiteralValue(maxSize))
+                return false;
+            outSize = UInt(constVal->value);
+            return true;
+        }
+
+            /// Get the dense index for `type`, if it is a scalar, vector or matrix of a fixed supported size.
+        static bool fromType(Type* type, UInt& outIndex)
+        {
+            UInt baseIndex = 0;
+            if (getBaseTypeIndex(type, baseIndex))
+            {
+                outIndex = kScalarStart + baseIndex;
+                return true;
+            }
+            else if (auto vectorType = as<VectorExpressionType>(type))
+            {
+                UInt elementCount = 0;
+                if (!getBaseTypeIndex(vectorType->elementType, baseIndex)
+                    || !getSize(vectorType->elementCount, kMaxVectorSize, elementCount))
+                    return false;
+
+                outIndex = kVectorStart + baseIndex * kMaxVectorSize + (elementCount - 1);
+                return true;
+            }
+            else if (auto matrixType = as<MatrixExpressionType>(type))
+            {
+                UInt rowCount = 0;
+                UInt colCount = 0;
+                if (!getBaseTypeIndex(matrixType->getElementType(), baseIndex)
+                    || !getSize(matrixType->getRowCount(), kMaxMatrixSize, rowCount)
+                    || !getSize(matrixType->getColumnCount(), kMaxMatrixSize, colCount))
+                    return false;
+
+                outIndex = kMatrixStart
+                    + (baseIndex * kMaxMatrixSize + (rowCount - 1)) * kMaxMatrixSize
+                    + (colCount - 1);
+                return true;
+            }
+            return false;
         }
     };
 
+    // A dense table of conversion costs between all pairs of types that
+    // have a `BasicTypeIndex`.
+    //
+    // Each entry is filled in the first time the corresponding coercion
+    // is queried. The entries are atomic, as function bodies may be checked
+    // in parallel - since the cost of a coercion never changes, it doesn't
+    // matter which thread fills in an entry.
+    //
+    struct BasicConversionCostTable
+    {
+        // Marks an entry that hasn't been computed yet.
+        static const ConversionCost kNotComputed = kConversionCost_Impossible - 1;
+
+        ConversionCost getCost(UInt toIndex, UInt fromIndex)
+        {
+            return m_costs[toIndex * BasicTypeIndex::kCount + fromIndex].load(std::memory_order_relaxed);
+        }
+        void setCost(UInt toIndex, UInt fromIndex, ConversionCost cost)
+        {
+            m_costs[toIndex * BasicTypeIndex::kCount + fromIndex].store(cost, std::memory_order_relaxed);
+        }
+
+        BasicConversionCostTable()
+        {
+            const UInt count = UInt(BasicTypeIndex::kCount) * BasicTypeIndex::kCount;
+            m_costs = new std::atomic<ConversionCost>[count];
+            for (UInt i = 0; i < count; ++i)
+                m_costs[i].store(kNotComputed, std::memory_order_relaxed);
+        }
+        ~BasicConversionCostTable()
+        {
+            delete[] m_costs;
+        }
+
+    private:
+        // Not copyable
+        BasicConversionCostTable(const BasicConversionCostTable&) = delete;
+        void operator=(const BasicConversionCostTable&) = delete;
+
+        std::atomic<ConversionCost>* m_costs;
+    };
+
     struct OverloadCandidate
     {
         enum class Flavor
@@ -281,10 +389,356 @@ namespace Slang
         }
     };
 
+    // Identifies an overload set by the list of declarations that
+    // lookup found for a callee, in the order that lookup found them.
+    //
+    // Because the full list is part of the key, any change to the
+    // set of visible overloads (e.g., a user-declared overload that
+    // is only in scope at some call sites) results in a distinct key.
+    //
+    struct OverloadSetKey
+    {
+        List<DeclRef<Decl>> callees;
+        int hashCode = 0;
+
+        bool operator == (OverloadSetKey const& key) const
+        {
+            if (hashCode != key.hashCode)
+                return false;
+            if (callees.Count() != key.callees.Count())
+                return false;
+            for (UInt i = 0; i < callees.Count(); i++)
+            {
+                if (!callees[i].Equals(key.callees[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        int GetHashCode() const
+        {
+            return hashCode;
+        }
+
+            /// Initialize from an overloaded lookup result.
+            ///
+            /// Fails if any item has breadcrumbs, since those items
+            /// depend on more than just the declaration that was found.
+        bool fromLookupResult(LookupResult const& lookupResult)
+        {
+            callees.Clear();
+            hashCode = 0;
+
+            if (!lookupResult.isOverloaded())
+                return false;
+            for (auto item : lookupResult.items)
+            {
+                if (item.breadcrumbs)
+                    return false;
+                add(item.declRef);
+            }
+            return true;
+        }
+
+        void add(DeclRef<Decl> const& declRef)
+        {
+            callees.Add(declRef);
+            hashCode = combineHash(hashCode, declRef.GetHashCode());
+        }
+    };
+
+    // A key for memoizing the result of overload resolution for an arbitrary
+    // call site, based on the identity of the callee lookup result and the
+    // (canonical) types of the arguments.
+    //
+    // Unlike `OperatorOverloadCacheKey`, this key can represent any argument
+    // type (vectors, matrices, resources, user-defined `struct`s, etc.), but
+    // because it refers to declarations that might belong to a user module,
+    // it must only be used in a cache that doesn't outlive those modules.
+    //
+    struct OverloadResolutionCacheKey
+    {
+        enum class Fixity : uint8_t
+        {
+            None,
+            Prefix,
+            Postfix,
+        };
+
+        // The fixity of the call site (which affects which operator
+        // declarations are applicable).
+        Fixity fixity = Fixity::None;
+
+        // The declarations that were found by lookup for the callee.
+        OverloadSetKey overloadSet;
+
+        // The canonical types of the arguments at the call site.
+        List<RefPtr<Type>> argTypes;
+
+        int hashCode = 0;
+
+        bool operator == (OverloadResolutionCacheKey const& key) const
+        {
+            if (hashCode != key.hashCode)
+                return false;
+            if (fixity != key.fixity)
+                return false;
+            if (argTypes.Count() != key.argTypes.Count())
+                return false;
+            if (!(overloadSet == key.overloadSet))
+                return false;
+            for (UInt i = 0; i < argTypes.Count(); i++)
+            {
+                if (!argTypes[i]->Equals(key.argTypes[i].Ptr()))
+                    return false;
+            }
+            return true;
+        }
+
+        int GetHashCode() const
+        {
+            return hashCode;
+        }
+
+            /// Is `type` a type that overload resolution depends on only through its identity?
+        static bool isCacheableArgType(Type* type)
+        {
+            // Types that represent overload groups, initializer lists,
+            // or errors get special treatment during coercion and
+            // overload resolution, so we don't try to cache results
+            // that involve them.
+            //
+            if (as<DeclRefType>(type))
+                return true;
+            if (auto arrayType = as<ArrayExpressionType>(type))
+                return isCacheableArgType(arrayType->baseType);
+            return false;
+        }
+
+        bool fromInvokeExpr(InvokeExpr* expr)
+        {
+            argTypes.Clear();
+
+            if (as<PrefixExpr>(expr))
+                fixity = Fixity::Prefix;
+            else if (as<PostfixExpr>(expr))
+                fixity = Fixity::Postfix;
+            else
+                fixity = Fixity::None;
+
+            // We only handle callees that are either an overloaded
+            // lookup result, or a direct reference to a generic
+            // (where the cost of inferring generic arguments can
+            // be amortized).
+            //
+            auto funcExpr = expr->FunctionExpr;
+            if (auto overloadedExpr = as<OverloadedExpr>(funcExpr))
+            {
+                if (!overloadSet.fromLookupResult(overloadedExpr->lookupResult2))
+                    return false;
+            }
+            else if (auto declRefExpr = as<DeclRefExpr>(funcExpr))
+            {
+                if (!declRefExpr->declRef.as<GenericDecl>())
+                    return false;
+                overloadSet = OverloadSetKey();
+                overloadSet.add(declRefExpr->declRef);
+            }
+            else
+            {
+                return false;
+            }
+
+            int hash = combineHash(int(fixity), overloadSet.GetHashCode());
+            for (auto arg : expr->Arguments)
+            {
+                auto argType = arg->type.type;
+                if (!argType)
+                    return false;
+
+                auto canonicalType = argType->GetCanonicalType();
+                if (!isCacheableArgType(canonicalType))
+                    return false;
+
+                argTypes.Add(canonicalType);
+                hash = combineHash(hash, canonicalType->GetHashCode());
+            }
+
+            hashCode = hash;
+            return true;
+        }
+    };
+
+    // A coarse classification of types, used to quickly rule out
+    // overload candidates that could never accept a given argument.
+    //
+    enum class OverloadTypeCategory : uint8_t
+    {
+        Other,
+        Scalar,
+        Vector,
+        Matrix,
+        Resource,
+    };
+
+    OverloadTypeCategory getOverloadTypeCategory(Type* type)
+    {
+        if (!type)
+            return OverloadTypeCategory::Other;
+        if (as<BasicExpressionType>(type))
+            return OverloadTypeCategory::Scalar;
+        if (as<VectorExpressionType>(type))
+            return OverloadTypeCategory::Vector;
+        if (as<MatrixExpressionType>(type))
+            return OverloadTypeCategory::Matrix;
+        if (as<ResourceType>(type) || as<SamplerStateType>(type))
+            return OverloadTypeCategory::Resource;
+        return OverloadTypeCategory::Other;
+    }
+
+        /// Could an argument of category `argCategory` possibly be coerced to a parameter of category `paramCategory`?
+        ///
+        /// This mirrors the implicit conversions that the standard library declares:
+        /// scalars convert to scalars and vectors, vectors to vectors, and matrices
+        /// and resources only to themselves. Anything we can't classify is assumed
+        /// to be convertible.
+        ///
+    bool isPlausibleOverloadArg(OverloadTypeCategory argCategory, OverloadTypeCategory paramCategory)
+    {
+        if (argCategory == OverloadTypeCategory::Other || paramCategory == OverloadTypeCategory::Other)
+            return true;
+        if (argCategory == paramCategory)
+            return true;
+        if (argCategory == OverloadTypeCategory::Scalar && paramCategory == OverloadTypeCategory::Vector)
+            return true;
+        return false;
+    }
+
+    // An index over the items of an overload set, grouping callable
+    // declarations by the number of arguments they accept and the
+    // category of their first parameter.
+    //
+    // The index lets overload resolution skip candidates that would
+    // immediately fail their arity or coercion checks. It is always
+    // conservative: any item it cannot reason about is reported as
+    // plausible.
+    //
+    struct OverloadCandidateIndex : RefObject
+    {
+        struct Entry
+        {
+            UInt                    itemIndex;
+            OverloadTypeCategory    firstParamCategory;
+        };
+
+        // The total number of items in the overload set.
+        UInt itemCount = 0;
+
+        // Items that must be considered for any call (e.g., types
+        // being used as constructors, or declarations that haven't
+        // had their signatures checked yet).
+        List<UInt> unindexedItems;
+
+        // For each argument count, the indexed items that accept that
+        // many arguments, in the order they appear in the overload set.
+        List<List<Entry>> entriesByArgCount;
+
+        void build(LookupResult const& lookupResult)
+        {
+            itemCount = lookupResult.items.Count();
+            for (UInt ii = 0; ii < itemCount; ++ii)
+            {
+                Decl* decl = lookupResult.items[ii].declRef.getDecl();
+
+                // For generic functions we can filter on arity (because
+                // generic argument inference requires an exact match),
+                // but we leave the parameter types to full checking.
+                //
+                bool isGeneric = false;
+                if (auto genericDecl = as<GenericDecl>(decl))
+                {
+                    decl = genericDecl->inner;
+                    isGeneric = true;
+                }
+
+                auto callableDecl = as<CallableDecl>(decl);
+                if (!callableDecl || !callableDecl->IsChecked(DeclCheckState::CheckedHeader))
+                {
+                    unindexedItems.Add(ii);
+                    continue;
+                }
+
+                UInt requiredCount = 0;
+                UInt allowedCount = 0;
+                OverloadTypeCategory firstParamCategory = OverloadTypeCategory::Other;
+                for (auto paramDecl : callableDecl->getMembersOfType<ParamDecl>())
+                {
+                    if (allowedCount == 0 && !isGeneric)
+                        firstParamCategory = getOverloadTypeCategory(paramDecl->type.type);
+
+                    allowedCount++;
+                    if (!paramDecl->initExpr)
+                        requiredCount++;
+                }
+                if (isGeneric)
+                    requiredCount = allowedCount;
+
+                while (entriesByArgCount.Count() <= allowedCount)
+                    entriesByArgCount.Add(List<Entry>());
+
+                Entry entry;
+                entry.itemIndex = ii;
+                entry.firstParamCategory = firstParamCategory;
+                for (UInt count = requiredCount; count <= allowedCount; ++count)
+                    entriesByArgCount[count].Add(entry);
+            }
+        }
+
+            /// Collect the indices of items that might apply to a call, in overload-set order.
+        void getPlausibleItems(
+            UInt                    argCount,
+            OverloadTypeCategory    firstArgCategory,
+            List<UInt>&             outItems)
+        {
+            static const List<Entry> kEmptyEntries;
+            List<Entry> const& entries = argCount < entriesByArgCount.Count() ? entriesByArgCount[argCount] : kEmptyEntries;
+
+            // Merge the (sorted) indexed and unindexed item lists, so that
+            // candidates are still visited in their original order.
+            //
+            UInt ee = 0;
+            UInt uu = 0;
+            for (;;)
+            {
+                UInt entryItem = ee < entries.Count() ? entries[ee].itemIndex : itemCount;
+                UInt unindexedItem = uu < unindexedItems.Count() ? unindexedItems[uu] : itemCount;
+                if (entryItem == itemCount && unindexedItem == itemCount)
+                    break;
+
+                if (unindexedItem < entryItem)
+                {
+                    outItems.Add(unindexedItem);
+                    uu++;
+                }
+                else
+                {
+                    if (argCount == 0 || isPlausibleOverloadArg(firstArgCategory, entries[ee].firstParamCategory))
+                        outItems.Add(entryItem);
+                    ee++;
+                }
+            }
+        }
+    };
+
     struct TypeCheckingCache
     {
         Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
-        Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
+        BasicConversionCostTable conversionCostTable;
+
+        // Set to a mutex that is held whilst `resolvedOperatorOverloadCache` is
+        // accessed, for as long as function bodies are checked in parallel.
+        // Null otherwise, so that a serial check doesn't take a lock.
+        std::mutex* mutex = nullptr;
     };
 
     TypeCheckingCache* Session::getTypeCheckingCache()
@@ -387,6 +841,109 @@ namespace Slang
         Header, Body
     };
 
+        /// State shared by the visitors that check the bodies of global functions in parallel
+        /// (see `SemanticsVisitor::checkFunctionBodiesInParallel`).
+        ///
+        /// The work done for each declaration is recorded in a `Unit`: the diagnostics produced,
+        /// and the points at which the serial checker would have checked some other declaration
+        /// (and so produced its diagnostics) if it hadn't been checked already. Replaying the units
+        /// in declaration order reproduces the diagnostics of the serial checker.
+    struct ParallelBodyCheck
+    {
+        struct Unit : public RefObject
+        {
+            struct Item
+            {
+                Decl* checkedDecl = nullptr;        ///< If set, the point at which `checkedDecl` is checked. Otherwise this is a diagnostic.
+                String diagnostic;
+                int errorCount = 0;                 ///< The number of errors `diagnostic` adds
+            };
+
+            List<Item> items;
+            std::exception_ptr exception;           ///< Set if checking threw, after producing `items`
+            DeclCheckState startState;              ///< The state the declaration was in before any bodies were checked
+            bool isFunctionBody = false;            ///< True if this is one of the functions whose bodies are checked in parallel
+            std::atomic<bool> isChecked{false};     ///< For other declarations, set once the declaration has been checked
+            bool isReplayed = false;
+        };
+
+            /// Writes diagnostics into a `Unit`
+        class UnitWriter : public AppendBufferWriter
+        {
+        public:
+            typedef AppendBufferWriter Super;
+
+            // ISlangWriter
+            SLANG_NO_THROW virtual SlangResult SLANG_MCALL write(const char* chars, size_t numChars) SLANG_OVERRIDE
+            {
+                Unit::Item item;
+                item.diagnostic = String(chars, chars + numChars);
+                item.errorCount = m_sink->GetErrorCount() - m_errorCount;
+                m_errorCount = m_sink->GetErrorCount();
+                m_unit->items.Add(item);
+                return SLANG_OK;
+            }
+
+            UnitWriter(DiagnosticSink* sink)
+                : Super(WriterFlag::IsStatic)
+                , m_sink(sink)
+            {}
+
+            Unit* m_unit = nullptr;                 ///< The unit diagnostics are currently written to
+            DiagnosticSink* m_sink;
+            int m_errorCount = 0;
+        };
+
+            /// A unit for each function whose body is checked, and for each other declaration that
+            /// was not fully checked when checking started. Only read once checking has started.
+        Dictionary<Decl*, RefPtr<Unit>> units;
+
+            /// Get the unit for `decl`, or nullptr if it doesn't have one
+        Unit* getUnit(Decl* decl)
+        {
+            RefPtr<Unit>* unitPtr = units.TryGetValue(decl);
+            return unitPtr ? unitPtr->Ptr() : nullptr;
+        }
+
+            /// The functions whose bodies are checked, in declaration order
+        List<FuncDecl*> functions;
+            /// The index of the next function to be checked by any of the threads
+        std::atomic<UInt> nextFunctionIndex{0};
+
+            /// Held whilst checking a declaration other than one of `functions`
+        std::recursive_mutex mutex;
+
+            /// Held whilst updating state of the session that all of the checking threads share
+            /// (see `SharedStateScope`)
+        std::mutex nameMutex;
+        std::mutex operatorCacheMutex;
+        std::mutex memberDictionaryMutex;
+
+            /// Whilst it exists, the state of `session` that checking a function body can update
+            /// (reference counts, names, the operator overload cache and member dictionaries) is
+            /// safe to update from more than one thread. Outside of a parallel check none of it
+            /// is locked.
+        struct SharedStateScope
+        {
+            SharedStateScope(ParallelBodyCheck* parallelCheck, Session* session)
+                : m_session(session)
+            {
+                session->getRootNamePool()->mutex = &parallelCheck->nameMutex;
+                session->getTypeCheckingCache()->mutex = &parallelCheck->operatorCacheMutex;
+                session->memberDictionaryMutex = &parallelCheck->memberDictionaryMutex;
+            }
+            ~SharedStateScope()
+            {
+                m_session->getRootNamePool()->mutex = nullptr;
+                m_session->getTypeCheckingCache()->mutex = nullptr;
+                m_session->memberDictionaryMutex = nullptr;
+            }
+
+            RefObject::ThreadSafeScope m_threadSafeScope;
+            Session* m_session;
+        };
+    };
+
     struct SemanticsVisitor
         : ExprVisitor<SemanticsVisitor, RefPtr<Expr>>
         , StmtVisitor<SemanticsVisitor>
@@ -423,6 +980,41 @@ namespace Slang
         // out duplicate references during lookup.
         HashSet<ModuleDecl*> importedModules;
 
+        // Memoized results of overload resolution for general call sites.
+        //
+        // This cache is kept on the visitor (rather than in the session-wide
+        // `TypeCheckingCache`) because its keys may reference declarations
+        // from user modules, which are only guaranteed to stay alive for
+        // the duration of checking.
+        //
+        Dictionary<OverloadResolutionCacheKey, OverloadCandidate> resolvedOverloadCache;
+
+        // Candidate indices for large overload sets, used to pre-filter
+        // candidates when a call can't be resolved from the cache above.
+        Dictionary<OverloadSetKey, RefPtr<OverloadCandidateIndex>> overloadCandidateIndices;
+
+        // When set, checking of the bodies of global functions is deferred
+        // until they are found to be reachable (see `SLANG_COMPILE_FLAG_LAZY_FUNCTION_BODIES`).
+        bool m_deferFunctionBodies = false;
+
+        // The number of declarations that have been run through `EnsureDecl`
+        // (each declaration is counted once per phase it is checked for).
+        UInt m_checkedDeclCount = 0;
+
+        // Reachable functions whose body checking was deferred, and still needs to be done.
+        List<FunctionDeclBase*> m_functionBodiesToCheck;
+
+        // When set, the bodies of global functions are checked in parallel
+        // (see `SLANG_COMPILE_FLAG_PARALLEL_CHECK`).
+        bool m_checkFunctionBodiesInParallel = false;
+
+        // Set on each of the visitors that check function bodies in parallel.
+        ParallelBodyCheck* m_parallelBodyCheck = nullptr;
+        // The declaration that visitor is currently checking for `m_parallelBodyCheck`.
+        Decl* m_parallelCheckDecl = nullptr;
+        // Writes diagnostics to the unit of `m_parallelCheckDecl`
+        ParallelBodyCheck::UnitWriter* m_parallelCheckWriter = nullptr;
+
     public:
         SemanticsVisitor(
             Linkage*        linkage,
@@ -567,7 +1159,7 @@ namespace Slang
         {
             RefPtr<VarDecl> varDecl = new VarDecl();
             varDecl->ParentDecl = nullptr; // TODO: need to fill this in somehow!
-            varDecl->checkState = DeclCheckState::Checked;
+            varDecl->SetCheckState(DeclCheckState::Checked);
             varDecl->nameAndLoc.loc = expr->loc;
             varDecl->initExpr = expr;
             varDecl->type.type = expr->type.type;
@@ -704,11 +1296,304 @@ namespace Slang
             return expr;
         }
 
+            /// Record that `decl` is referenced from code that is being checked.
+            ///
+            /// When function body checking is deferred, this is what makes
+            /// a function reachable, so that its body will be checked.
+            ///
+        void noteDeclReferenced(Decl* decl)
+        {
+            if (!m_deferFunctionBodies)
+                return;
+
+            if (auto genericDecl = as<GenericDecl>(decl))
+                decl = genericDecl->inner;
+
+            auto funcDecl = as<FunctionDeclBase>(decl);
+            if (!funcDecl)
+                return;
+
+            // The flag is stored on the declaration, rather than in the
+            // visitor, because a function may be referenced from a
+            // different translation unit than the one that declares it.
+            //
+            if (funcDecl->isReferenced)
+                return;
+            funcDecl->isReferenced = true;
+
+            if (funcDecl->isBodyCheckDeferred)
+            {
+                funcDecl->isBodyCheckDeferred = false;
+                m_functionBodiesToCheck.Add(funcDecl);
+            }
+        }
+
+            /// Should checking of the body of `funcDecl` be deferred until it is found to be reachable?
+        bool shouldDeferFunctionBody(FunctionDeclBase* funcDecl)
+        {
+            if (!m_deferFunctionBodies)
+                return false;
+            if (funcDecl->isReferenced)
+                return false;
+
+            // Only global functions (possibly generic) are candidates
+            // for deferral; members of types may be needed to satisfy
+            // interface requirements.
+            //
+            auto parentDecl = funcDecl->ParentDecl;
+            if (auto genericDecl = as<GenericDecl>(parentDecl))
+                parentDecl = genericDecl->ParentDecl;
+            if (!as<ModuleDecl>(parentDecl))
+                return false;
+
+            // Functions marked `public` are considered to be exported,
+            // and are always checked.
+            //
+            if (funcDecl->HasModifier<PublicModifier>())
+                return false;
+
+            // Lowering merges redeclarations of a function, so we don't
+            // try to track reachability for them separately.
+            //
+            if (funcDecl->nextDecl || (funcDecl->primaryDecl && funcDecl->primaryDecl != funcDecl))
+                return false;
+
+            return true;
+        }
+
+            /// Add the declarations inside `decl` (and `decl` itself) that are not fully checked
+            /// to the units of `parallelCheck`
+        static void addUncheckedDeclUnits(ParallelBodyCheck* parallelCheck, Decl* decl)
+        {
+            // The contents of functions whose bodies are checked belong to the
+            // thread that checks the body.
+            if (parallelCheck->units.ContainsKey(decl))
+                return;
+
+            if (!decl->IsChecked(DeclCheckState::Checked))
+            {
+                RefPtr<ParallelBodyCheck::Unit> unit = new ParallelBodyCheck::Unit;
+                unit->startState = decl->checkState;
+                parallelCheck->units.Add(decl, unit);
+            }
+
+            if (auto containerDecl = as<ContainerDecl>(decl))
+            {
+                for (auto member : containerDecl->Members)
+                    addUncheckedDeclUnits(parallelCheck, member);
+            }
+        }
+
+            /// Check the bodies of `functions` (global functions that have only been checked up to
+            /// `CheckedHeader`), spread across a pool of threads.
+            ///
+            /// Each thread has a visitor and a sink of its own. Everything else that checking a body can
+            /// touch (e.g., types, reference counts, caches and member dictionaries) is either only read
+            /// or is made safe to update from more than one thread for the duration of the check (see
+            /// `ParallelBodyCheck::SharedStateScope`). Any other declaration that isn't fully
+            /// checked yet (such as a global variable) is checked by the first thread to need it, whilst
+            /// holding a lock.
+            ///
+            /// The diagnostics are then replayed in the order the serial checker would have produced them.
+        void checkFunctionBodiesInParallel(List<FuncDecl*> const& functions, ModuleDecl* moduleDecl)
+        {
+            ParallelBodyCheck parallelCheck;
+            parallelCheck.functions = functions;
+            for (auto funcDecl : functions)
+            {
+                RefPtr<ParallelBodyCheck::Unit> unit = new ParallelBodyCheck::Unit;
+                unit->startState = funcDecl->checkState;
+                unit->isFunctionBody = true;
+                parallelCheck.units.Add(funcDecl, unit);
+            }
+            for (auto member : moduleDecl->Members)
+            {
+                addUncheckedDeclUnits(&parallelCheck, member);
+            }
+
+            struct Worker : public RefObject
+            {
+                Worker(Linkage* linkage, DiagnosticSink* parentSink)
+                    : writer(&sink)
+                    , visitor(linkage, &sink)
+                {
+                    sink.sourceManager = parentSink->sourceManager;
+                    sink.flags = parentSink->flags;
+                    sink.writer = &writer;
+                }
+
+                DiagnosticSink sink;
+                ParallelBodyCheck::UnitWriter writer;
+                SemanticsVisitor visitor;
+            };
+
+            ThreadPool* threadPool = getSession()->getThreadPool();
+            const UInt threadCount = Math::Min(threadPool->getThreadCount(), functions.Count());
+            List<RefPtr<Worker>> workers;
+            for (UInt i = 0; i < threadCount; ++i)
+            {
+                RefPtr<Worker> worker = new Worker(m_linkage, getSink());
+                worker->visitor.checkingPhase = CheckingPhase::Body;
+                worker->visitor.m_parallelBodyCheck = &parallelCheck;
+                worker->visitor.m_parallelCheckWriter = &worker->writer;
+                workers.Add(worker);
+            }
+
+            {
+                ParallelBodyCheck::SharedStateScope sharedStateScope(&parallelCheck, getSession());
+                threadPool->runTasks(threadCount, [&](UInt workerIndex)
+                {
+                    auto& visitor = workers[workerIndex]->visitor;
+                    for (;;)
+                    {
+                        const UInt functionIndex = parallelCheck.nextFunctionIndex++;
+                        if (functionIndex >= functions.Count())
+                            break;
+
+                        FuncDecl* funcDecl = functions[functionIndex];
+                        ParallelBodyCheck::Unit* unit = parallelCheck.getUnit(funcDecl);
+
+                        visitor.m_parallelCheckDecl = funcDecl;
+                        visitor.m_parallelCheckWriter->m_unit = unit;
+                        try
+                        {
+                            visitor.checkDecl(funcDecl);
+                        }
+                        catch (...)
+                        {
+                            unit->exception = std::current_exception();
+                        }
+                    }
+                });
+            }
+
+            for (auto worker : workers)
+            {
+                m_checkedDeclCount += worker->visitor.m_checkedDeclCount;
+            }
+
+            for (auto funcDecl : functions)
+            {
+                replayParallelCheckUnit(&parallelCheck, parallelCheck.getUnit(funcDecl));
+            }
+        }
+
+            /// Pass on the diagnostics of `unit` (and of the units of any declarations it would have
+            /// checked first) to the sink, in the order the serial checker would produce them.
+        void replayParallelCheckUnit(ParallelBodyCheck* parallelCheck, ParallelBodyCheck::Unit* unit)
+        {
+            if (unit->isReplayed)
+                return;
+            unit->isReplayed = true;
+
+            for (auto& item : unit->items)
+            {
+                if (item.checkedDecl)
+                {
+                    replayParallelCheckUnit(parallelCheck, parallelCheck->getUnit(item.checkedDecl));
+                }
+                else
+                {
+                    getSink()->diagnoseRaw(Severity::Note, item.diagnostic.getUnownedSlice());
+                    getSink()->errorCount += item.errorCount;
+                }
+            }
+
+            if (unit->exception)
+            {
+                std::rethrow_exception(unit->exception);
+            }
+        }
+
+            /// Handles `EnsureDecl` for a visitor that is checking function bodies in parallel,
+            /// for the declarations that have units. Returns false if `EnsureDecl` should carry on
+            /// as normal.
+        bool ensureDeclForParallelBodyCheck(Decl* decl, DeclCheckState state)
+        {
+            ParallelBodyCheck::Unit* unit = m_parallelBodyCheck->getUnit(decl);
+            if (!unit || decl == m_parallelCheckDecl)
+                return false;
+
+            // Nothing would be checked for this request
+            if (state <= unit->startState)
+                return false;
+
+            // The serial checker would check the declaration here, if nothing had before
+            ParallelBodyCheck::Unit::Item item;
+            item.checkedDecl = decl;
+            m_parallelCheckWriter->m_unit->items.Add(item);
+
+            // The body of one of the functions is checked by whichever thread takes it
+            if (unit->isFunctionBody)
+                return true;
+
+            if (unit->isChecked)
+                return true;
+
+            std::lock_guard<std::recursive_mutex> lock(m_parallelBodyCheck->mutex);
+            if (unit->exception)
+            {
+                std::rethrow_exception(unit->exception);
+            }
+            if (unit->isChecked)
+                return true;
+
+            // Check it fully, recording what happens in its own unit
+            auto oldDecl = m_parallelCheckDecl;
+            auto oldUnit = m_parallelCheckWriter->m_unit;
+            m_parallelCheckDecl = decl;
+            m_parallelCheckWriter->m_unit = unit;
+            try
+            {
+                EnsureDecl(decl, DeclCheckState::Checked);
+            }
+            catch (...)
+            {
+                unit->exception = std::current_exception();
+                m_parallelCheckDecl = oldDecl;
+                m_parallelCheckWriter->m_unit = oldUnit;
+                throw;
+            }
+            m_parallelCheckDecl = oldDecl;
+            m_parallelCheckWriter->m_unit = oldUnit;
+
+            unit->isChecked = true;
+            return true;
+        }
+
+        void checkFunctionBody(FunctionDeclBase* funcDecl)
+        {
+            auto oldFunc = function;
+            this->function = as<FuncDecl>(funcDecl);
+            checkStmt(funcDecl->Body);
+            this->function = oldFunc;
+        }
+
+            /// Check the bodies of any deferred functions that have been found to be reachable.
+            ///
+            /// Checking one body can make more functions reachable, so this
+            /// continues until no more work is found.
+            ///
+        void checkReachableFunctionBodies()
+        {
+            auto oldPhase = checkingPhase;
+            checkingPhase = CheckingPhase::Body;
+            while (m_functionBodiesToCheck.Count() != 0)
+            {
+                auto funcDecl = m_functionBodiesToCheck.Last();
+                m_functionBodiesToCheck.RemoveLast();
+                checkFunctionBody(funcDecl);
+            }
+            checkingPhase = oldPhase;
+        }
+
         RefPtr<Expr> ConstructDeclRefExpr(
             DeclRef<Decl>   declRef,
             RefPtr<Expr>    baseExpr,
             SourceLoc       loc)
         {
+            noteDeclReferenced(declRef.getDecl());
+
             // Compute the type that this declaration reference will have in context.
             //
             auto type = GetTypeForDeclRef(declRef);
@@ -1085,6 +1970,7 @@ namespace Slang
         // so this may not be the best way to handle things.
         void EnsureDecl(RefPtr<Decl> decl, DeclCheckState state)
         {
+            if (m_parallelBodyCheck && ensureDeclForParallelBodyCheck(decl, state)) return;
             if (decl->IsChecked(state)) return;
             if (decl->checkState == DeclCheckState::CheckingHeader)
             {
@@ -1124,6 +2010,8 @@ namespace Slang
                 decl->SetCheckState(DeclCheckState::CheckingHeader);
             }
 
+            m_checkedDeclCount++;
+
             // Check the modifiers on the declaration first, in case
             // semantics of the body itself will depend on them.
             checkModifiers(decl);
@@ -2094,25 +2982,26 @@ namespace Slang
             RefPtr<Type>			fromType,		// the source type for the conversion
             ConversionCost*					outCost = 0)	// (optional) a place to stuff the conversion cost
         {
-            BasicTypeKey key1, key2;
-            BasicTypeKeyPair cacheKey;
-            bool shouldAddToCache = false;
-            ConversionCost cost;
-            TypeCheckingCache* typeCheckingCache = getSession()->getTypeCheckingCache();
-            if (key1.fromType(toType.Ptr()) && key2.fromType(fromType.Ptr()))
+            // Coercions between scalar, vector, and matrix types are by far
+            // the most common, so their costs are memoized in a dense table.
+            //
+            BasicConversionCostTable* costTable = nullptr;
+            UInt toIndex = 0;
+            UInt fromIndex = 0;
+            if (BasicTypeIndex::fromType(toType.Ptr(), toIndex) && BasicTypeIndex::fromType(fromType.Ptr(), fromIndex))
             {
-                cacheKey.type1 = key1;
-                cacheKey.type2 = key2;
+                costTable = &getSession()->getTypeCheckingCache()->conversionCostTable;
 
-                if (typeCheckingCache->conversionCostCache.TryGetValue(cacheKey, cost))
+                ConversionCost cost = costTable->getCost(toIndex, fromIndex);
+                if (cost != BasicConversionCostTable::kNotComputed)
                 {
                     if (outCost)
                         *outCost = cost;
                     return cost != kConversionCost_Impossible;
                 }
-                else
-                    shouldAddToCache = true;
             }
+
+            ConversionCost cost;
             bool rs = TryCoerceImpl(
                 toType,
                 nullptr,
@@ -2121,11 +3010,11 @@ namespace Slang
                 &cost);
             if (outCost)
                 *outCost = cost;
-            if (shouldAddToCache)
+            if (costTable)
             {
                 if (!rs)
                     cost = kConversionCost_Impossible;
-                typeCheckingCache->conversionCostCache[cacheKey] = cost;
+                costTable->setCost(toIndex, fromIndex, cost);
             }
             return rs;
         }
@@ -2297,7 +3186,7 @@ namespace Slang
             // of the parameters of the generic.
             if (decl->checkState == DeclCheckState::Unchecked)
             {
-                decl->checkState = getCheckedState();
+                decl->SetCheckState(getCheckedState());
                 CheckConstraintSubType(decl->sub);
                 decl->sub = TranslateTypeNodeForced(decl->sub);
                 decl->sup = TranslateTypeNodeForced(decl->sup);
@@ -2526,7 +3415,7 @@ namespace Slang
             }
             // add the attribute class definition to the syntax tree, so it can be found
             structAttribDef->ParentDecl->Members.Add(attribDecl.Ptr());
-            structAttribDef->ParentDecl->memberDictionaryIsValid = false;
+            structAttribDef->ParentDecl->memberDictionaryIsValid.store(false, std::memory_order_release);
             // do necessary checks on this newly constructed node
             checkDecl(attribDecl.Ptr());
             return attribDecl.Ptr();
@@ -3101,6 +3990,26 @@ namespace Slang
                         VisitFunctionDeclaration(func.Ptr());
                     }
                 }
+                // In the `Body` pass this is where the bodies of global
+                // functions get checked. By this point every global header
+                // has reached `CheckedHeader`, so each body check mostly
+                // reads shared declarations and writes its own subtree,
+                // and the bodies can be checked in parallel.
+                //
+                if (checkingPhase == CheckingPhase::Body && m_checkFunctionBodiesInParallel && !m_deferFunctionBodies)
+                {
+                    List<FuncDecl*> functions;
+                    for (auto & func : programNode->getMembersOfType<FuncDecl>())
+                    {
+                        if (!func->IsChecked(DeclCheckState::Checked))
+                            functions.Add(func);
+                    }
+                    if (functions.Count() > 1)
+                    {
+                        checkFunctionBodiesInParallel(functions, programNode);
+                    }
+                }
+
                 for (auto & func : programNode->getMembersOfType<FuncDecl>())
                 {
                     checkDecl(func);
@@ -3117,6 +4026,10 @@ namespace Slang
                     EnusreAllDeclsRec(d);
                 }
 
+                // Any global function bodies that were deferred, but
+                // have since been referenced, need to be checked now.
+                checkReachableFunctionBodies();
+
                 if (pass == 0)
                 {
                     checkInterfaceConformancesRec(programNode);
@@ -3461,7 +4374,7 @@ namespace Slang
             // now, so we won't worry about this.
 
             // Make sure that by-name lookup is possible.
-            buildMemberDictionary(typeDeclRef.getDecl());
+            buildMemberDictionary(getSession(), typeDeclRef.getDecl());
             auto lookupResult = lookUpLocal(getSession(), this, name, typeDeclRef);
 
             if (!lookupResult.isValid())
@@ -4150,10 +5063,10 @@ namespace Slang
                 // to avoid recursion here.
                 if (functionNode->Body)
                 {
-                    auto oldFunc = function;
-                    this->function = functionNode;
-                    checkStmt(functionNode->Body);
-                    this->function = oldFunc;
+                    if (shouldDeferFunctionBody(functionNode))
+                        functionNode->isBodyCheckDeferred = true;
+                    else
+                        checkFunctionBody(functionNode);
                 }
             }
         }
@@ -4376,7 +5289,7 @@ namespace Slang
             // symmetric, in that it is okay to test (A,B) or (B,A),
             // and there is no need to test both.
             //
-            buildMemberDictionary(parentDecl);
+            buildMemberDictionary(getSession(), parentDecl);
             for (auto pp = childDecl->nextInContainerWithSameName; pp; pp = pp->nextInContainerWithSameName)
             {
                 auto prevDecl = pp;
@@ -7111,7 +8024,6 @@ namespace Slang
             if (context.bestCandidates.Count() != 0)
             {
                 // We have multiple candidates right now, so filter them.
-                bool anyFiltered = false;
                 // Note that we are querying the list length on every iteration,
                 // because we might remove things.
                 for (UInt cc = 0; cc < context.bestCandidates.Count(); ++cc)
@@ -7121,12 +8033,15 @@ namespace Slang
                     {
                         // our new candidate is better!
 
+                        // If some existing candidate was better than this one, this one
+                        // can't also be better than another existing candidate (otherwise
+                        // the better-ness relation isn't transitive).
+                        SLANG_ASSERT(keepThisCandidate);
+
                         // remove it from the list (by swapping in a later one)
                         context.bestCandidates.FastRemoveAt(cc);
                         // and then reduce our index so that we re-visit the same index
                         --cc;
-
-                        anyFiltered = true;
                     }
                     else if(cmp > 0)
                     {
@@ -7134,12 +8049,6 @@ namespace Slang
                         keepThisCandidate = false;
                     }
                 }
-                // It should not be possible that we removed some existing candidate *and*
-                // chose not to keep this candidate (otherwise the better-ness relation
-                // isn't transitive). Therefore we confirm that we either chose to keep
-                // this candidate (in which case filtering is okay), or we didn't filter
-                // anything.
-                SLANG_ASSERT(keepThisCandidate || !anyFiltered);
             }
             else if(context.bestCandidate)
             {
@@ -7994,6 +8903,67 @@ namespace Slang
             }
         }
 
+        // Overload sets smaller than this are always scanned in full,
+        // since building and consulting an index wouldn't pay off.
+        static const UInt kMinIndexedOverloadSetSize = 8;
+
+            /// Try to add candidates from `lookupResult`, skipping those that an index says can't apply.
+            ///
+            /// Returns `false` if the caller should fall back to considering every item.
+            /// This happens when the set is too small to bother, or when none of the
+            /// plausible candidates turned out to be applicable (so that diagnostics
+            /// are based on the full set of candidates).
+            ///
+        bool AddIndexedOverloadCandidates(
+            LookupResult const&     lookupResult,
+            OverloadResolveContext& context)
+        {
+            if (lookupResult.items.Count() < kMinIndexedOverloadSetSize)
+                return false;
+
+            // If candidates from some other source have already been added,
+            // we can't cleanly undo our work on a fallback, so don't try.
+            if (context.bestCandidate || context.bestCandidates.Count() != 0)
+                return false;
+
+            OverloadSetKey key;
+            if (!key.fromLookupResult(lookupResult))
+                return false;
+
+            RefPtr<OverloadCandidateIndex> index;
+            if (!overloadCandidateIndices.TryGetValue(key, index))
+            {
+                index = new OverloadCandidateIndex();
+                index->build(lookupResult);
+                overloadCandidateIndices[key] = index;
+            }
+
+            UInt argCount = context.getArgCount();
+            OverloadTypeCategory firstArgCategory = OverloadTypeCategory::Other;
+            if (argCount != 0)
+                firstArgCategory = getOverloadTypeCategory(context.getArgType(0));
+
+            List<UInt> plausibleItems;
+            index->getPlausibleItems(argCount, firstArgCategory, plausibleItems);
+            if (plausibleItems.Count() == lookupResult.items.Count())
+                return false;
+
+            for (auto itemIndex : plausibleItems)
+            {
+                AddDeclRefOverloadCandidates(lookupResult.items[itemIndex], context);
+            }
+
+            OverloadCandidate* bestCandidate = context.bestCandidate;
+            if (!bestCandidate && context.bestCandidates.Count() != 0)
+                bestCandidate = &context.bestCandidates[0];
+            if (bestCandidate && bestCandidate->status == OverloadCandidate::Status::Appicable)
+                return true;
+
+            context.bestCandidate = nullptr;
+            context.bestCandidates.Clear();
+            return false;
+        }
+
         void AddOverloadCandidates(
             RefPtr<Expr>	funcExpr,
             OverloadResolveContext&			context)
@@ -8016,9 +8986,12 @@ namespace Slang
             {
                 auto lookupResult = overloadedExpr->lookupResult2;
                 SLANG_RELEASE_ASSERT(lookupResult.isOverloaded());
-                for(auto item : lookupResult.items)
+                if (!AddIndexedOverloadCandidates(lookupResult, context))
                 {
-                    AddDeclRefOverloadCandidates(item, context);
+                    for(auto item : lookupResult.items)
+                    {
+                        AddDeclRefOverloadCandidates(item, context);
+                    }
                 }
             }
             else if (auto overloadedExpr2 = as<OverloadedExpr2>(funcExpr))
@@ -8203,7 +9176,14 @@ namespace Slang
                 if (key.fromOperatorExpr(opExpr))
                 {
                     OverloadCandidate candidate;
-                    if (typeCheckingCache->resolvedOperatorOverloadCache.TryGetValue(key, candidate))
+                    bool isCached;
+                    {
+                        std::unique_lock<std::mutex> lock;
+                        if (typeCheckingCache->mutex)
+                            lock = std::unique_lock<std::mutex>(*typeCheckingCache->mutex);
+                        isCached = typeCheckingCache->resolvedOperatorOverloadCache.TryGetValue(key, candidate);
+                    }
+                    if (isCached)
                     {
                         context.bestCandidateStorage = candidate;
                         context.bestCandidate = &context.bestCandidateStorage;
@@ -8215,6 +9195,27 @@ namespace Slang
                 }
             }
 
+            // If the operator cache didn't apply, try the more general
+            // cache keyed on the callee lookup result and argument types.
+            bool shouldAddToOverloadCache = false;
+            OverloadResolutionCacheKey overloadKey;
+            if (!context.bestCandidate && !shouldAddToCache)
+            {
+                if (overloadKey.fromInvokeExpr(expr))
+                {
+                    OverloadCandidate candidate;
+                    if (resolvedOverloadCache.TryGetValue(overloadKey, candidate))
+                    {
+                        context.bestCandidateStorage = candidate;
+                        context.bestCandidate = &context.bestCandidateStorage;
+                    }
+                    else
+                    {
+                        shouldAddToOverloadCache = true;
+                    }
+                }
+            }
+
             // Look at the base expression for the call, and figure out how to invoke it.
             auto funcExpr = expr->FunctionExpr;
             auto funcExprType = funcExpr->type;
@@ -8356,7 +9357,17 @@ namespace Slang
                 // We will report errors for this one candidate, then, to give
                 // the user the most help we can.
                 if (shouldAddToCache)
+                {
+                    std::unique_lock<std::mutex> lock;
+                    if (typeCheckingCache->mutex)
+                        lock = std::unique_lock<std::mutex>(*typeCheckingCache->mutex);
                     typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
+                }
+                // Only applicable candidates are memoized in the general cache, so
+                // that a failing call site always goes through full resolution
+                // (and reports the full set of diagnostics).
+                if (shouldAddToOverloadCache && context.bestCandidate->status == OverloadCandidate::Status::Appicable)
+                    resolvedOverloadCache[overloadKey] = *context.bestCandidate;
                 return CompleteOverloadCandidate(context, *context.bestCandidate);
             }
             else
@@ -9262,7 +10273,7 @@ namespace Slang
         auto translationUnitSyntax = translationUnit->getModuleDecl();
 
         // Make sure we've got a query-able member dictionary
-        buildMemberDictionary(translationUnitSyntax);
+        buildMemberDictionary(translationUnit->getLinkage()->getSession(), translationUnitSyntax);
 
         // We will look up any global-scope declarations in the translation
         // unit that match the name of our entry point.
@@ -9616,7 +10627,7 @@ namespace Slang
         auto entryPointName = entryPointReq->getName();
 
         // Make sure we've got a query-able member dictionary
-        buildMemberDictionary(translationUnitSyntax);
+        buildMemberDictionary(compileRequest->getSession(), translationUnitSyntax);
 
         // We will look up any global-scope declarations in the translation
         // unit that match the name of our entry point.
@@ -10229,6 +11240,37 @@ static bool doesParameterMatch(
         }
     }
 
+        /// Check the bodies of all functions reachable from the entry points of `program`.
+        ///
+        /// This is only needed when checking of function bodies was deferred.
+        ///
+    static void _checkReachableFunctionBodies(
+        Linkage*        linkage,
+        DiagnosticSink* sink,
+        Program*        program)
+    {
+        SemanticsVisitor visitor(linkage, sink);
+        visitor.checkingPhase = CheckingPhase::Body;
+        visitor.m_deferFunctionBodies = true;
+
+        for (auto entryPoint : program->getEntryPoints())
+        {
+            auto funcDecl = entryPoint->getFuncDecl();
+            if (!funcDecl)
+                continue;
+
+            visitor.noteDeclReferenced(funcDecl);
+
+            if (auto attr = funcDecl->FindModifier<PatchConstantFuncAttribute>())
+            {
+                if (attr->patchConstantFuncDecl)
+                    visitor.noteDeclReferenced(attr->patchConstantFuncDecl);
+            }
+        }
+
+        visitor.checkReachableFunctionBodies();
+    }
+
         /// Create a `Program` to represent the compiled code.
         ///
         /// The created program will comprise all of the translation
@@ -10355,6 +11397,14 @@ static bool doesParameterMatch(
             }
         }
 
+        // If function body checking was deferred, then we now know
+        // the roots from which reachability is determined.
+        //
+        if (compileRequest->compileFlags & SLANG_COMPILE_FLAG_LAZY_FUNCTION_BODIES)
+        {
+            _checkReachableFunctionBodies(linkage, sink, program);
+        }
+
         program->_collectShaderParams(sink);
 
         return program;
@@ -10883,10 +11933,22 @@ static bool doesParameterMatch(
             translationUnit->compileRequest->getLinkage(),
             translationUnit->compileRequest->getSink());
 
+        if (translationUnit->compileRequest->compileFlags & SLANG_COMPILE_FLAG_LAZY_FUNCTION_BODIES)
+        {
+            visitor.m_deferFunctionBodies = true;
+        }
+        if (translationUnit->compileRequest->compileFlags & SLANG_COMPILE_FLAG_PARALLEL_CHECK)
+        {
+            visitor.m_checkFunctionBodiesInParallel = true;
+        }
+
         // Apply the visitor to do the main semantic
         // checking that is required on all declarations
         // in the translation unit.
         visitor.checkDecl(translationUnit->getModuleDecl());
+
+        if (auto compileStats = translationUnit->compileRequest->compileStats)
+            compileStats->addToCounter("declsChecked", visitor.m_checkedDeclCount);
     }
 
 
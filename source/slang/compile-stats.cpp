@@ -0,0 +1,146 @@
+// compile-stats.cpp
+#include "compile-stats.h"
+
+#include "../core/slang-string-util.h"
+
+namespace Slang {
+
+CompileStats::CompileStats()
+{
+    m_startTicks = Timer::now();
+}
+
+void CompileStats::addEvent(char const* name, Timer::Ticks startTicks, Timer::Ticks endTicks)
+{
+    Event event;
+    event.name = name;
+    event.startTicks = startTicks;
+    event.endTicks = endTicks;
+    m_events.Add(event);
+}
+
+void CompileStats::addToCounter(char const* name, uint64_t value)
+{
+    // There are only ever a handful of counters, so a linear search is fine.
+    for (UInt ii = 0; ii < m_counterNames.Count(); ++ii)
+    {
+        if (m_counterNames[ii] == name)
+        {
+            m_counterValues[ii] += value;
+            return;
+        }
+    }
+    m_counterNames.Add(name);
+    m_counterValues.Add(value);
+}
+
+void CompileStats::getStats(SlangCompileStats* outStats)
+{
+    // Phases are totalled by name, in the order in which
+    // each phase was first completed.
+    //
+    m_phaseNames.Clear();
+    m_phaseStats.Clear();
+    for (auto const& event : m_events)
+    {
+        UInt phaseIndex = m_phaseNames.IndexOf(event.name);
+        if (phaseIndex == UInt(-1))
+        {
+            phaseIndex = m_phaseNames.Count();
+            m_phaseNames.Add(event.name);
+
+            SlangCompilePhaseStat phaseStat;
+            phaseStat.name = nullptr;
+            phaseStat.timeInSeconds = 0.0;
+            phaseStat.count = 0;
+            m_phaseStats.Add(phaseStat);
+        }
+
+        auto& phaseStat = m_phaseStats[phaseIndex];
+        phaseStat.timeInSeconds += Timer::toSeconds(event.endTicks - event.startTicks);
+        phaseStat.count++;
+    }
+
+    // The names are only fixed once the list has stopped growing.
+    for (UInt ii = 0; ii < m_phaseStats.Count(); ++ii)
+        m_phaseStats[ii].name = m_phaseNames[ii].Buffer();
+
+    m_counters.Clear();
+    for (UInt ii = 0; ii < m_counterNames.Count(); ++ii)
+    {
+        SlangCompileCounter counter;
+        counter.name = m_counterNames[ii].Buffer();
+        counter.value = m_counterValues[ii];
+        m_counters.Add(counter);
+    }
+
+    outStats->phaseCount = m_phaseStats.Count();
+    outStats->phases = m_phaseStats.Buffer();
+    outStats->counterCount = m_counters.Count();
+    outStats->counters = m_counters.Buffer();
+}
+
+static void _appendJSONString(StringBuilder& out, String const& text)
+{
+    out << "\"";
+    for (auto c : text)
+    {
+        switch (c)
+        {
+        case '"':   out << "\\\""; break;
+        case '\\':  out << "\\\\"; break;
+        default:
+            {
+                char buffer[] = { c, 0 };
+                out << buffer;
+            }
+            break;
+        }
+    }
+    out << "\"";
+}
+
+void CompileStats::appendChromeTrace(StringBuilder& out)
+{
+    // Trace timestamps are in microseconds, relative to when
+    // recording started.
+    //
+    double ticksToMicroseconds = 1000000.0 / double(Timer::getTicksPerSecond());
+
+    Timer::Ticks endTicks = m_startTicks;
+
+    out << "{\"traceEvents\":[\n";
+    bool isFirst = true;
+    for (auto const& event : m_events)
+    {
+        if (!isFirst)
+            out << ",\n";
+        isFirst = false;
+
+        if (event.endTicks > endTicks)
+            endTicks = event.endTicks;
+
+        out << "{\"name\":";
+        _appendJSONString(out, event.name);
+        StringUtil::appendFormat(out, ",\"cat\":\"slang\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+            double(event.startTicks - m_startTicks) * ticksToMicroseconds,
+            double(event.endTicks - event.startTicks) * ticksToMicroseconds);
+    }
+
+    // The counters are reported once, at the end of the trace.
+    for (UInt ii = 0; ii < m_counterNames.Count(); ++ii)
+    {
+        if (!isFirst)
+            out << ",\n";
+        isFirst = false;
+
+        out << "{\"name\":";
+        _appendJSONString(out, m_counterNames[ii]);
+        StringUtil::appendFormat(out, ",\"cat\":\"slang\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"args\":{\"value\":%llu}}",
+            double(endTicks - m_startTicks) * ticksToMicroseconds,
+            (unsigned long long) m_counterValues[ii]);
+    }
+    out << "\n]}\n";
+}
+
+}
@@ -0,0 +1,89 @@
+// compile-stats.h
+#ifndef SLANG_COMPILE_STATS_H_INCLUDED
+#define SLANG_COMPILE_STATS_H_INCLUDED
+
+#include "../core/basic.h"
+#include "../core/slang-timer.h"
+
+#include "../../slang.h"
+
+namespace Slang
+{
+        /// Records timings of the phases of a compile, along with named counters.
+        ///
+        /// Each time a phase runs it is recorded as an event (see `CompilePhaseScope`).
+        /// Events can nest (e.g., `parse` runs inside `compile`), and the same phase
+        /// may run many times (e.g., `emit` once per entry point and target).
+        ///
+    class CompileStats : public RefObject
+    {
+    public:
+            /// A single timed run of a phase
+        struct Event
+        {
+            String          name;
+            Timer::Ticks    startTicks;
+            Timer::Ticks    endTicks;
+        };
+
+        CompileStats();
+
+            /// Record a run of the phase `name` between the two times
+        void addEvent(char const* name, Timer::Ticks startTicks, Timer::Ticks endTicks);
+
+            /// Add `value` to the counter `name` (creating it if needed)
+        void addToCounter(char const* name, uint64_t value);
+
+            /// Fill in `outStats` with the totals per phase, and the counters.
+            ///
+            /// The memory referenced by `outStats` is owned by this object, and
+            /// remains valid until the next call, or until this object is destroyed.
+            ///
+        void getStats(SlangCompileStats* outStats);
+
+            /// Append the recorded events and counters as Chrome trace-event JSON
+            /// (viewable with `chrome://tracing`).
+        void appendChromeTrace(StringBuilder& out);
+
+    protected:
+        Timer::Ticks m_startTicks;
+
+        List<Event> m_events;
+
+        List<String> m_counterNames;
+        List<uint64_t> m_counterValues;
+
+        // Storage for the results of `getStats`
+        List<String> m_phaseNames;
+        List<SlangCompilePhaseStat> m_phaseStats;
+        List<SlangCompileCounter> m_counters;
+    };
+
+        /// Records the time from construction to destruction as a run of the phase `name`.
+        ///
+        /// Does nothing if `stats` is null, so that code can be unconditionally instrumented.
+        ///
+    struct CompilePhaseScope
+    {
+        CompilePhaseScope(CompileStats* stats, char const* name)
+            : m_stats(stats)
+            , m_name(name)
+        {
+            if (stats)
+                m_startTicks = Timer::now();
+        }
+
+        ~CompilePhaseScope()
+        {
+            if (m_stats)
+                m_stats->addEvent(m_name, m_startTicks, Timer::now());
+        }
+
+    protected:
+        CompileStats*   m_stats;
+        char const*     m_name;
+        Timer::Ticks    m_startTicks = 0;
+    };
+}
+
+#endif
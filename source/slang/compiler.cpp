@@ -90,7 +90,8 @@ namespace Slang
 
         if (appendTo == ResultFormat::Text)
         {
-            outputString.append(result.outputString.Buffer());
+            // Appending to an empty string shares the text, rather than copying it
+            outputString.append(result.outputString);
         }
         else if (appendTo == ResultFormat::Binary)
         {
@@ -404,7 +405,23 @@ namespace Slang
         return translationUnit;
     }
 
-    String emitHLSLForEntryPoint(
+        /// Get the key for sharing code of the given `format` for an entry point between targets.
+    static Program::SharedCodeKey getSharedCodeKey(
+        Int             entryPointIndex,
+        CodeGenTarget   format,
+        TargetRequest*  targetReq)
+    {
+        Program::SharedCodeKey key;
+        key.entryPointIndex = entryPointIndex;
+        key.format = format;
+        key.profile = targetReq->getTargetProfile();
+        key.targetFlags = targetReq->targetFlags;
+        key.floatingPointMode = targetReq->getFloatingPointMode();
+        key.isFinalGLSL = format == CodeGenTarget::GLSL && targetReq->getTarget() == CodeGenTarget::GLSL;
+        return key;
+    }
+
+    static String _emitHLSLForEntryPoint(
         BackEndCompileRequest*  compileRequest,
         EntryPoint*             entryPoint,
         Int                     entryPointIndex,
@@ -456,7 +473,27 @@ namespace Slang
         }
     }
 
-    String emitGLSLForEntryPoint(
+    String emitHLSLForEntryPoint(
+        BackEndCompileRequest*  compileRequest,
+        EntryPoint*             entryPoint,
+        Int                     entryPointIndex,
+        TargetRequest*          targetReq,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        // The same HLSL is used for the `hlsl`, `dxbc`, and `dxil` targets
+        // (and their assembly forms), so we only generate it once.
+        //
+        auto program = compileRequest->getProgram();
+        auto sharedCodeKey = getSharedCodeKey(entryPointIndex, CodeGenTarget::HLSL, targetReq);
+        if(auto sharedCode = program->findSharedCode(sharedCodeKey))
+            return sharedCode->outputString;
+
+        String code = _emitHLSLForEntryPoint(compileRequest, entryPoint, entryPointIndex, targetReq, endToEndReq);
+        program->addSharedCode(sharedCodeKey, CompileResult(code));
+        return code;
+    }
+
+    static String _emitGLSLForEntryPoint(
         BackEndCompileRequest*  compileRequest,
         EntryPoint*             entryPoint,
         Int                     entryPointIndex,
@@ -503,6 +540,23 @@ namespace Slang
         }
     }
 
+    String emitGLSLForEntryPoint(
+        BackEndCompileRequest*  compileRequest,
+        EntryPoint*             entryPoint,
+        Int                     entryPointIndex,
+        TargetRequest*          targetReq,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        auto program = compileRequest->getProgram();
+        auto sharedCodeKey = getSharedCodeKey(entryPointIndex, CodeGenTarget::GLSL, targetReq);
+        if(auto sharedCode = program->findSharedCode(sharedCodeKey))
+            return sharedCode->outputString;
+
+        String code = _emitGLSLForEntryPoint(compileRequest, entryPoint, entryPointIndex, targetReq, endToEndReq);
+        program->addSharedCode(sharedCodeKey, CompileResult(code));
+        return code;
+    }
+
     String GetHLSLProfileName(Profile profile)
     {
         switch( profile.getFamily() )
@@ -677,6 +731,17 @@ namespace Slang
     {
         byteCodeOut.Clear();
 
+        // The `dxbc-asm` target disassembles the same bytecode that
+        // the `dxbc` target produces, so we only invoke fxc once.
+        //
+        auto program = compileRequest->getProgram();
+        auto sharedCodeKey = getSharedCodeKey(entryPointIndex, CodeGenTarget::DXBytecode, targetReq);
+        if(auto sharedCode = program->findSharedCode(sharedCodeKey))
+        {
+            byteCodeOut = sharedCode->outputBinary;
+            return SLANG_OK;
+        }
+
         auto session = compileRequest->getSession();
         auto sink = compileRequest->getSink();
 
@@ -770,6 +835,8 @@ namespace Slang
 
         const String sourcePath = calcSourcePathForEntryPoint(endToEndReq, entryPointIndex);
 
+        CompilePhaseScope phaseScope(compileRequest->compileStats, "downstream");
+
         ComPtr<ID3DBlob> codeBlob;
         ComPtr<ID3DBlob> diagnosticsBlob;
         HRESULT hr = compileFunc(
@@ -788,6 +855,7 @@ namespace Slang
         if (codeBlob && SLANG_SUCCEEDED(hr))
         {
             byteCodeOut.AddRange((uint8_t const*)codeBlob->GetBufferPointer(), (int)codeBlob->GetBufferSize());
+            program->addSharedCode(sharedCodeKey, CompileResult(byteCodeOut));
         }
 
         if (FAILED(hr))
@@ -879,6 +947,36 @@ SlangResult dissassembleDXILUsingDXC(
     size_t                  size, 
     String&                 stringOut);
 
+    static SlangResult emitDXILForEntryPoint(
+        BackEndCompileRequest*  compileRequest,
+        EntryPoint*             entryPoint,
+        Int                     entryPointIndex,
+        TargetRequest*          targetReq,
+        EndToEndCompileRequest* endToEndReq,
+        List<uint8_t>&          outCode)
+    {
+        // The `dxil-asm` target disassembles the same DXIL that
+        // the `dxil` target produces, so we only invoke dxc once.
+        //
+        auto program = compileRequest->getProgram();
+        auto sharedCodeKey = getSharedCodeKey(entryPointIndex, CodeGenTarget::DXIL, targetReq);
+        if(auto sharedCode = program->findSharedCode(sharedCodeKey))
+        {
+            outCode = sharedCode->outputBinary;
+            return SLANG_OK;
+        }
+
+        SLANG_RETURN_ON_FAIL(emitDXILForEntryPointUsingDXC(
+            compileRequest,
+            entryPoint,
+            entryPointIndex,
+            targetReq,
+            endToEndReq,
+            outCode));
+        program->addSharedCode(sharedCodeKey, CompileResult(outCode));
+        return SLANG_OK;
+    }
+
 #endif
 
 #if SLANG_ENABLE_GLSLANG_SUPPORT
@@ -905,6 +1003,7 @@ SlangResult dissassembleDXILUsingDXC(
         request.diagnosticFunc = diagnosticOutputFunc;
         request.diagnosticUserData = &diagnosticOutput;
 
+        CompilePhaseScope phaseScope(slangCompileRequest->compileStats, "downstream");
         int err = glslang_compile(&request);
 
         if (err)
@@ -957,6 +1056,17 @@ SlangResult dissassembleDXILUsingDXC(
     {
         spirvOut.Clear();
 
+        // The `spirv-asm` target disassembles the same SPIR-V that
+        // the `spirv` target produces, so we only invoke glslang once.
+        //
+        auto program = slangRequest->getProgram();
+        auto sharedCodeKey = getSharedCodeKey(entryPointIndex, CodeGenTarget::SPIRV, targetReq);
+        if(auto sharedCode = program->findSharedCode(sharedCodeKey))
+        {
+            spirvOut = sharedCode->outputBinary;
+            return SLANG_OK;
+        }
+
         String rawGLSL = emitGLSLForEntryPoint(
             slangRequest,
             entryPoint,
@@ -984,6 +1094,7 @@ SlangResult dissassembleDXILUsingDXC(
         request.outputUserData = &spirvOut;
 
         SLANG_RETURN_ON_FAIL(invokeGLSLCompiler(slangRequest, request));
+        program->addSharedCode(sharedCodeKey, CompileResult(spirvOut));
         return SLANG_OK;
     }
 
@@ -1091,7 +1202,7 @@ SlangResult dissassembleDXILUsingDXC(
         case CodeGenTarget::DXIL:
             {
                 List<uint8_t> code;
-                if (SLANG_SUCCEEDED(emitDXILForEntryPointUsingDXC(
+                if (SLANG_SUCCEEDED(emitDXILForEntryPoint(
                     compileRequest,
                     entryPoint,
                     entryPointIndex,
@@ -1108,7 +1219,7 @@ SlangResult dissassembleDXILUsingDXC(
         case CodeGenTarget::DXILAssembly:
             {
                 List<uint8_t> code;
-                if (SLANG_SUCCEEDED(emitDXILForEntryPointUsingDXC(
+                if (SLANG_SUCCEEDED(emitDXILForEntryPoint(
                     compileRequest,
                     entryPoint,
                     entryPointIndex,
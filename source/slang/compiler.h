@@ -6,7 +6,9 @@
 
 #include "../../slang-com-ptr.h"
 
+#include "compile-stats.h"
 #include "diagnostics.h"
+#include "ir-pass-manager.h"
 #include "name.h"
 #include "profile.h"
 #include "syntax.h"
@@ -17,10 +19,13 @@ namespace Slang
 {
     struct PathInfo;
     struct IncludeHandler;
+    struct IRSpecializationCache;
+    class IRSerialLazyModule;
     class ProgramLayout;
     class PtrType;
     class TargetProgram;
     class TargetRequest;
+    class ThreadPool;
     class TypeLayout;
 
     enum class CompilerMode
@@ -417,6 +422,12 @@ namespace Slang
             /// The the IR for the module (if it has been generated)
         IRModule* getIRModule() { return m_irModule; }
 
+            /// Get the serialized IR for the module, if its global values are read on demand.
+            ///
+            /// When this is set, the IR module only holds the global values that have been read so far.
+            ///
+        IRSerialLazyModule* getLazyIRModule() { return m_lazyIRModule; }
+
             /// Get the list of other modules this module depends on
         List<RefPtr<Module>> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
 
@@ -441,6 +452,12 @@ namespace Slang
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+            /// Set the IR for this module, to be read on demand from serialized IR.
+            ///
+            /// This should only be called once, during creation of the module.
+            ///
+        void setLazyIRModule(IRSerialLazyModule* lazyIRModule);
+
     private:
         // The parent linkage
         Linkage* m_linkage = nullptr;
@@ -451,6 +468,9 @@ namespace Slang
         // The IR for the module
         RefPtr<IRModule> m_irModule = nullptr;
 
+        // The serialized IR for the module, if it is read on demand
+        RefPtr<IRSerialLazyModule> m_lazyIRModule;
+
         // List of modules this module depends on
         ModuleDependencyList m_moduleDependencyList;
 
@@ -786,6 +806,18 @@ namespace Slang
         bool shouldDumpIR = false;
         bool shouldValidateIR = false;
 
+            /// Should statistics be recorded for each IR pass that is run?
+        bool shouldRecordIRPassStats = false;
+
+            /// Names of IR passes to dump the IR after (`all` matches every pass).
+        List<String> irPassNamesToDump;
+
+            /// Statistics for the IR passes run so far (if `shouldRecordIRPassStats` is set).
+        List<IRPassStats> irPassStats;
+
+            /// Where to record phase timings and counters, or null if they aren't being recorded.
+        CompileStats* compileStats = nullptr;
+
     protected:
         CompileRequestBase(
             Linkage*        linkage,
@@ -824,6 +856,10 @@ namespace Slang
         // If true will serialize and de-serialize with debug information
         bool verifyDebugSerialization = false;
 
+        // If true then the IR for each module is always compacted after it is
+        // generated (rather than only when enough of its memory is wasted)
+        bool shouldCompactIR = false;
+
         List<RefPtr<FrontEndEntryPointRequest>> m_entryPointReqs;
 
         List<RefPtr<FrontEndEntryPointRequest>> const& getEntryPointReqs() { return m_entryPointReqs; }
@@ -843,6 +879,13 @@ namespace Slang
         void parseTranslationUnit(
             TranslationUnitRequest* translationUnit);
 
+        // Parse all of the translation units in the program
+        void parseAllTranslationUnits();
+
+            /// Parse all of the translation units, preprocessing them in parallel
+            /// (see `parseAllTranslationUnits`)
+        void parseAllTranslationUnitsInParallel();
+
         // Perform primary semantic checking on all
         // of the translation units in the program
         void checkAllTranslationUnits();
@@ -934,7 +977,61 @@ namespace Slang
             ///
             /// The `target` must be a target on the `Linkage` that was used to create this program.
         TargetProgram* getTargetProgram(TargetRequest* target);
-            
+
+            /// Identifies code generated for an entry point that may be shared between targets.
+            ///
+            /// Several targets are compiled by way of the same intermediate code (e.g., the
+            /// `dxbc`, `dxbc-asm` and `dxil` targets all start from HLSL, and `spirv-asm` is
+            /// a disassembly of the `spirv` output). That code only depends on the entry
+            /// point, its format, and the options of the `TargetRequest` that the back end
+            /// reads, so that two targets with the same key can use the same code.
+            ///
+        struct SharedCodeKey
+        {
+            Int                 entryPointIndex = 0;
+            CodeGenTarget       format = CodeGenTarget::Unknown;
+            Profile             profile;
+            SlangTargetFlags    targetFlags = 0;
+            FloatingPointMode   floatingPointMode = FloatingPointMode::Default;
+
+                /// Is this GLSL code that is the final output of a `glsl` target?
+                ///
+                /// Raw GLSL output uses a different style of `#line` directive than
+                /// the GLSL that gets compiled to SPIR-V (see `emitLineDirective`).
+                ///
+            bool                isFinalGLSL = false;
+
+            bool operator==(SharedCodeKey const& other) const
+            {
+                return entryPointIndex == other.entryPointIndex
+                    && format == other.format
+                    && profile == other.profile
+                    && targetFlags == other.targetFlags
+                    && floatingPointMode == other.floatingPointMode
+                    && isFinalGLSL == other.isFinalGLSL;
+            }
+
+            int GetHashCode() const
+            {
+                int hash = Slang::GetHashCode(entryPointIndex);
+                hash = combineHash(hash, Slang::GetHashCode(int(format)));
+                hash = combineHash(hash, Slang::GetHashCode(profile.raw));
+                hash = combineHash(hash, Slang::GetHashCode(targetFlags));
+                hash = combineHash(hash, Slang::GetHashCode(int(floatingPointMode)));
+                hash = combineHash(hash, Slang::GetHashCode(isFinalGLSL));
+                return hash;
+            }
+        };
+
+            /// Find code for an entry point that was already generated for another target.
+            ///
+            /// Returns null if no code matching `key` has been generated yet.
+            ///
+        CompileResult* findSharedCode(SharedCodeKey const& key) { return m_sharedCode.TryGetValue(key); }
+
+            /// Record code generated for an entry point, so that other targets can reuse it.
+        void addSharedCode(SharedCodeKey const& key, CompileResult const& code) { m_sharedCode[key] = code; }
+
             /// Add a module (and everything it depends on) to the list of references
         void addReferencedModule(Module* module);
 
@@ -1038,6 +1135,9 @@ namespace Slang
         // Cache of target-specific programs for each target.
         Dictionary<TargetRequest*, RefPtr<TargetProgram>> m_targetPrograms;
 
+        // Code generated for entry points that can be shared between targets.
+        Dictionary<SharedCodeKey, CompileResult> m_sharedCode;
+
         // Any types looked up dynamically using `getTypeFromString`
         Dictionary<String, RefPtr<Type>> m_types;
     };
@@ -1095,6 +1195,19 @@ namespace Slang
             m_entryPointResults[entryPointIndex] = result;
         }
 
+            /// Get the cache of generic specializations that is shared
+            /// by the entry points compiled for this target.
+            ///
+            /// The cache is created the first time it is requested, for
+            /// code that is linked for `target` (the code generation target
+            /// of the entry points, which may differ from the target of the
+            /// request, e.g. GLSL for SPIR-V).
+            ///
+        IRSpecializationCache* getOrCreateSpecializationCache(CodeGenTarget target);
+
+            /// Get the cache of generic specializations, if one has been created.
+        IRSpecializationCache* getSpecializationCache() { return m_specializationCache; }
+
     private:
         // The program being compiled or laid out
         Program* m_program;
@@ -1109,6 +1222,10 @@ namespace Slang
         // in the parent `Program` (indexing matches
         // the order they are given in the `Program`)
         List<CompileResult> m_entryPointResults;
+
+        // Specialized generic functions and types that were created while
+        // generating code for earlier entry points on this target
+        RefPtr<IRSpecializationCache> m_specializationCache;
     };
 
         /// A request to generate code for a program
@@ -1175,6 +1292,12 @@ namespace Slang
 
         bool shouldSkipCodegen = false;
 
+            /// Should a report of IR pass statistics be written to the diagnostic output?
+        bool shouldReportIRPassStats = false;
+
+            /// If non-empty, a Chrome trace of the compile phases is written to this path.
+        String compileTracePath;
+
         // Are we being driven by the command-line `slangc`, and should act accordingly?
         bool isCommandLineCompile = false;
 
@@ -1220,6 +1343,24 @@ namespace Slang
         SlangResult executeActionsInner();
         SlangResult executeActions();
 
+            /// Enable or disable recording of IR pass statistics by both the front- and back-end.
+        void setRecordIRPassStats(bool enable);
+
+            /// Get statistics for all IR passes run so far, front-end passes first.
+        void getIRPassStats(List<IRPassStats>& outStats);
+
+            /// Get the number of IR passes that statistics have been recorded for.
+        UInt getIRPassStatCount();
+
+            /// Get the statistics for the IR pass at `index` (in the order used by `getIRPassStats`).
+        IRPassStats const& getIRPassStat(UInt index);
+
+            /// Enable or disable recording of phase timings and counters.
+        void setRecordCompileStats(bool enable);
+
+            /// Get the recorded phase timings and counters, or null if they aren't being recorded.
+        CompileStats* getCompileStats() { return m_compileStats; }
+
         Session* getSession() { return m_session; }
         DiagnosticSink* getSink() { return &m_sink; }
         NamePool* getNamePool() { return getLinkage()->getNamePool(); }
@@ -1237,6 +1378,7 @@ namespace Slang
         RefPtr<Program>                 m_unspecializedProgram;
         RefPtr<Program>                 m_specializedProgram;
         RefPtr<BackEndCompileRequest>   m_backEndReq;
+        RefPtr<CompileStats>            m_compileStats;
 
         // For output
         ComPtr<ISlangWriter> m_writers[SLANG_WRITER_CHANNEL_COUNT_OF];
@@ -1400,12 +1542,21 @@ namespace Slang
 
         Dictionary<Name*, SyntaxClass<RefObject> > mapNameToSyntaxClass;
 
+        // Set to a mutex that is held whilst a member dictionary is built, for as
+        // long as function bodies are checked in parallel (see `buildMemberDictionary`).
+        // Null otherwise, so that a serial check doesn't take a lock.
+        std::mutex* memberDictionaryMutex = nullptr;
+
         // cache used by type checking, implemented in check.cpp
         TypeCheckingCache* typeCheckingCache = nullptr;
         TypeCheckingCache* getTypeCheckingCache();
         void destroyTypeCheckingCache();
         //
 
+            /// Get the threads used to preprocess and check in parallel. The pool is created
+            /// the first time it is needed, and then shared by every compile in the session.
+        ThreadPool* getThreadPool();
+
             /// Will try to load the library by specified name (using the set loader), if not one already available.
         ISlangSharedLibrary* getOrLoadSharedLibrary(SharedLibraryType type, DiagnosticSink* sink);
 
@@ -1425,6 +1576,8 @@ namespace Slang
     private:
             /// Linkage used for all built-in (stdlib) code.
         RefPtr<Linkage> m_builtinLinkage;
+
+        ThreadPool* m_threadPool = nullptr;
     };
 
 }
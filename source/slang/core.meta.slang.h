@@ -1320,6 +1320,14 @@ SLANG_RAW("    /// This is equivalent to the LLVM `readnone` function attribute.
 SLANG_RAW("__attributeTarget(FunctionDeclBase)\n")
 SLANG_RAW("attribute_syntax [__readNone] : ReadNoneAttribute;\n")
 SLANG_RAW("\n")
+SLANG_RAW("    /// Indicates that calls to a function should always be inlined into the caller, regardless of its size.\n")
+SLANG_RAW("__attributeTarget(FunctionDeclBase)\n")
+SLANG_RAW("attribute_syntax [forceInline] : ForceInlineAttribute;\n")
+SLANG_RAW("\n")
+SLANG_RAW("    /// Indicates that calls to a function should never be inlined into the caller.\n")
+SLANG_RAW("__attributeTarget(FunctionDeclBase)\n")
+SLANG_RAW("attribute_syntax [noinline] : NoInlineAttribute;\n")
+SLANG_RAW("\n")
 SLANG_RAW("enum _AttributeTargets\n")
 SLANG_RAW("{\n")
 SLANG_RAW("    Struct = ")
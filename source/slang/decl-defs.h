@@ -25,7 +25,10 @@ ABSTRACT_SYNTAX_CLASS(ContainerDecl, Decl)
 
     // Whether the `memberDictionary` is valid.
     // Should be set to `false` if any members get added/remoed.
-    bool memberDictionaryIsValid = false;
+    //
+    // Atomic, as the dictionary may be built on demand by any of the
+    // threads that check function bodies in parallel (see `buildMemberDictionary`).
+    std::atomic<bool> memberDictionaryIsValid{false};
 
     // A list of transparent members, to be used in lookup
     // Note: this is only valid if `memberDictionaryIsValid` is true
@@ -219,6 +222,16 @@ END_SYNTAX_CLASS()
 // Base class for callable things that may also have a body that is evaluated to produce their result
 ABSTRACT_SYNTAX_CLASS(FunctionDeclBase, CallableDecl)
     SYNTAX_FIELD(RefPtr<Stmt>, Body)
+
+    // Set when semantic checking of the body has been deferred until
+    // the function is found to be reachable from an entry point.
+    // A function that is still deferred when checking is complete
+    // has an unchecked body, and must not be lowered to IR.
+    FIELD_INIT(bool, isBodyCheckDeferred, false)
+
+    // Set once the function has been referenced from checked code,
+    // so that checking of its body must not be deferred.
+    FIELD_INIT(bool, isReferenced, false)
 END_SYNTAX_CLASS()
 
 // A constructor/initializer to create instances of a type
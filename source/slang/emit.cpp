@@ -1,17 +1,24 @@
 // emit.cpp
 #include "emit.h"
 
+#include "../core/slang-chunked-string-builder.h"
+#include "../core/slang-float-to-string.h"
 #include "../core/slang-writer.h"
 #include "ir-bind-existentials.h"
 #include "ir-dce.h"
 #include "ir-entry-point-uniforms.h"
 #include "ir-glsl-legalize.h"
+#include "ir-gvn.h"
+#include "ir-inline.h"
 #include "ir-insts.h"
 #include "ir-link.h"
+#include "ir-pass-manager.h"
 #include "ir-restructure.h"
 #include "ir-restructure-scoping.h"
+#include "ir-sccp.h"
 #include "ir-specialize.h"
 #include "ir-specialize-resources.h"
+#include "ir-sroa.h"
 #include "ir-ssa.h"
 #include "ir-union.h"
 #include "ir-validate.h"
@@ -25,14 +32,6 @@
 
 #include <assert.h>
 
-// Note: using C++ stdio just to get a locale-independent
-// way to format floating-point values.
-//
-// TODO: Go ahead and implement teh Dragon4 algorithm so
-// that we can print floating-point values to arbitrary
-// precision as needed.
-#include <sstream>
-
 #ifdef _WIN32
 #include <d3dcompiler.h>
 #pragma warning(disable:4996)
@@ -96,8 +95,9 @@ struct SharedEmitContext
     // For example, `target` might be `GLSL`, while `finalTarget` might be `SPIRV`
     CodeGenTarget finalTarget;
 
-    // The string of code we've built so far
-    StringBuilder sb;
+    // The code we've built so far. It is held in chunks, so that emitting
+    // a large amount of code never needs to move what was already emitted.
+    ChunkedStringBuilder sb;
 
     // Current source position for tracking purposes...
     HumaneSourceLoc loc;
@@ -346,8 +346,7 @@ struct EmitVisitor
     void emitRawTextSpan(char const* textBegin, char const* textEnd)
     {
         // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
-        auto len = textEnd - textBegin;
-        context->shared->sb.Append(textBegin, len);
+        context->shared->sb.append(textBegin, textEnd);
     }
 
     void emitRawText(char const* text)
@@ -522,21 +521,20 @@ struct EmitVisitor
         //    "round-trip" and turn into the same value when parsed back in. This means
         //    that we need to print a reasonable number of digits of precision.
         //
-        // For right now, the easiest option that can balance these is to use
-        // the C++ standard library `iostream`s, because they support an explicit locale,
-        // and can (hopefully) print floating-point numbers accurately.
-        //
-        // Eventually, the right move here would be to implement proper floating-point
-        // number formatting ourselves, but that would require extensive testing to
-        // make sure we get it right.
+        // `FloatToStringUtil` handles all of these, printing the shortest decimal
+        // that round-trips (so `2.0` rather than `2.00000000000000000000`).
 
-        std::ostringstream stream;
-        stream.imbue(std::locale::classic());
-        stream.setf(std::ios::fixed,std::ios::floatfield);
-        stream.precision(20);
-        stream << value;
+        char buffer[FloatToStringUtil::kMaxChars];
+        const int length = FloatToStringUtil::toChars(value, buffer);
+        emit(UnownedStringSlice(buffer, buffer + length));
+    }
 
-        Emit(stream.str().c_str());
+    void Emit(float value)
+    {
+        // Only enough digits to round-trip as a `float` are needed
+        char buffer[FloatToStringUtil::kMaxChars];
+        const int length = FloatToStringUtil::toChars(value, buffer);
+        emit(UnownedStringSlice(buffer, buffer + length));
     }
 
 
@@ -2302,7 +2300,20 @@ struct EmitVisitor
             break;
 
         case kIROp_FloatLit:
-            Emit(((IRConstant*) inst)->value.floatVal);
+            {
+                // A `float` literal that holds a `float` value (for example after constant folding) is
+                // printed with the digits for a `float`, which can be a lot fewer than for a `double`.
+                IRFloatingPointValue value = ((IRConstant*) inst)->value.floatVal;
+                IRType* type = inst->getDataType();
+                if (type && type->op == kIROp_FloatType && double(float(value)) == value)
+                {
+                    Emit(float(value));
+                }
+                else
+                {
+                    Emit(value);
+                }
+            }
             break;
 
         case kIROp_BoolLit:
@@ -6742,12 +6753,16 @@ String emitEntryPoint(
         // modules, and also select between the definitions of
         // any "profile-overloaded" symbols.
         //
-        auto linkedIR = linkIR(
-            compileRequest,
-            entryPoint,
-            programLayout,
-            target,
-            targetRequest);
+        LinkedIR linkedIR;
+        {
+            CompilePhaseScope phaseScope(compileRequest->compileStats, "link");
+            linkedIR = linkIR(
+                compileRequest,
+                entryPoint,
+                programLayout,
+                target,
+                targetRequest);
+        }
         auto irModule = linkedIR.module;
         auto irEntryPoint = linkedIR.entryPoint;
 
@@ -6762,6 +6777,12 @@ String emitEntryPoint(
         // un-specialized IR.
         dumpIRIfEnabled(compileRequest, irModule);
 
+        // The remaining passes are run through a pass manager, so
+        // that they can be timed, and the IR dumped after any of
+        // them by name (see `-dump-ir-after` and `-time-passes`).
+        //
+        IRPassManager passManager(compileRequest, irModule);
+
         // When there are top-level existential-type parameters
         // to the shader, we need to take the side-band information
         // on how the existential "slots" were bound to concrete
@@ -6769,15 +6790,7 @@ String emitEntryPoint(
         // shader parameters for those slots, to be wired up to
         // use sites.
         //
-        bindExistentialSlots(irModule, sink);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS BOUND");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-
-
-
+        passManager.run("bindExistentialSlots", [&]() { bindExistentialSlots(irModule, sink); });
 
         // Now that we've linked the IR code, any layout/binding
         // information has been attached to shader parameters
@@ -6789,20 +6802,12 @@ String emitEntryPoint(
         // parameters of a shader entry point and move them into
         // the global scope instead.
         //
-        moveEntryPointUniformParamsToGlobalScope(irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "ENTRY POINT UNIFORMS MOVED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        passManager.run("moveEntryPointUniformParamsToGlobalScope", [&]() { moveEntryPointUniformParamsToGlobalScope(irModule); });
 
         // Desguar any union types, since these will be illegal on
         // various targets.
         //
-        desugarUnionTypes(irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "UNIONS DESUGARED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        passManager.run("desugarUnionTypes", [&]() { desugarUnionTypes(irModule); });
 
         // Next, we need to ensure that the code we emit for
         // the target doesn't contain any operations that would
@@ -6823,27 +6828,34 @@ String emitEntryPoint(
         // perform specialization of functions based on parameter
         // values that need to be compile-time constants.
         //
-        specializeModule(irModule);
-
-        // Debugging code for IR transformations...
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "SPECIALIZED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
+        // When the program has more than one entry point, the
+        // specializations created here are cached on the target
+        // program, so that linking the next entry point can copy
+        // them instead of specializing the same generics again.
+        //
+        IRSpecializationCache* specializationCache = nullptr;
+        if(program->getEntryPoints().Count() > 1)
+            specializationCache = targetProgram->getOrCreateSpecializationCache(target);
+        passManager.run("specializeModule", [&]() { specializeModule(irModule, specializationCache); });
+
+        // Once specialization has resolved calls to generic and
+        // interface methods into calls to concrete functions, we
+        // can inline the bodies of small functions (and those marked
+        // `[forceInline]`, but not those marked `[noinline]`) into
+        // their callers. Doing this before
+        // SSA construction means the inlined code gets cleaned up
+        // along with the rest of the function body.
+        //
+        passManager.run("inlineFunctionCalls", [&]() { inlineFunctionCalls(compileRequest, targetRequest, irModule); });
 
-        // Specialization can introduce dead code that could trip
+        // Specialization and inlining can introduce dead code that could trip
         // up downstream passes like type legalization, so we
         // will run a DCE pass to clean up after the specialization.
         //
         // TODO: Are there other cleanup optimizations we should
         // apply at this point?
         //
-        eliminateDeadCode(compileRequest, irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        passManager.run("eliminateDeadCode.afterSpecialization", [&]() { eliminateDeadCode(compileRequest, irModule); });
 
         // The Slang language allows interfaces to be used like
         // ordinary types (including placing them in constant
@@ -6870,14 +6882,7 @@ String emitEntryPoint(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
-        legalizeExistentialTypeLayout(
-            irModule,
-            sink);
-
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS LEGALIZED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        passManager.run("legalizeExistentialTypeLayout", [&]() { legalizeExistentialTypeLayout(irModule, sink); });
 
         // Many of our target languages and/or downstream compilers
         // don't support `struct` types that have resource-type fields.
@@ -6890,27 +6895,36 @@ String emitEntryPoint(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(
-            irModule,
-            sink);
-
-        //  Debugging output of legalization
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "LEGALIZED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        passManager.run("legalizeResourceTypes", [&]() { legalizeResourceTypes(irModule, sink); });
 
         // Once specialization and type legalization have been performed,
         // we should perform some of our basic optimization steps again,
         // to see if we can clean up any temporaries created by legalization.
         // (e.g., things that used to be aggregated might now be split up,
         // so that we can work with the individual fields).
-        constructSSA(irModule);
+        //
+        // Local variables of `struct` or small array type that are
+        // only accessed one field/element at a time are first split
+        // into a variable per field/element, so that SSA construction
+        // can promote them even when the aggregate is never written
+        // as a whole.
+        //
+        passManager.run("applyScalarReplacementOfAggregates", [&]() { applyScalarReplacementOfAggregates(irModule); });
+        passManager.run("constructSSA.afterLegalization", [&]() { constructSSA(irModule); });
 
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER SSA");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        // Inlining and specialization expose values that are constant
+        // at the call site (arguments that were literals, vectors built
+        // from constants, etc.), so we fold those (and any branches on
+        // them) before looking for redundant computations.
+        //
+        passManager.run("applySparseConditionalConstantPropagation.afterLegalization", [&]() { applySparseConditionalConstantPropagation(irModule); });
+
+        // Specialization, inlining and legalization all tend to produce
+        // the same swizzles, field extractions, and arithmetic more than
+        // once in a function. Now that local variables have been promoted
+        // to SSA values, we can find and remove those redundant computations.
+        //
+        passManager.run("applyGlobalValueNumbering", [&]() { applyGlobalValueNumbering(irModule); });
 
         // After type legalization and subsequent SSA cleanup we expect
         // that any resource types passed to functions are exposed
@@ -6929,12 +6943,7 @@ String emitEntryPoint(
         // for D3D targets that are not okay for Vulkan), we
         // pass down the target request along with the IR.
         //
-        specializeResourceParameters(compileRequest, targetRequest, irModule);
-
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER RESOURCE SPECIALIZATION");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        passManager.run("specializeResourceParameters", [&]() { specializeResourceParameters(compileRequest, targetRequest, irModule); });
 
         // For GLSL only, we will need to perform "legalization" of
         // the entry point and any entry-point parameters.
@@ -6947,17 +6956,15 @@ String emitEntryPoint(
         {
         case CodeGenTarget::GLSL:
         {
-            legalizeEntryPointForGLSL(
-                session,
-                irModule,
-                irEntryPoint,
-                compileRequest->getSink(),
-                &sharedContext.extensionUsageTracker);
-
-#if 0
-                dumpIRIfEnabled(compileRequest, irModule, "GLSL LEGALIZED");
-#endif
-                validateIRModuleIfEnabled(compileRequest, irModule);
+            passManager.run("legalizeEntryPointForGLSL", [&]()
+            {
+                legalizeEntryPointForGLSL(
+                    session,
+                    irModule,
+                    irEntryPoint,
+                    compileRequest->getSink(),
+                    &sharedContext.extensionUsageTracker);
+            });
         }
         break;
 
@@ -6975,11 +6982,7 @@ String emitEntryPoint(
         // dead-code-elimination (DCE) pass that only retains
         // whatever code is "live."
         //
-        eliminateDeadCode(compileRequest, irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
+        passManager.run("eliminateDeadCode.beforeEmit", [&]() { eliminateDeadCode(compileRequest, irModule); });
 
         // After all of the required optimization and legalization
         // passes have been performed, we can emit target code from
@@ -6987,6 +6990,7 @@ String emitEntryPoint(
         //
         // TODO: do we want to emit directly from IR, or translate the
         // IR back into AST for emission?
+        CompilePhaseScope phaseScope(compileRequest->compileStats, "emit");
         visitor.emitIRModule(&context, irModule);
     }
 
@@ -7011,8 +7015,10 @@ String emitEntryPoint(
         break;
     }
 
-    String code = sharedContext.sb.ProduceString();
-    sharedContext.sb.Clear();
+    // Set aside the code emitted so far, so that the directives that
+    // need to come before it can be emitted.
+    ChunkedStringBuilder code;
+    code.swapWith(sharedContext.sb);
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -7022,17 +7028,16 @@ String emitEntryPoint(
 
     visitor.emitLayoutDirectives(targetRequest);
 
-    String prefix = sharedContext.sb.ProduceString();
-
-
-    StringBuilder finalResultBuilder;
-    finalResultBuilder << prefix;
-
-    finalResultBuilder << sharedContext.extensionUsageTracker.glslExtensionRequireLines.ProduceString();
+    // The directives and extension lines are placed in front of the code
+    // without moving it, so the only copy of the code made is when the
+    // final string is produced.
+    code.prepend(sharedContext.extensionUsageTracker.glslExtensionRequireLines.ProduceString());
+    code.prepend(sharedContext.sb);
 
-    finalResultBuilder << code;
+    String finalResult = code.produceString();
 
-    String finalResult = finalResultBuilder.ProduceString();
+    if (auto compileStats = compileRequest->compileStats)
+        compileStats->addToCounter("bytesEmitted", finalResult.Length());
 
     return finalResult;
 }
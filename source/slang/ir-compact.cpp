@@ -0,0 +1,224 @@
+// ir-compact.cpp
+#include "ir-compact.h"
+
+#include "ir.h"
+#include "ir-insts.h"
+
+namespace Slang {
+
+// All the instructions in an `IRModule` are allocated from the memory
+// arena of the module, and an instruction that is removed from the
+// module (e.g., by dead code elimination) only runs its destructor;
+// its memory stays allocated until the whole module is destroyed.
+//
+// For a module that lives for a long time (such as the IR for a
+// module that other modules `import`) we can reclaim that memory by
+// copying the instructions that are still part of the module into
+// a fresh arena, and then releasing the old one.
+
+// Get the number of bytes that were allocated for `inst`.
+//
+// This needs to agree with the sizes used when instructions
+// and constants are created (see `ir.cpp`).
+//
+static size_t calcIRInstSize(IRInst* inst)
+{
+    const size_t constantPrefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+    switch( inst->op )
+    {
+    case kIROp_Module:
+        return sizeof(IRModuleInst);
+
+    case kIROp_BoolLit:
+    case kIROp_IntLit:
+        return constantPrefixSize + sizeof(IRIntegerValue);
+
+    case kIROp_FloatLit:
+        return constantPrefixSize + sizeof(IRFloatingPointValue);
+
+    case kIROp_PtrLit:
+        return constantPrefixSize + sizeof(void*);
+
+    case kIROp_StringLit:
+        if( inst->findDecorationImpl(kIROp_TransitoryDecoration) )
+        {
+            return constantPrefixSize + sizeof(IRConstant::StringSliceValue);
+        }
+        return constantPrefixSize
+            + SLANG_OFFSET_OF(IRConstant::StringValue, chars)
+            + static_cast<IRConstant*>(inst)->getStringSlice().size();
+
+    default:
+        return sizeof(IRInst) + inst->getOperandCount() * sizeof(IRUse);
+    }
+}
+
+static size_t calcAlignedIRInstSize(IRInst* inst)
+{
+    const size_t alignMask = MemoryArena::kMinAlignment - 1;
+    return (calcIRInstSize(inst) + alignMask) & ~alignMask;
+}
+
+    /// Collect `inst` and all of its decorations and children (recursively), in order.
+static void collectIRInsts(IRInst* inst, List<IRInst*>& outInsts)
+{
+    outInsts.Add(inst);
+    for( auto child : inst->getDecorationsAndChildren() )
+    {
+        collectIRInsts(child, outInsts);
+    }
+}
+
+size_t calcWastedIRModuleMemory(IRModule* module)
+{
+    List<IRInst*> insts;
+    collectIRInsts(module->getModuleInst(), insts);
+
+    size_t liveSize = 0;
+    for( auto inst : insts )
+    {
+        liveSize += calcAlignedIRInstSize(inst);
+    }
+
+    const size_t usedSize = module->memoryArena.calcTotalMemoryUsed();
+    return usedSize > liveSize ? usedSize - liveSize : 0;
+}
+
+bool compactIRModule(IRModule* module)
+{
+    List<IRInst*> oldInsts;
+    collectIRInsts(module->getModuleInst(), oldInsts);
+
+    // We start by making a copy of each instruction in the new arena.
+    // The copy shares the opcode, operand count, source location and
+    // any constant payload of the original, but none of its links to
+    // other instructions, which we will fill in once every instruction
+    // has a copy.
+    //
+    MemoryArena newArena(IRModule::kMemoryArenaBlockSize);
+    Dictionary<IRInst*, IRInst*> mapOldToNew;
+    for( auto oldInst : oldInsts )
+    {
+        const size_t size = calcIRInstSize(oldInst);
+        IRInst* newInst = (IRInst*) newArena.allocate(size);
+        memcpy((void*) newInst, oldInst, size);
+
+        newInst->firstUse = nullptr;
+        newInst->parent = nullptr;
+        newInst->next = nullptr;
+        newInst->prev = nullptr;
+        newInst->m_firstDecorationOrChild = nullptr;
+        newInst->decorationSummary = 0;
+        newInst->typeUse = IRUse();
+        for( UInt ii = 0; ii < newInst->getOperandCount(); ++ii )
+        {
+            newInst->getOperands()[ii] = IRUse();
+        }
+
+        mapOldToNew.Add(oldInst, newInst);
+    }
+
+    // An instruction that refers to a value that has been removed
+    // from the module (which would be a bug in whatever pass removed
+    // it) can't be copied, and we leave the module as it was.
+    //
+    for( auto oldInst : oldInsts )
+    {
+        auto oldType = oldInst->getFullType();
+        if( oldType && !mapOldToNew.ContainsKey(oldType) )
+            return false;
+
+        for( UInt ii = 0; ii < oldInst->getOperandCount(); ++ii )
+        {
+            auto oldOperand = oldInst->getOperand(ii);
+            if( oldOperand && !mapOldToNew.ContainsKey(oldOperand) )
+                return false;
+        }
+    }
+
+    // We re-create the uses of each value in the reverse order of its
+    // list of uses, since each new use is added at the start of the
+    // list. That way the passes that walk over the uses of a value see
+    // them in the same order as before compaction.
+    //
+    List<IRUse*> uses;
+    for( auto oldInst : oldInsts )
+    {
+        IRInst* newInst = mapOldToNew[oldInst];
+
+        uses.Clear();
+        for( auto use = oldInst->firstUse; use; use = use->nextUse )
+        {
+            uses.Add(use);
+        }
+
+        for( UInt ii = uses.Count(); ii > 0; --ii )
+        {
+            IRUse* oldUse = uses[ii - 1];
+            IRInst* oldUser = oldUse->getUser();
+
+            // Uses by instructions that were removed from the module
+            // are simply dropped.
+            //
+            IRInst* newUser = nullptr;
+            if( !mapOldToNew.TryGetValue(oldUser, newUser) )
+                continue;
+
+            IRUse* newUse = nullptr;
+            if( oldUse == &oldUser->typeUse )
+            {
+                newUse = &newUser->typeUse;
+            }
+            else
+            {
+                newUse = newUser->getOperands() + (oldUse - oldUser->getOperands());
+            }
+            newUse->init(newUser, newInst);
+        }
+    }
+
+    // Children are appended to their new parent in their
+    // original order, so that the module looks exactly the
+    // same as it did before.
+    //
+    for( auto oldInst : oldInsts )
+    {
+        IRInst* newInst = mapOldToNew[oldInst];
+        for( auto oldChild : oldInst->getDecorationsAndChildren() )
+        {
+            IRInst* newChild = mapOldToNew[oldChild];
+            newChild->insertAtEnd(newInst);
+        }
+    }
+
+    // Finally, the module takes ownership of the new arena, and the
+    // memory for the old instructions is released when `newArena`
+    // (which now holds the old arena) goes out of scope.
+    //
+    IRInst* newModuleInst = mapOldToNew[module->getModuleInst()];
+    module->moduleInst = cast<IRModuleInst>(newModuleInst);
+    module->memoryArena.swapWith(newArena);
+
+    return true;
+}
+
+bool compactIRModuleIfWasteful(IRModule* module, float maxWasteRatio)
+{
+    // We don't bother with modules that fit in a few blocks
+    // of the memory arena.
+    //
+    static const size_t kMinCompactSize = 4 * IRModule::kMemoryArenaBlockSize;
+
+    const size_t usedSize = module->memoryArena.calcTotalMemoryUsed();
+    if( usedSize < kMinCompactSize )
+        return false;
+
+    const size_t wastedSize = calcWastedIRModuleMemory(module);
+    if( wastedSize <= size_t(usedSize * maxWasteRatio) )
+        return false;
+
+    return compactIRModule(module);
+}
+
+}
@@ -0,0 +1,40 @@
+// ir-compact.h
+#pragma once
+
+#include <stddef.h>
+
+namespace Slang
+{
+struct IRModule;
+
+    /// Estimate how many bytes of the memory arena of `module` hold
+    /// instructions that are no longer part of the module.
+    ///
+    /// Passes that remove instructions (e.g., dead code elimination)
+    /// unlink them from the module, but the memory they were
+    /// allocated from is only reclaimed when the module is destroyed.
+    ///
+size_t calcWastedIRModuleMemory(IRModule* module);
+
+    /// Re-allocate all the instructions of `module` in a fresh memory
+    /// arena, so that the memory used by instructions that were removed
+    /// from the module is released.
+    ///
+    /// The module keeps its identity, but every instruction in it is
+    /// replaced by a copy, so no pointers to instructions (including any
+    /// caches held by a `SharedIRBuilder`) may be used after this call.
+    ///
+    /// Returns `false` (and leaves the module unchanged) if the module
+    /// refers to instructions that are not part of it.
+    ///
+bool compactIRModule(IRModule* module);
+
+    /// Compact `module` if more than `maxWasteRatio` of the memory
+    /// in its arena is wasted (see `calcWastedIRModuleMemory`).
+    ///
+    /// Small modules are never compacted, since the memory
+    /// reclaimed would not be worth the cost of copying.
+    ///
+bool compactIRModuleIfWasteful(IRModule* module, float maxWasteRatio = 0.25f);
+
+}
@@ -2,6 +2,7 @@
 #include "ir-dce.h"
 
 #include "ir.h"
+#include "ir-inst-map.h"
 #include "ir-insts.h"
 
 namespace Slang
@@ -26,9 +27,15 @@ struct DeadCodeEliminationContext
     //
     // We will track the liveness state by keeping
     // a set of all instructions we have so far determined
-    // to be live.
+    // to be live. The set is a bit set over a dense
+    // numbering of the instructions in the module.
     //
-    HashSet<IRInst*> liveInsts;
+    IRInstNumbering instNumbering;
+    IRInstSet liveInsts;
+
+    DeadCodeEliminationContext()
+        : liveInsts(&instNumbering)
+    {}
 
     // Querying whether an instruction has been
     // determined to be live is easy.
@@ -71,9 +78,8 @@ struct DeadCodeEliminationContext
         //
         if(!inst) return;
 
-        if(liveInsts.Contains(inst))
+        if(!liveInsts.Add(inst))
             return;
-        liveInsts.Add(inst);
         workList.Add(inst);
     }
 
@@ -83,6 +89,12 @@ struct DeadCodeEliminationContext
     //
     void processModule()
     {
+        // Numbering the whole module up front means the
+        // instructions get indices in the order we will
+        // later walk them to eliminate dead code.
+        //
+        instNumbering.addRec(module->getModuleInst());
+
         // First of all, we know that the root module instruction
         // should be considered as live, because otherwise
         // we'd end up eliminating it, so that is a
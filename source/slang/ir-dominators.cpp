@@ -181,6 +181,11 @@ bool IRDominatorTree::DominatedList::Iterator::operator==(Iterator const& that)
     return mIndex == that.mIndex;
 }
 
+bool IRDominatorTree::DominatedList::Iterator::operator!=(Iterator const& that) const
+{
+    return !(*this == that);
+}
+
 //
 // The dominance computation algorithm we are using relies on being able to compute
 // a reverse postorder traversal of the nodes in the CFG, which is done using a depth-first
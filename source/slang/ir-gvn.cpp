@@ -0,0 +1,272 @@
+// ir-gvn.cpp
+#include "ir-gvn.h"
+
+#include "ir.h"
+#include "ir-dominators.h"
+#include "ir-insts.h"
+
+namespace Slang {
+
+// This file implements a simple form of Global Value Numbering (GVN),
+// which is equivalent to common subexpression elimination (CSE) over
+// the dominator tree of each function.
+//
+// The `SharedIRBuilder` already deduplicates types and constants
+// when they are created, by looking up instructions with the same
+// opcode, type, and operands (see `IRInstKey`). We will use a similar
+// notion of equivalence for the instructions in function bodies, but
+// because a local instruction can only be used by code that it
+// dominates, we need to scope the set of "available" values
+// according to the dominator tree.
+//
+// An instruction is keyed on its opcode, its type, and the *leaders*
+// of its operands, where the leader of an instruction is the earliest
+// (dominating) instruction known to compute the same value. Keying on
+// leaders means that we can recognize `(a.x * b) + c` as redundant
+// even when we decided not to replace the redundant `a.x` itself.
+//
+struct GVNKey
+{
+    IROp            op;
+    List<IRInst*>   vals;
+
+    bool operator==(GVNKey const& other) const
+    {
+        if(op != other.op) return false;
+        auto valCount = vals.Count();
+        if(valCount != other.vals.Count()) return false;
+        for( UInt ii = 0; ii < valCount; ++ii )
+        {
+            if(vals[ii] != other.vals[ii]) return false;
+        }
+        return true;
+    }
+
+    int GetHashCode() const
+    {
+        int hash = Slang::GetHashCode(op);
+        for( auto val : vals )
+        {
+            hash = combineHash(hash, Slang::GetHashCode(val));
+        }
+        return hash;
+    }
+};
+
+struct GVNContext
+{
+    IRFunc*                     func;
+    RefPtr<IRDominatorTree>     dominatorTree;
+
+    // The values that are available at the current point of our walk
+    // over the dominator tree. This is a scoped table: the values added
+    // while processing a block are removed again once we are done with
+    // the sub-tree of blocks it dominates.
+    //
+    Dictionary<GVNKey, IRInst*> availableValues;
+    List<GVNKey>                availableValuesInScope;
+
+    // For each instruction that was found to be redundant but was
+    // kept anyway, the (dominating) instruction that computes the
+    // same value.
+    //
+    Dictionary<IRInst*, IRInst*> mapInstToLeader;
+
+    // An estimate of the size of the expression that the emitter
+    // will produce for each numbered value (see `shouldReplace`).
+    //
+    Dictionary<IRInst*, Int> mapInstToCost;
+
+    void apply()
+    {
+        dominatorTree = computeDominatorTree(func);
+
+        // Blocks that are not reachable from the entry block aren't
+        // part of the dominator tree, and will be left alone.
+        //
+        processBlock(func->getFirstBlock());
+    }
+
+    void processBlock(IRBlock* block)
+    {
+        UInt scopeStart = availableValuesInScope.Count();
+
+        IRInst* nextInst = nullptr;
+        for( IRInst* inst = block->getFirstInst(); inst; inst = nextInst )
+        {
+            nextInst = inst->getNextInst();
+            processInst(inst);
+        }
+
+        // Because we visit the blocks in a pre-order walk of the
+        // dominator tree, every instruction we've made available
+        // so far dominates the blocks we are about to visit.
+        //
+        for( auto childBlock : dominatorTree->getImmediatelyDominatedBlocks(block) )
+        {
+            processBlock(childBlock);
+        }
+
+        for( UInt ii = availableValuesInScope.Count(); ii > scopeStart; --ii )
+        {
+            availableValues.Remove(availableValuesInScope[ii - 1]);
+        }
+        availableValuesInScope.SetSize(scopeStart);
+    }
+
+    bool canBeNumbered(IRInst* inst)
+    {
+        // An instruction with side effects can't be replaced
+        // by an earlier one, even if it has the same operands.
+        //
+        if(inst->mightHaveSideEffects())
+            return false;
+
+        // Types are already deduplicated by the `SharedIRBuilder` where
+        // that is valid, while nominal types must stay distinct even
+        // if their operands match.
+        //
+        if(as<IRType>(inst))
+            return false;
+
+        switch( inst->op )
+        {
+        default:
+            return true;
+
+        // A `load` has no side effects of its own, but it is only
+        // equivalent to an earlier `load` from the same address if
+        // nothing has been stored in between.
+        //
+        // TODO: We could handle loads from addresses that are
+        // known to be immutable (e.g., constant buffers), or use
+        // a memory SSA form to find loads with no intervening stores.
+        //
+        case kIROp_Load:
+            return false;
+        }
+    }
+
+    IRInst* getLeader(IRInst* inst)
+    {
+        IRInst* leader = nullptr;
+        if(mapInstToLeader.TryGetValue(inst, leader))
+            return leader;
+        return inst;
+    }
+
+    Int getCost(IRInst* inst)
+    {
+        Int cost = 0;
+        mapInstToCost.TryGetValue(inst, cost);
+        return cost;
+    }
+
+    // Replacing an instruction with its leader is always valid, but it
+    // isn't always an improvement in the code we output.
+    //
+    // The emitter folds a side-effect-free instruction with a single use
+    // into the expression at its use site, so two copies of `a.x` are
+    // emitted as two (cheap) expressions, while a single `a.x` with two
+    // uses needs a temporary to be declared. We will thus only replace
+    // an instruction if its leader already needs a temporary (because it
+    // has other uses), or if the expression it stands for is big enough
+    // that computing it twice costs more than a temporary.
+    //
+    static const Int kMinReplaceCost = 3;
+
+    bool shouldReplace(IRInst* leader)
+    {
+        if(leader->hasMoreThanOneUse())
+            return true;
+
+        switch( leader->op )
+        {
+        default:
+            break;
+
+        // These are never folded into their use sites by the emitter.
+        case kIROp_makeStruct:
+        case kIROp_makeArray:
+            return true;
+        }
+
+        return getCost(leader) >= kMinReplaceCost;
+    }
+
+    void processInst(IRInst* inst)
+    {
+        if(!canBeNumbered(inst))
+            return;
+
+        GVNKey key;
+        key.op = inst->op;
+        key.vals.Add(inst->getFullType());
+
+        Int cost = 1;
+        UInt operandCount = inst->getOperandCount();
+        for( UInt ii = 0; ii < operandCount; ++ii )
+        {
+            auto operand = inst->getOperand(ii);
+            key.vals.Add(getLeader(operand));
+            cost += getCost(operand);
+        }
+
+        IRInst* leader = nullptr;
+        if( availableValues.TryGetValue(key, leader) )
+        {
+            if( shouldReplace(leader) )
+            {
+                inst->replaceUsesWith(leader);
+                inst->removeAndDeallocate();
+            }
+            else
+            {
+                mapInstToLeader.Add(inst, leader);
+                mapInstToCost.Add(inst, cost);
+            }
+            return;
+        }
+
+        availableValues.Add(key, inst);
+        availableValuesInScope.Add(key);
+        mapInstToCost.Add(inst, cost);
+    }
+};
+
+static void applyGlobalValueNumberingRec(
+    IRInst* inst)
+{
+    // We only apply the optimization to the bodies of functions.
+    // The body of a generic computes types and witness tables
+    // that have an identity of their own, so that two values
+    // with the same operands might still be distinct.
+    //
+    if( auto func = as<IRFunc>(inst) )
+    {
+        if( func->getFirstBlock() )
+        {
+            GVNContext context;
+            context.func = func;
+            context.apply();
+        }
+
+        // Functions can't be nested inside of other functions,
+        // so there is no need to look at the children.
+        //
+        return;
+    }
+
+    for( auto childInst : inst->getDecorationsAndChildren() )
+    {
+        applyGlobalValueNumberingRec(childInst);
+    }
+}
+
+void applyGlobalValueNumbering(
+    IRModule*   module)
+{
+    applyGlobalValueNumberingRec(module->getModuleInst());
+}
+
+}
@@ -0,0 +1,17 @@
+// ir-gvn.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Apply Global Value Numbering (GVN) to the functions in a module.
+        ///
+        /// This optimization finds instructions that compute the same value as
+        /// an instruction that dominates them (same opcode, type and operands,
+        /// with no side effects), and replaces them with the earlier instruction.
+        /// This is also known as (dominator-based) common subexpression elimination.
+        ///
+    void applyGlobalValueNumbering(
+        IRModule*   module);
+}
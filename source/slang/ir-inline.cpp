@@ -0,0 +1,554 @@
+// ir-inline.cpp
+#include "ir-inline.h"
+
+#include "ir.h"
+#include "ir-clone.h"
+#include "ir-insts.h"
+
+namespace Slang
+{
+
+struct InliningContext
+{
+    // This type implements a pass that inlines the bodies
+    // of called functions at their call sites.
+    //
+    // Inlining is useful for us mostly because of what it
+    // enables downstream: once the body of a small helper
+    // function has been spliced into its caller, the SSA
+    // construction and constant folding passes that run
+    // later can see through what used to be a call, and
+    // the downstream compiler is handed code with fewer
+    // calls to reason about.
+    //
+    // We start with member variables to stand in for
+    // the parameters that were passed to the top-level
+    // `inlineFunctionCalls` function.
+    //
+    BackEndCompileRequest*  compileRequest;
+    IRModule*               module;
+
+    // The decision about whether to inline a call site
+    // is driven by a simple cost model: the cost of a callee
+    // is the number of instructions in its body, and callees
+    // at or below a threshold cost will be inlined.
+    //
+    // Functions marked `[forceInline]` bypass the cost
+    // model and are always inlined (if they can be), while
+    // functions marked `[noinline]` are never inlined. The
+    // cost model can also be turned off for a whole target
+    // (see `SLANG_TARGET_FLAG_NO_INLINING`), leaving only the
+    // `[forceInline]` functions to be inlined.
+    //
+    // TODO: A more complete cost model would account for
+    // the number of call sites of a function (a function
+    // with a single call site can always be inlined without
+    // growing the program), and for the arguments at a
+    // call site (e.g., a constant argument can enable
+    // folding in the inlined body).
+    //
+    static const Int kCostThreshold = 10;
+    bool useCostModel = true;
+
+    // So that the decisions don't depend on the order in which
+    // call sites are visited, functions are processed bottom-up
+    // over the call graph: all of the functions that a function
+    // calls are processed (and so have had their own calls
+    // inlined) before it is. The body of a callee, and so its
+    // cost, is final by the time any of its call sites is
+    // considered.
+    //
+    // A call that gets exposed by inlining (one that was in
+    // the body of the callee) has already been considered when
+    // the callee was processed, so it isn't considered again.
+    //
+    // Recursion isn't allowed in shader code, but we don't
+    // want a bad input to send the pass into an infinite loop.
+    // A call to a function that is still being processed (i.e.,
+    // a call around a cycle in the call graph) is never inlined.
+    //
+    enum class FuncState
+    {
+        InProgress,
+        Done,
+    };
+    Dictionary<IRFunc*, FuncState>  funcStates;
+
+    // The cost of each function that has been processed.
+    Dictionary<IRFunc*, Int>        funcCosts;
+
+    SharedIRBuilder sharedBuilderStorage;
+    IRBuilder       builderStorage;
+    IRBuilder* getBuilder() { return &builderStorage; }
+
+    void processModule()
+    {
+        sharedBuilderStorage.module = module;
+        sharedBuilderStorage.session = module->getSession();
+        builderStorage.sharedBuilder = &sharedBuilderStorage;
+
+        // We process every function in the module, including
+        // those nested inside of generics.
+        //
+        List<IRFunc*> funcs;
+        collectFuncsRec(module->getModuleInst(), funcs);
+
+        for( auto func : funcs )
+        {
+            processFunc(func);
+        }
+    }
+
+    static void collectFuncsRec(IRInst* inst, List<IRFunc*>& outFuncs)
+    {
+        if( auto func = as<IRFunc>(inst) )
+        {
+            outFuncs.Add(func);
+            return;
+        }
+
+        for( auto child : inst->getChildren() )
+        {
+            collectFuncsRec(child, outFuncs);
+        }
+    }
+
+        /// Get the function that `call` calls, if its definition is visible.
+    static IRFunc* getCalleeDefinition(IRCall* call)
+    {
+        auto callee = as<IRFunc>(call->getCallee());
+        if(!callee || !callee->getFirstBlock())
+            return nullptr;
+        return callee;
+    }
+
+    void processFunc(IRFunc* func)
+    {
+        if(funcStates.ContainsKey(func))
+            return;
+        funcStates[func] = FuncState::InProgress;
+
+        // We collect the call sites up front, since inlining
+        // a call splits the block that it was in.
+        //
+        List<IRCall*> calls;
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                if( auto call = as<IRCall>(inst) )
+                    calls.Add(call);
+            }
+        }
+
+        for( auto call : calls )
+        {
+            if( auto callee = getCalleeDefinition(call) )
+                processFunc(callee);
+        }
+
+        for( auto call : calls )
+        {
+            maybeInlineCall(call);
+        }
+
+        funcStates[func] = FuncState::Done;
+        funcCosts[func] = calcCost(func);
+    }
+
+    void maybeInlineCall(IRCall* call)
+    {
+        // We can only inline a call if we can see the
+        // definition of the function being called, and
+        // that function has been processed.
+        //
+        auto callee = getCalleeDefinition(call);
+        if(!callee)
+            return;
+
+        FuncState calleeState = FuncState::InProgress;
+        funcStates.TryGetValue(callee, calleeState);
+        if(calleeState != FuncState::Done)
+            return;
+
+        // The call site needs to be an ordinary instruction
+        // in the body of a function.
+        //
+        auto callBlock = as<IRBlock>(call->getParent());
+        if(!callBlock)
+            return;
+        auto caller = as<IRFunc>(callBlock->getParent());
+        if(!caller)
+            return;
+
+        if(caller == callee)
+            return;
+
+        if(!shouldInline(callee))
+            return;
+
+        // Even when the cost model says a call should be
+        // inlined, we can only do so when the control
+        // flow of the callee can be spliced into the caller
+        // without breaking the structured control flow
+        // that the back end relies on.
+        //
+        auto returnInst = findInlinableReturn(callee);
+        if(!returnInst)
+            return;
+
+        // A call whose result is used needs a value
+        // to replace it with.
+        //
+        if(call->hasUses() && returnInst->op != kIROp_ReturnVal)
+            return;
+
+        // The front end sometimes passes a loaded value (rather than
+        // an address) for an `out`/`inout` parameter, e.g., for the
+        // implicit `this` parameter of a `[mutating]` method. The
+        // emitted code happens to work out for an actual call, as
+        // long as the loaded value is a variable (or parameter) of
+        // the caller, so we leave such calls alone, and also avoid
+        // inlining a callee that makes such a call using its own
+        // parameters.
+        //
+        if(passesValueByReference(call))
+            return;
+        if(containsCallPassingValueByReference(callee))
+            return;
+
+        inlineCall(call, callee, returnInst);
+    }
+
+    static bool passesValueByReference(IRCall* call)
+    {
+        auto funcType = as<IRFuncType>(call->getCallee()->getDataType());
+        if(!funcType)
+            return false;
+
+        UInt argCount = call->getArgCount();
+        for( UInt ii = 0; ii < argCount && ii < funcType->getParamCount(); ++ii )
+        {
+            if( as<IRPtrTypeBase>(funcType->getParamType(ii))
+                && !as<IRPtrTypeBase>(call->getArg(ii)->getDataType()) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool containsCallPassingValueByReference(IRFunc* func)
+    {
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                auto call = as<IRCall>(inst);
+                if(call && passesValueByReference(call))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool shouldInline(IRFunc* callee)
+    {
+        // A function with target-specific definitions (e.g.,
+        // an intrinsic that maps to a builtin on some targets)
+        // needs to remain a function so that the emit logic
+        // can pick the right definition.
+        //
+        if(callee->findDecoration<IRTargetSpecificDecoration>())
+            return false;
+
+        // We leave calls to entry points alone, so that
+        // any layout information attached to their parameters
+        // stays meaningful.
+        //
+        if(callee->findDecorationImpl(kIROp_EntryPointDecoration))
+            return false;
+
+        if(callee->findDecoration<IRNoInlineDecoration>())
+            return false;
+
+        if(callee->findDecoration<IRForceInlineDecoration>())
+            return true;
+
+        if(!useCostModel)
+            return false;
+
+        Int cost = 0;
+        funcCosts.TryGetValue(callee, cost);
+        return cost <= kCostThreshold;
+    }
+
+    static Int calcCost(IRFunc* func)
+    {
+        Int cost = 0;
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                if(as<IRParam>(inst))
+                    continue;
+                cost++;
+            }
+        }
+        return cost;
+    }
+
+    static bool isReturn(IRInst* inst)
+    {
+        return inst && (inst->op == kIROp_ReturnVal || inst->op == kIROp_ReturnVoid);
+    }
+
+    // The structured control flow that our back end emits
+    // is recovered from the `ifElse`, `loop` and `switch`
+    // instructions in the IR, each of which names a
+    // block where control flow re-converges.
+    //
+    // When we inline a call, every `return` in the callee
+    // turns into a branch to the code that followed the
+    // call. If a `return` is nested inside of an `if` or
+    // a loop in the callee, that branch would jump out
+    // of a structured region, which we can't express.
+    //
+    // We will therefore only inline a callee with a single
+    // `return` instruction, that appears in the sequence
+    // of blocks formed by following the re-convergence
+    // points from the entry block. In that case the inlined
+    // body is just a straight-line sequence of (structured)
+    // regions, which can sit anywhere a call could.
+    //
+    // TODO: Supporting callees with multiple `return`s would
+    // require either multi-level `break` support in the
+    // back end, or rewriting the callee body into a
+    // single-exit form (e.g., wrapping it in a loop that
+    // runs once, and turning each `return` into a `break`).
+    //
+    IRTerminatorInst* findInlinableReturn(IRFunc* callee)
+    {
+        // First we will make sure there is exactly
+        // one `return` in the function.
+        //
+        IRTerminatorInst* returnInst = nullptr;
+        UInt blockCount = 0;
+        for( auto block : callee->getBlocks() )
+        {
+            blockCount++;
+
+            auto terminator = block->getTerminator();
+            if(!isReturn(terminator))
+                continue;
+
+            if(returnInst)
+                return nullptr;
+            returnInst = terminator;
+        }
+        if(!returnInst)
+            return nullptr;
+
+        // Next we walk the sequence of blocks starting at
+        // the entry block, skipping over structured regions,
+        // and check that we arrive at the `return`.
+        //
+        IRBlock* block = callee->getFirstBlock();
+        for( UInt ii = 0; ii < blockCount && block; ++ii )
+        {
+            auto terminator = block->getTerminator();
+            if(!terminator)
+                return nullptr;
+
+            switch( terminator->op )
+            {
+            case kIROp_ReturnVal:
+            case kIROp_ReturnVoid:
+                return terminator;
+
+            case kIROp_unconditionalBranch:
+                block = ((IRUnconditionalBranch*) terminator)->getTargetBlock();
+                break;
+
+            case kIROp_loop:
+                block = ((IRLoop*) terminator)->getBreakBlock();
+                break;
+
+            case kIROp_ifElse:
+                block = ((IRIfElse*) terminator)->getAfterBlock();
+                break;
+
+            case kIROp_Switch:
+                block = ((IRSwitch*) terminator)->getBreakLabel();
+                break;
+
+            default:
+                return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    struct ClonedInst
+    {
+        IRInst* oldInst;
+        IRInst* newInst;
+    };
+
+    void inlineCall(
+        IRCall*             call,
+        IRFunc*             callee,
+        IRTerminatorInst*   returnInst)
+    {
+        auto callBlock = cast<IRBlock>(call->getParent());
+
+        auto builder = getBuilder();
+
+        // We start by splitting the block that contains the
+        // call, so that everything after the call moves to
+        // a new block.
+        //
+        // The original block keeps its identity (and any
+        // parameters), so that branches to it from elsewhere
+        // in the caller are unaffected.
+        //
+        auto afterBlock = builder->createBlock();
+        afterBlock->insertAfter(callBlock);
+        while( auto inst = call->getNextInst() )
+        {
+            inst->insertAtEnd(afterBlock);
+        }
+
+        // The parameters of the callee will be replaced with
+        // the arguments at the call site.
+        //
+        IRCloneEnv env;
+        UInt argIndex = 0;
+        for( auto param : callee->getParams() )
+        {
+            env.mapOldValToNew.Add(param, call->getArg(argIndex++));
+        }
+
+        // Each block of the callee gets a new block in the caller,
+        // placed between the two halves of the split block.
+        //
+        // We create all of the blocks up front, so that branches
+        // can refer to blocks that haven't been filled in yet.
+        //
+        IRInst* prevBlock = callBlock;
+        for( auto oldBlock : callee->getBlocks() )
+        {
+            auto newBlock = builder->createBlock();
+            newBlock->insertAfter(prevBlock);
+            prevBlock = newBlock;
+
+            env.mapOldValToNew.Add(oldBlock, newBlock);
+        }
+
+        // Now we can clone the instructions in each block.
+        //
+        // The order of blocks in a function doesn't need to
+        // follow the dominator tree, so an instruction might
+        // be cloned before one of its operands. We keep a list
+        // of everything we cloned and fix up operands once
+        // all of the clones exist.
+        //
+        List<ClonedInst> clonedInsts;
+        for( auto oldBlock : callee->getBlocks() )
+        {
+            auto newBlock = cast<IRBlock>(lookUp(&env, oldBlock));
+            builder->setInsertInto(newBlock);
+
+            for( auto oldInst : oldBlock->getChildren() )
+            {
+                // The parameters of the entry block were mapped
+                // to the arguments already.
+                //
+                if(lookUp(&env, oldInst))
+                    continue;
+
+                // The `return` turns into a branch to the code
+                // that followed the call.
+                //
+                if( oldInst == returnInst )
+                {
+                    auto branch = builder->emitBranch(afterBlock);
+                    branch->sourceLoc = returnInst->sourceLoc;
+                    continue;
+                }
+
+                auto newInst = cloneInstAndOperands(&env, builder, oldInst);
+
+                // The inlined code should still report the location
+                // of the code it came from, rather than the call site.
+                //
+                newInst->sourceLoc = oldInst->sourceLoc;
+
+                env.mapOldValToNew.Add(oldInst, newInst);
+
+                ClonedInst clonedInst;
+                clonedInst.oldInst = oldInst;
+                clonedInst.newInst = newInst;
+                clonedInsts.Add(clonedInst);
+            }
+        }
+
+        for( auto clonedInst : clonedInsts )
+        {
+            auto oldInst = clonedInst.oldInst;
+            auto newInst = clonedInst.newInst;
+
+            UInt operandCount = oldInst->getOperandCount();
+            for( UInt ii = 0; ii < operandCount; ++ii )
+            {
+                auto newOperand = findCloneForOperand(&env, oldInst->getOperand(ii));
+                if(newInst->getOperand(ii) != newOperand)
+                    newInst->setOperand(ii, newOperand);
+            }
+
+            // Any decorations on the instructions in the callee
+            // (e.g., name hints on local variables, or loop control
+            // attributes) carry over to the inlined copies.
+            //
+            if( oldInst->getFirstDecorationOrChild() )
+            {
+                cloneInstDecorationsAndChildren(&env, &sharedBuilderStorage, oldInst, newInst);
+            }
+        }
+
+        // Control flow now passes from the first half of the
+        // split block into the inlined body.
+        //
+        builder->setInsertInto(callBlock);
+        builder->emitBranch(cast<IRBlock>(lookUp(&env, callee->getFirstBlock())));
+
+        // Finally, the result of the call is whatever value the
+        // inlined body returned, and the call itself goes away.
+        //
+        // Because the `return` is the only way out of the inlined
+        // body, its operand dominates everything that used to
+        // come after the call.
+        //
+        if( returnInst->op == kIROp_ReturnVal )
+        {
+            auto returnVal = (IRReturnVal*) returnInst;
+            call->replaceUsesWith(findCloneForOperand(&env, returnVal->getVal()));
+        }
+        call->removeAndDeallocate();
+    }
+};
+
+void inlineFunctionCalls(
+    BackEndCompileRequest*  compileRequest,
+    TargetRequest*          targetRequest,
+    IRModule*               module)
+{
+    InliningContext context;
+    context.compileRequest = compileRequest;
+    context.module = module;
+    context.useCostModel = (targetRequest->targetFlags & SLANG_TARGET_FLAG_NO_INLINING) == 0;
+
+    context.processModule();
+}
+
+} // namespace Slang
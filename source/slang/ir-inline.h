@@ -0,0 +1,27 @@
+// ir-inline.h
+#pragma once
+
+namespace Slang
+{
+    class BackEndCompileRequest;
+    class TargetRequest;
+    struct IRModule;
+
+        /// Inline calls to small functions, and to functions marked `[forceInline]`.
+        ///
+        /// A call site is inlined by splitting the calling block at the
+        /// call, and splicing a copy of the body of the callee in between
+        /// the two halves, with the parameters of the callee replaced by
+        /// the arguments at the call site.
+        ///
+        /// Calls to functions marked `[forceInline]` are always inlined
+        /// when possible, and calls to functions marked `[noinline]` never
+        /// are. Other calls are only inlined when the callee is cheap enough
+        /// according to a simple cost model, unless the target has the
+        /// `SLANG_TARGET_FLAG_NO_INLINING` flag.
+        ///
+    void inlineFunctionCalls(
+        BackEndCompileRequest*  compileRequest,
+        TargetRequest*          targetRequest,
+        IRModule*               module);
+}
@@ -400,6 +400,13 @@ INST(HighLevelDeclDecoration,               highLevelDecl,          1, 0)
     INST(VulkanCallablePayloadDecoration,   vulkanCallablePayload,  0, 0)
     INST(EarlyDepthStencilDecoration,       earlyDepthStencil,      0, 0)
     INST(GloballyCoherentDecoration,        globallyCoherent,       0, 0)
+
+        /// A `[forceInline]` decoration marks a function whose call sites should always be inlined.
+    INST(ForceInlineDecoration,             forceInline,            0, 0)
+
+        /// A `[noinline]` decoration marks a function whose call sites should never be inlined.
+    INST(NoInlineDecoration,                noInline,               0, 0)
+
     INST(PatchConstantFuncDecoration,       patchConstantFunc,      1, 0)
 
         /// An `[entryPoint]` decoration marks a function that represents a shader entry point.
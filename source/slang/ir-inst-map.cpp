@@ -0,0 +1,50 @@
+// ir-inst-map.cpp
+#include "ir-inst-map.h"
+
+#include "ir.h"
+
+namespace Slang {
+
+UInt IRInstNumbering::getIndex(IRInst* inst)
+{
+    UInt index = inst->scratchIndex;
+    if (index < m_insts.Count() && m_insts[index] == inst)
+        return index;
+
+    index = m_insts.Count();
+    inst->scratchIndex = uint32_t(index);
+    m_insts.Add(inst);
+    return index;
+}
+
+Int IRInstNumbering::findIndex(IRInst* inst) const
+{
+    UInt index = inst->scratchIndex;
+    if (index < m_insts.Count() && m_insts[index] == inst)
+        return Int(index);
+    return -1;
+}
+
+void IRInstNumbering::addRec(IRInst* inst)
+{
+    // We use an explicit stack rather than recursion, since
+    // this may be applied to an entire module.
+    //
+    List<IRInst*> stack;
+    stack.Add(inst);
+    while (stack.Count() != 0)
+    {
+        IRInst* current = stack.Last();
+        stack.RemoveLast();
+
+        getIndex(current);
+
+        // Push children in reverse, so that they are
+        // numbered in their original order.
+        //
+        for (auto child = current->getLastDecorationOrChild(); child; child = child->getPrevInst())
+            stack.Add(child);
+    }
+}
+
+}
@@ -0,0 +1,194 @@
+// ir-inst-map.h
+#pragma once
+
+#include "../core/basic.h"
+
+namespace Slang
+{
+    struct IRInst;
+
+        /// Assigns dense indices to IR instructions, on demand.
+        ///
+        /// Passes that need per-instruction state can use the
+        /// dense indices to store that state in flat arrays
+        /// (`IRInstMap`) or bit sets (`IRInstSet`), rather than
+        /// in hash containers keyed by instruction pointer.
+        ///
+        /// The index for an instruction is cached in the instruction
+        /// itself (`IRInst::scratchIndex`), and is validated against
+        /// the list of numbered instructions whenever it is read, so
+        /// that an index left behind by an earlier numbering is never
+        /// mistaken for a valid one. Because the cached index is shared,
+        /// only one numbering should be in use for a given instruction
+        /// at a time; passes that run one after another can each use
+        /// their own numbering.
+        ///
+    struct IRInstNumbering
+    {
+            /// Get the index of `inst`, assigning a fresh one if it doesn't have one yet.
+        UInt getIndex(IRInst* inst);
+
+            /// Find the index of `inst`, or return -1 if it hasn't been assigned one.
+        Int findIndex(IRInst* inst) const;
+
+            /// Assign indices to `inst` and all of its descendents (in order), if they don't have one.
+            ///
+            /// Numbering the instructions a pass will visit up front
+            /// is optional, but gives related instructions nearby indices.
+            ///
+        void addRec(IRInst* inst);
+
+            /// Get the number of instructions that have been assigned an index.
+        UInt getCount() const { return m_insts.Count(); }
+
+            /// Get the instruction with the given `index`.
+        IRInst* getInst(UInt index) const { return m_insts[index]; }
+
+    protected:
+        List<IRInst*> m_insts;
+    };
+
+        /// A set of IR instructions, stored as a bit set over an `IRInstNumbering`.
+    struct IRInstSet
+    {
+        IRInstSet(IRInstNumbering* numbering)
+            : m_numbering(numbering)
+        {}
+
+            /// Add `inst` to the set. Returns true if it wasn't already present.
+        bool Add(IRInst* inst)
+        {
+            UInt index = m_numbering->getIndex(inst);
+            _ensureCapacity(index);
+
+            uint32_t& word = m_bits[index >> 5];
+            uint32_t mask = uint32_t(1) << (index & 31);
+            if (word & mask)
+                return false;
+            word |= mask;
+            return true;
+        }
+
+            /// Is `inst` in the set?
+        bool Contains(IRInst* inst) const
+        {
+            Int index = m_numbering->findIndex(inst);
+            if (index < 0 || UInt(index >> 5) >= m_bits.Count())
+                return false;
+            return (m_bits[index >> 5] & (uint32_t(1) << (index & 31))) != 0;
+        }
+
+            /// Remove `inst` from the set, if present.
+        void Remove(IRInst* inst)
+        {
+            Int index = m_numbering->findIndex(inst);
+            if (index < 0 || UInt(index >> 5) >= m_bits.Count())
+                return;
+            m_bits[index >> 5] &= ~(uint32_t(1) << (index & 31));
+        }
+
+        IRInstNumbering* getNumbering() const { return m_numbering; }
+
+    protected:
+        void _ensureCapacity(UInt index)
+        {
+            UInt wordCount = (index >> 5) + 1;
+            UInt oldCount = m_bits.Count();
+            if (wordCount <= oldCount)
+                return;
+
+            // Size to cover every instruction numbered so far, so that
+            // adding instructions in index order doesn't grow one word at a time.
+            UInt numberedWordCount = (m_numbering->getCount() + 31) >> 5;
+            if (numberedWordCount > wordCount)
+                wordCount = numberedWordCount;
+
+            m_bits.GrowToSize(wordCount);
+            for (UInt ii = oldCount; ii < wordCount; ++ii)
+                m_bits[ii] = 0;
+        }
+
+        IRInstNumbering*    m_numbering;
+        List<uint32_t>      m_bits;
+    };
+
+        /// A map from IR instructions to values of type `T`, stored as a flat array over an `IRInstNumbering`.
+    template<typename T>
+    struct IRInstMap
+    {
+        IRInstMap(IRInstNumbering* numbering)
+            : m_numbering(numbering)
+            , m_present(numbering)
+        {}
+
+            /// Get the value for `inst`, inserting a default-constructed value if it isn't present.
+        T& operator[](IRInst* inst)
+        {
+            UInt index = m_numbering->getIndex(inst);
+            _ensureCapacity(index);
+            m_present.Add(inst);
+            return m_values[index];
+        }
+
+            /// Set the value for `inst`, which must not already be present.
+        void Add(IRInst* inst, T const& value)
+        {
+            SLANG_ASSERT(!ContainsKey(inst));
+            (*this)[inst] = value;
+        }
+
+            /// Is there a value for `inst`?
+        bool ContainsKey(IRInst* inst) const
+        {
+            return m_present.Contains(inst);
+        }
+
+            /// Get a pointer to the value for `inst`, or null if there isn't one.
+        T* TryGetValue(IRInst* inst) const
+        {
+            if (!m_present.Contains(inst))
+                return nullptr;
+            return &m_values[m_numbering->findIndex(inst)];
+        }
+
+            /// Copy the value for `inst` into `outValue`. Returns false if there isn't one.
+        bool TryGetValue(IRInst* inst, T& outValue) const
+        {
+            if (auto value = TryGetValue(inst))
+            {
+                outValue = *value;
+                return true;
+            }
+            return false;
+        }
+
+            /// Remove the value for `inst`, if present.
+        void Remove(IRInst* inst)
+        {
+            if (!m_present.Contains(inst))
+                return;
+            m_values[m_numbering->findIndex(inst)] = T();
+            m_present.Remove(inst);
+        }
+
+    protected:
+        void _ensureCapacity(UInt index)
+        {
+            UInt oldCount = m_values.Count();
+            if (index < oldCount)
+                return;
+
+            UInt count = m_numbering->getCount();
+            if (count <= index)
+                count = index + 1;
+
+            m_values.GrowToSize(count);
+            for (UInt ii = oldCount; ii < count; ++ii)
+                m_values[ii] = T();
+        }
+
+        IRInstNumbering*    m_numbering;
+        List<T>             m_values;
+        IRInstSet           m_present;
+    };
+}
@@ -226,6 +226,8 @@ struct IRRequireGLSLExtensionDecoration : IRDecoration
 IR_SIMPLE_DECORATION(ReadNoneDecoration)
 IR_SIMPLE_DECORATION(EarlyDepthStencilDecoration)
 IR_SIMPLE_DECORATION(GloballyCoherentDecoration)
+IR_SIMPLE_DECORATION(ForceInlineDecoration)
+IR_SIMPLE_DECORATION(NoInlineDecoration)
 
     /// A decoration that marks a value as having linkage.
     ///
@@ -78,6 +78,7 @@ LegalVal LegalVal::getImplicitDeref()
 
 IRTypeLegalizationContext::IRTypeLegalizationContext(
     IRModule* inModule)
+    : mapValToLegalVal(&instNumbering)
 {
     session = inModule->getSession();
     module = inModule;
@@ -3,6 +3,7 @@
 
 #include "ir.h"
 #include "ir-insts.h"
+#include "ir-serialize.h"
 #include "mangle.h"
 
 namespace Slang
@@ -45,11 +46,21 @@ struct IRSharedSpecContext
     typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
+    // Modules that are read from serialized IR on demand. Their
+    // global values are only added to `symbols` the first time
+    // their mangled name is looked up (see `findGlobalValueSymbol`).
+    List<IRSerialLazyModule*> lazyModules;
+    HashSet<String> lazySymbolNames;
+
     SharedIRBuilder sharedBuilderStorage;
     IRBuilder builderStorage;
 
     // The "global" specialization environment.
     IRSpecEnv globalEnv;
+
+    // Generic specializations that were created for earlier
+    // entry points, if any.
+    IRSpecializationCache* specializationCache = nullptr;
 };
 
 struct IRSpecContextBase
@@ -211,6 +222,11 @@ struct IRSpecContext : IRSpecContextBase
 
 IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal);
 
+bool findGlobalValueSymbol(
+    IRSharedSpecContext*    sharedContext,
+    String const&           mangledName,
+    RefPtr<IRSpecSymbol>&   outSym);
+
 IRInst* cloneValue(
     IRSpecContextBase*  context,
     IRInst*        originalValue);
@@ -219,8 +235,37 @@ IRType* cloneType(
     IRSpecContextBase*  context,
     IRType*             originalType);
 
+IRInst* findCachedSpecialization(
+    IRSharedSpecContext*    sharedContext,
+    IRSpecialize*           specializeInst);
+
+// If the same generic has already been specialized to the same
+// arguments for another entry point, we copy the specialized
+// result instead of the `specialize` instruction, so that
+// the generic doesn't need to be specialized again.
+//
+IRInst* maybeCloneCachedSpecialization(
+    IRSpecContextBase*  context,
+    IRInst*             originalValue)
+{
+    auto specializeInst = as<IRSpecialize>(originalValue);
+    if(!specializeInst)
+        return nullptr;
+
+    auto cachedVal = findCachedSpecialization(context->getShared(), specializeInst);
+    if(!cachedVal)
+        return nullptr;
+
+    IRInst* clonedValue = cloneValue(context, cachedVal);
+    registerClonedValue(context, clonedValue, originalValue);
+    return clonedValue;
+}
+
 IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
 {
+    if(auto clonedValue = maybeCloneCachedSpecialization(this, originalValue))
+        return clonedValue;
+
     switch (originalValue->op)
     {
     case kIROp_StructType:
@@ -678,7 +723,7 @@ IRFunc* specializeIRForEntryPoint(
     //
     auto mangledName = getMangledName(entryPoint->getFuncDeclRef());
     RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().TryGetValue(mangledName, sym))
+    if (!findGlobalValueSymbol(context->getShared(), mangledName, sym))
     {
         SLANG_UNEXPECTED("no matching IR symbol");
         return nullptr;
@@ -980,6 +1025,11 @@ IRInst* cloneInst(
     case kIROp_GlobalGenericParam:
         return cloneGlobalGenericParamImpl(context, builder, cast<IRGlobalGenericParam>(originalInst), originalValues);
 
+    case kIROp_Specialize:
+        if(auto clonedValue = maybeCloneCachedSpecialization(context, originalInst))
+            return clonedValue;
+        break;
+
     default:
         break;
     }
@@ -1062,7 +1112,7 @@ IRInst* cloneGlobalValueWithLinkage(
 
     auto mangledName = String(originalLinkage->getMangledName());
     RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().TryGetValue(mangledName, sym) )
+    if( !findGlobalValueSymbol(context->getShared(), mangledName, sym) )
     {
         if(!originalVal)
             return nullptr;
@@ -1156,6 +1206,32 @@ void insertGlobalValueSymbols(
     }
 }
 
+bool findGlobalValueSymbol(
+    IRSharedSpecContext*    sharedContext,
+    String const&           mangledName,
+    RefPtr<IRSpecSymbol>&   outSym)
+{
+    // The first time we see a name, any global values with that
+    // name in modules that are read on demand get materialized
+    // and added to the symbol table after the ones that were
+    // registered up front.
+    //
+    if( sharedContext->lazyModules.Count() && sharedContext->lazySymbolNames.Add(mangledName) )
+    {
+        List<IRInst*> lazyValues;
+        for( auto lazyModule : sharedContext->lazyModules )
+        {
+            lazyModule->findSymbols(mangledName.getUnownedSlice(), lazyValues);
+        }
+        for( auto lazyValue : lazyValues )
+        {
+            insertGlobalValueSymbol(sharedContext, lazyValue);
+        }
+    }
+
+    return sharedContext->symbols.TryGetValue(mangledName, outSym);
+}
+
 void initializeSharedSpecContext(
     IRSharedSpecContext*    sharedContext,
     Session*                session,
@@ -1180,6 +1256,237 @@ void initializeSharedSpecContext(
     sharedContext->target = target;
 }
 
+// The key for a cached specialization needs to identify the generic
+// and its arguments in a way that doesn't depend on the module
+// they were found in, since the code for each entry point is linked
+// into a fresh module. Values with linkage are identified by their
+// mangled name, literals by their value, and structural types
+// by their opcode and operands.
+//
+// Each part of a key is prefixed with its length, so that the
+// key for one specialization can't be confused with the key for
+// a different one. The key is also used as the mangled name of
+// the cached value, so it starts with a prefix that the mangling
+// of declarations never produces.
+//
+static bool appendSpecializationCacheKeyPart(
+    StringBuilder&                          sb,
+    IRInst*                                 inst,
+    Dictionary<IRInst*, String> const&      knownKeys)
+{
+    String part;
+    if( auto knownKey = knownKeys.TryGetValue(inst) )
+    {
+        part = *knownKey;
+    }
+    else if( auto linkage = inst->findDecoration<IRLinkageDecoration>() )
+    {
+        part = String(linkage->getMangledName());
+    }
+    else
+    {
+        StringBuilder partBuilder;
+        switch( inst->op )
+        {
+        case kIROp_IntLit:
+            {
+                auto value = ((IRConstant*) inst)->value.intVal;
+                partBuilder << "i";
+                if( value < 0 )
+                {
+                    partBuilder << "n";
+                    value = -value;
+                }
+                partBuilder << value;
+            }
+            break;
+
+        case kIROp_BoolLit:
+            partBuilder << (((IRConstant*) inst)->value.intVal ? "b1" : "b0");
+            break;
+
+        case kIROp_Specialize:
+            {
+                auto specializeInst = (IRSpecialize*) inst;
+                List<IRInst*> args;
+                for( UInt ii = 0; ii < specializeInst->getArgCount(); ++ii )
+                    args.Add(specializeInst->getArg(ii));
+
+                String key;
+                if( !getSpecializationCacheKey(specializeInst->getBase(), args.Count(), args.Buffer(), knownKeys, key) )
+                    return false;
+                partBuilder << key;
+            }
+            break;
+
+        // Nominal types are only identified by their linkage.
+        case kIROp_StructType:
+        case kIROp_InterfaceType:
+            return false;
+
+        default:
+            {
+                if( !as<IRType>(inst) )
+                    return false;
+
+                UInt operandCount = inst->getOperandCount();
+                partBuilder << "t" << Int32(inst->op) << "_" << Int32(operandCount);
+                for( UInt ii = 0; ii < operandCount; ++ii )
+                {
+                    if( !appendSpecializationCacheKeyPart(partBuilder, inst->getOperand(ii), knownKeys) )
+                        return false;
+                }
+            }
+            break;
+        }
+        part = partBuilder.ProduceString();
+    }
+
+    sb << Int32(part.Length()) << part;
+    return true;
+}
+
+bool getSpecializationCacheKey(
+    IRInst*                                 generic,
+    UInt                                    argCount,
+    IRInst* const*                          args,
+    Dictionary<IRInst*, String> const&      knownKeys,
+    String&                                 outKey)
+{
+    StringBuilder sb;
+    sb << "_SX";
+    if( !appendSpecializationCacheKeyPart(sb, generic, knownKeys) )
+        return false;
+    for( UInt ii = 0; ii < argCount; ++ii )
+    {
+        if( !appendSpecializationCacheKeyPart(sb, args[ii], knownKeys) )
+            return false;
+    }
+    outKey = sb.ProduceString();
+    return true;
+}
+
+IRInst* findCachedSpecialization(
+    IRSharedSpecContext*    sharedContext,
+    IRSpecialize*           specializeInst)
+{
+    auto cache = sharedContext->specializationCache;
+    if( !cache || cache->specializations.Count() == 0 )
+        return nullptr;
+
+    List<IRInst*> args;
+    for( UInt ii = 0; ii < specializeInst->getArgCount(); ++ii )
+        args.Add(specializeInst->getArg(ii));
+
+    String key;
+    Dictionary<IRInst*, String> knownKeys;
+    if( !getSpecializationCacheKey(specializeInst->getBase(), args.Count(), args.Buffer(), knownKeys, key) )
+        return nullptr;
+
+    IRInst* cachedVal = nullptr;
+    cache->specializations.TryGetValue(key, cachedVal);
+    return cachedVal;
+}
+
+// A value can only be copied into the cache if everything it
+// references can be found again when the cached copy is linked
+// into the module for another entry point. Global variables and
+// parameters without linkage (e.g., ones created by earlier
+// passes) would be duplicated instead.
+//
+static bool canCacheSpecializedValue(
+    IRInst*             inst,
+    HashSet<IRInst*>&   visited)
+{
+    if( !inst || visited.Contains(inst) )
+        return true;
+    visited.Add(inst);
+
+    if( as<IRModuleInst>(inst->getParent()) )
+    {
+        switch( inst->op )
+        {
+        case kIROp_GlobalVar:
+        case kIROp_GlobalParam:
+        case kIROp_GlobalConstant:
+            if( !inst->findDecoration<IRLinkageDecoration>() )
+                return false;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if( !canCacheSpecializedValue(inst->getFullType(), visited) )
+        return false;
+    for( UInt ii = 0; ii < inst->getOperandCount(); ++ii )
+    {
+        if( !canCacheSpecializedValue(inst->getOperand(ii), visited) )
+            return false;
+    }
+    for( auto child : inst->getDecorationsAndChildren() )
+    {
+        if( !canCacheSpecializedValue(child, visited) )
+            return false;
+    }
+    return true;
+}
+
+void addSpecializationsToCache(
+    IRSpecializationCache*                  cache,
+    IRModule*                               module,
+    Dictionary<String, IRInst*> const&      specializations)
+{
+    IRSharedSpecContext sharedContext;
+    initializeSharedSpecContext(
+        &sharedContext,
+        module->session,
+        cache->module,
+        cache->target);
+    cache->module = sharedContext.module;
+
+    // Values with linkage that the specialized code references
+    // are looked up by their mangled name, and we prefer the
+    // copies that are already in the cache.
+    //
+    insertGlobalValueSymbols(&sharedContext, cache->module);
+    insertGlobalValueSymbols(&sharedContext, module);
+
+    IRSpecContext context;
+    context.shared = &sharedContext;
+    context.builder = &sharedContext.builderStorage;
+    context.env = &sharedContext.globalEnv;
+    context.builder->setInsertInto(cache->module->getModuleInst());
+
+    // Specializations that are already cached (because an earlier
+    // entry point created them too) are used as-is.
+    //
+    for( auto entry : specializations )
+    {
+        IRInst* cachedVal = nullptr;
+        if( cache->specializations.TryGetValue(entry.Key, cachedVal) )
+            registerClonedValue(&context, cachedVal, entry.Value);
+    }
+
+    for( auto entry : specializations )
+    {
+        if( cache->specializations.ContainsKey(entry.Key) )
+            continue;
+
+        HashSet<IRInst*> visited;
+        if( !canCacheSpecializedValue(entry.Value, visited) )
+            continue;
+
+        // The value may have already been copied because another
+        // specialization references it.
+        //
+        IRInst* cachedVal = cloneValue(&context, entry.Value);
+        context.builder->addExportDecoration(cachedVal, entry.Key.getUnownedSlice());
+        cache->specializations.Add(entry.Key, cachedVal);
+    }
+}
+
 struct IRSpecializationState
 {
     ProgramLayout*      programLayout;
@@ -1244,7 +1551,25 @@ LinkedIR linkIR(
     insertGlobalValueSymbols(sharedContext, originalProgramIRModule);
     for (auto module : program->getModuleDependencies())
     {
-        insertGlobalValueSymbols(sharedContext, module->getIRModule());
+        if( auto lazyIRModule = module->getLazyIRModule() )
+        {
+            sharedContext->lazyModules.Add(lazyIRModule);
+        }
+        else
+        {
+            insertGlobalValueSymbols(sharedContext, module->getIRModule());
+        }
+    }
+
+    // The cached specializations from earlier entry points are
+    // registered last, so that the original definitions of any
+    // symbols that were copied into the cache are preferred.
+    //
+    if( auto specializationCache = program->getTargetProgram(targetReq)->getSpecializationCache() )
+    {
+        SLANG_ASSERT(specializationCache->target == target);
+        sharedContext->specializationCache = specializationCache;
+        insertGlobalValueSymbols(sharedContext, specializationCache->module);
     }
 
     auto context = state->getContext();
@@ -1272,23 +1597,17 @@ LinkedIR linkIR(
 
     context->builder->setInsertInto(context->getModule()->getModuleInst());
 
-    // for now, clone all unreferenced witness tables
-    //
-    // TODO: This step should *not* be needed with the current IR
-    // specialization approach, so we should consider removing it.
-    //
-    for (auto sym :context->getSymbols())
-    {
-        if (sym.Value->irGlobalValue->op == kIROp_WitnessTable)
-            cloneGlobalValue(context, (IRWitnessTable*)sym.Value->irGlobalValue);
-    }
-
     auto entryPointLayout = findEntryPointLayout(programLayout, entryPoint);
 
     // Next, we make sure to clone the global value for
     // the entry point function itself, and rely on
     // this step to recursively copy over anything else
     // it might reference.
+    //
+    // Note that witness tables are only cloned when they are
+    // referenced, either from the code reachable from the entry
+    // point, or from the global generic and existential slot
+    // bindings below.
     auto irEntryPoint = specializeIRForEntryPoint(context, entryPoint, entryPointLayout);
 
     // HACK: right now the bindings for global generic parameters are coming in
@@ -1325,7 +1644,7 @@ LinkedIR linkIR(
         auto mangledName = getMangledTypeName(taggedUnionType);
 
         RefPtr<IRSpecSymbol> sym;
-        if(!context->getSymbols().TryGetValue(mangledName, sym))
+        if(!findGlobalValueSymbol(context->getShared(), mangledName, sym))
             continue;
 
         IRInst* clonedType = findClonedValue(context, sym->irGlobalValue);
@@ -11,6 +11,52 @@ namespace Slang
         IRFunc*             entryPoint;
     };
 
+    // A cache of the specialized generic functions and types that
+    // were created while generating code for one entry point, so
+    // that they can be re-used by the other entry points of the
+    // same program on the same target.
+    //
+    // Each cached value is stored in `module` with an export
+    // decoration, whose mangled name is the key built from the
+    // generic and its arguments (see `getSpecializationCacheKey`).
+    //
+    struct IRSpecializationCache : RefObject
+    {
+        // The target that the cached code was linked for
+        CodeGenTarget                   target = CodeGenTarget::Unknown;
+
+        // The module that owns the cached values
+        RefPtr<IRModule>                module;
+
+        // A map from a specialization key to the cached value
+        Dictionary<String, IRInst*>     specializations;
+    };
+
+        /// Compute the key used to look up the specialization of
+        /// `generic` to `args` in an `IRSpecializationCache`.
+        ///
+        /// The `knownKeys` give the keys for values that were themselves
+        /// created by specialization. Returns `false` if the generic or
+        /// any of the arguments doesn't have an identity that can be
+        /// expressed independently of the module it lives in.
+        ///
+    bool getSpecializationCacheKey(
+        IRInst*                                 generic,
+        UInt                                    argCount,
+        IRInst* const*                          args,
+        Dictionary<IRInst*, String> const&      knownKeys,
+        String&                                 outKey);
+
+        /// Add the given specialized values from `module` to the `cache`.
+        ///
+        /// The `specializations` map keys computed with `getSpecializationCacheKey`
+        /// to the values to copy. Keys that are already in the cache are skipped.
+        ///
+    void addSpecializationsToCache(
+        IRSpecializationCache*                  cache,
+        IRModule*                               module,
+        Dictionary<String, IRInst*> const&      specializations);
+
 
     // Clone the IR values reachable from the given entry point
     // into the IR module associated with the specialization state.
@@ -18,6 +64,9 @@ namespace Slang
     // that is best specialized for the given `targetReq` will be
     // used.
     //
+    // Generic specializations that are already in the specialization
+    // cache of the target program (if any) are copied from the cache.
+    //
     LinkedIR linkIR(
         BackEndCompileRequest*  compileRequest,
         EntryPoint*             entryPoint,
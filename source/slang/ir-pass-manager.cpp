@@ -0,0 +1,116 @@
+// ir-pass-manager.cpp
+#include "ir-pass-manager.h"
+
+#include "../core/slang-string-util.h"
+
+#include "compiler.h"
+#include "ir.h"
+#include "ir-validate.h"
+
+namespace Slang {
+
+UInt countIRInsts(IRModule* module)
+{
+    UInt count = 0;
+
+    List<IRInst*> stack;
+    stack.Add(module->getModuleInst());
+    while (stack.Count() != 0)
+    {
+        IRInst* inst = stack.Last();
+        stack.RemoveLast();
+        count++;
+
+        for (auto child : inst->getDecorationsAndChildren())
+            stack.Add(child);
+    }
+    return count;
+}
+
+static bool _shouldDumpIRAfterPass(
+    CompileRequestBase* compileRequest,
+    String const&       passName)
+{
+    for (auto const& name : compileRequest->irPassNamesToDump)
+    {
+        if (name == passName || name == "all")
+            return true;
+
+        // A name without a suffix matches every run of the function
+        // (e.g., `constructSSA` matches `constructSSA.afterLowering`).
+        if (passName.StartsWith(name + "."))
+            return true;
+    }
+    return false;
+}
+
+void IRPassManager::_beginPass(char const* passName)
+{
+    m_stats = IRPassStats();
+    m_stats.passName = passName;
+
+    if (m_compileRequest->shouldRecordIRPassStats)
+    {
+        m_stats.instCountBefore = countIRInsts(m_module);
+        m_stats.memoryUsedBefore = m_module->memoryArena.calcTotalMemoryUsed();
+    }
+
+    // The clock is started last, so that gathering the
+    // statistics above isn't counted as part of the pass.
+    m_startTicks = Timer::now();
+}
+
+void IRPassManager::_endPass()
+{
+    Timer::Ticks endTicks = Timer::now();
+
+    if (m_compileRequest->shouldRecordIRPassStats)
+    {
+        m_stats.timeInSeconds = Timer::toSeconds(endTicks - m_startTicks);
+        m_stats.instCountAfter = countIRInsts(m_module);
+        m_stats.memoryUsedAfter = m_module->memoryArena.calcTotalMemoryUsed();
+
+        m_compileRequest->irPassStats.Add(m_stats);
+    }
+
+    if (auto compileStats = m_compileRequest->compileStats)
+        compileStats->addEvent(m_stats.passName.Buffer(), m_startTicks, endTicks);
+
+    if (_shouldDumpIRAfterPass(m_compileRequest, m_stats.passName))
+    {
+        DiagnosticSinkWriter writerImpl(m_compileRequest->getSink());
+        WriterHelper writer(&writerImpl);
+
+        writer.put("### AFTER ");
+        writer.put(m_stats.passName.Buffer());
+        writer.put(":\n");
+        dumpIR(m_module, writer.getWriter());
+        writer.put("###\n");
+    }
+
+    validateIRModuleIfEnabled(m_compileRequest, m_module);
+}
+
+void appendIRPassStatsReport(List<IRPassStats> const& stats, StringBuilder& out)
+{
+    out << "### IR pass statistics:\n";
+    StringUtil::appendFormat(out, "%12s %12s %12s %14s  %s\n", "time (ms)", "insts before", "insts after", "arena growth", "pass");
+
+    double totalTime = 0.0;
+    for (auto const& passStats : stats)
+    {
+        totalTime += passStats.timeInSeconds;
+
+        StringUtil::appendFormat(out, "%12.3f %12u %12u %14lld  %s\n",
+            passStats.timeInSeconds * 1000.0,
+            (unsigned int) passStats.instCountBefore,
+            (unsigned int) passStats.instCountAfter,
+            (long long) passStats.memoryUsedAfter - (long long) passStats.memoryUsedBefore,
+            passStats.passName.Buffer());
+    }
+
+    StringUtil::appendFormat(out, "%12.3f %12s %12s %14s  %s\n", totalTime * 1000.0, "", "", "", "total");
+    out << "###\n";
+}
+
+}
@@ -0,0 +1,74 @@
+// ir-pass-manager.h
+#pragma once
+
+#include "../core/basic.h"
+#include "../core/slang-timer.h"
+
+namespace Slang
+{
+    class CompileRequestBase;
+    struct IRModule;
+
+        /// Statistics recorded for a single run of an IR pass.
+    struct IRPassStats
+    {
+        String  passName;
+        double  timeInSeconds = 0.0;
+
+            /// The number of instructions in the module before/after the pass
+        UInt    instCountBefore = 0;
+        UInt    instCountAfter = 0;
+
+            /// The number of bytes used in the module's `MemoryArena` before/after the pass
+        size_t  memoryUsedBefore = 0;
+        size_t  memoryUsedAfter = 0;
+    };
+
+        /// Runs a sequence of named passes over an IR module.
+        ///
+        /// Each pass is named after the function that it runs (e.g., `specializeModule`).
+        /// A function that runs at more than one point in a compile gets a suffix that
+        /// says where (e.g., `eliminateDeadCode.afterSpecialization` and
+        /// `eliminateDeadCode.beforeEmit`), so that every pass name is unique.
+        ///
+        /// After each pass the module is dumped (if a dump was requested
+        /// for that pass by name) and validated (if IR validation is enabled).
+        /// If the compile request has `shouldRecordIRPassStats` set, then
+        /// statistics for each pass are appended to its `irPassStats`, and
+        /// if it has `compileStats` then each pass is recorded as a phase.
+        ///
+    struct IRPassManager
+    {
+        IRPassManager(
+            CompileRequestBase* compileRequest,
+            IRModule*           module)
+            : m_compileRequest(compileRequest)
+            , m_module(module)
+        {}
+
+            /// Run `pass`, which is expected to transform the module, under the name `passName`.
+        template<typename F>
+        void run(char const* passName, F const& pass)
+        {
+            _beginPass(passName);
+            pass();
+            _endPass();
+        }
+
+    protected:
+        void _beginPass(char const* passName);
+        void _endPass();
+
+        CompileRequestBase* m_compileRequest;
+        IRModule*           m_module;
+
+        IRPassStats         m_stats;
+        Timer::Ticks        m_startTicks = 0;
+    };
+
+        /// Count the instructions in `module`, including decorations.
+    UInt countIRInsts(IRModule* module);
+
+        /// Append a human-readable table of `stats` to `out`.
+    void appendIRPassStatsReport(List<IRPassStats> const& stats, StringBuilder& out);
+}
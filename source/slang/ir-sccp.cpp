@@ -2,8 +2,11 @@
 #include "ir-sccp.h"
 
 #include "ir.h"
+#include "ir-inst-map.h"
 #include "ir-insts.h"
 
+#include <cmath>
+
 namespace Slang {
 
 
@@ -26,6 +29,17 @@ struct SCCPContext
     SharedSCCPContext*      shared; // shared state across functions
     IRGlobalValueWithCode*  code;   // the function/code we are optimizing
 
+    // The per-instruction and per-block state below is stored in
+    // side tables indexed by a dense numbering of the instructions
+    // in the function.
+    //
+    IRInstNumbering instNumbering;
+
+    SCCPContext()
+        : mapInstToLatticeVal(&instNumbering)
+        , executedBlocks(&instNumbering)
+    {}
+
     // The SCCP algorithm applies abstract interpretation to the code of the
     // function using a "lattice" of values. We can think of a node on the
     // lattice as representing a set of values that a given instruction
@@ -167,7 +181,7 @@ struct SCCPContext
     // where any instruction not present in the map is assumed to default
     // to the `None` case (the empty set)
     //
-    Dictionary<IRInst*, LatticeVal> mapInstToLatticeVal;
+    IRInstMap<LatticeVal> mapInstToLatticeVal;
 
     // Updating the lattice value for an instruction is easy, but we'll
     // use a simple function to make our intention clear.
@@ -233,8 +247,6 @@ struct SCCPContext
     //
     LatticeVal interpretOverLattice(IRInst* inst)
     {
-        SLANG_UNUSED(inst);
-
         // Certain instruction always produce constants, and we
         // want to special-case them here.
         switch( inst->op )
@@ -245,53 +257,55 @@ struct SCCPContext
         case kIROp_BoolLit:
             return LatticeVal::getConstant(inst);
 
-        // TODO: we might also want to special-case certain
-        // instructions where we shouldn't bother trying to
-        // constant-fold them and should just default to the
-        // `Any` value right away.
-
         default:
             break;
         }
 
-        // TODO: We should now look up the lattice values for
-        // the operands of the instruction.
-        //
-        // If all of the operands have `Constant` lattice values,
-        // then we can potential execute the operation directly
-        // on those constant values, create a fresh `IRConstant`,
-        // and return a `Constant` lattice value for it. This
-        // would allow us to achieve true constant folding here.
+        // Otherwise, we will look up the lattice values for the
+        // operands of the instruction, and if they are all `Constant`
+        // we may be able to execute the operation directly on those
+        // constant values (see `tryFoldInst`).
         //
         // Textbook discussions of SCCP often point out that it
         // is also possible to perform certain algebraic simplifications
         // here, such as evaluating a multiply by a `Constant` zero
-        // to zero.
-        //
-        // As a default, if any operand has the `Any` value
-        // then the result of the operation should be treated as
-        // `Any`. There are exceptions to this, however, with the
-        // multiply-by-zero example being an important example.
-        // If we had previously decided that (Any * None) -> Any
-        // but then we refine our estimates and have (Any * Constant(0)) -> Constant(0)
-        // then we have violated the monotonicity rules for how
-        // our values move through the lattice, and we may break
-        // the convergence guarantees of the analysis.
+        // to zero. We don't do that: if we had previously decided
+        // that (Any * None) -> Any but then we refine our estimates
+        // and have (Any * Constant(0)) -> Constant(0) then we would
+        // violate the monotonicity rules for how our values move
+        // through the lattice, and may break the convergence
+        // guarantees of the analysis.
         //
         // When we have a mix of `None` and `Constant` operands,
         // then the `None` values imply that our operation is using
         // uninitialized data or the results of undefined behavior.
         // We could try to propagate the `None` through, and allow
         // the compiler to speculatively assume that the operation
-        // produces whatever value we find convenient. Alternatively,
-        // we can be less aggressive and treat an operation with
-        // `None` inputs as producing `Any` to make sure we don't
-        // optimize the code based on non-obvious assumptions.
-        //
-        // For now we aren't implementing *any* folding logic here,
-        // for simplicity. This is the right place to add folding
-        // optimizations if/when we need them.
+        // produces whatever value we find convenient. We instead
+        // are less aggressive and treat an operation with
+        // `None` (or `Any`) inputs as producing `Any`, to make
+        // sure we don't optimize the code based on non-obvious
+        // assumptions.
         //
+        if( canFoldInst(inst) )
+        {
+            UInt operandCount = inst->getOperandCount();
+            UInt firstOperand = inst->op == kIROp_Call ? 1 : 0;
+            for( UInt ii = firstOperand; ii < operandCount; ++ii )
+            {
+                // A `select` only needs its condition to be constant
+                // for us to know which of the other operands it yields.
+                //
+                if(inst->op == kIROp_Select && ii != 0)
+                    continue;
+
+                if(getLatticeVal(inst->getOperand(ii)).flavor != LatticeVal::Flavor::Constant)
+                    return LatticeVal::getAny();
+            }
+
+            if( auto folded = tryFoldInst(inst) )
+                return LatticeVal::getConstant(folded);
+        }
 
         // A safe default is to assume that every instruction not
         // handled by one of the cases above could produce *any*
@@ -299,6 +313,1091 @@ struct SCCPContext
         return LatticeVal::getAny();
     }
 
+    //
+    // Constant Folding
+    //
+    // The folding logic works on scalar and vector values of a handful
+    // of basic types. We only fold an operation when every target is
+    // required to compute it exactly (as IEEE 754, or two's complement
+    // integer math), so that the value we compute is bit-for-bit the
+    // value that the operation would have produced at runtime:
+    //
+    // * Floating-point operations are limited to `+`, `-` and `*`
+    //   (which D3D and Vulkan require to be correctly rounded), and
+    //   operations that don't round at all (negation, `abs`, `floor`,
+    //   `ceil`, `trunc`, `min`, `max`, `clamp` and `saturate`).
+    //
+    // * `float` math is performed in single precision, one rounding
+    //   per operation, rather than in the `double` precision that
+    //   our literals are stored with.
+    //
+    // * Operations that targets are allowed to approximate are never
+    //   folded. This includes floating-point division, `sqrt`, `rsqrt`,
+    //   `sin`, `pow` and `exp`, and anything built from them (such as
+    //   `length` and `normalize`). It also includes a floating-point
+    //   `dot`, which may be computed with fused multiply-adds.
+    //
+    // * Operations that would produce an infinity, NaN, or undefined
+    //   result (integer division by zero, out-of-range shifts and
+    //   conversions) are never folded.
+    //
+    // A constant of scalar type is represented by a literal
+    // (`IRIntLit`, etc.), while a constant of vector type is
+    // represented by a `makeVector` of literals. Vectors that we compute
+    // are created without being inserted into the function, and only
+    // get inserted (as copies) when we replace an instruction with its
+    // value. Matrices are only supported as constant *inputs* (e.g.,
+    // to extract a row), so that we never need to create one.
+    //
+    enum class ScalarKind
+    {
+        Unsupported,
+        Bool,
+        Int,
+        UInt,
+        Float,
+        Double,
+    };
+
+    struct ScalarVal
+    {
+        ScalarKind      kind = ScalarKind::Unsupported;
+        IRIntegerValue  intVal = 0;     // for `Bool`, `Int`, and `UInt`
+        double          floatVal = 0;   // for `Float` and `Double`
+    };
+
+    static ScalarKind getScalarKind(IRType* type)
+    {
+        switch( type->op )
+        {
+        case kIROp_BoolType:    return ScalarKind::Bool;
+        case kIROp_IntType:     return ScalarKind::Int;
+        case kIROp_UIntType:    return ScalarKind::UInt;
+        case kIROp_FloatType:   return ScalarKind::Float;
+        case kIROp_DoubleType:  return ScalarKind::Double;
+        default:                return ScalarKind::Unsupported;
+        }
+    }
+
+    static bool isFloatingPointKind(ScalarKind kind)
+    {
+        return kind == ScalarKind::Float || kind == ScalarKind::Double;
+    }
+
+    // Get the scalar element type of a scalar, vector, or matrix type,
+    // along with the total number of elements.
+    //
+    static IRType* getScalarElementType(IRType* type, UInt* outCount)
+    {
+        if( auto vectorType = as<IRVectorType>(type) )
+        {
+            auto count = as<IRIntLit>(vectorType->getElementCount());
+            if(!count)
+                return nullptr;
+            *outCount = UInt(count->getValue());
+            return vectorType->getElementType();
+        }
+        else if( auto matrixType = as<IRMatrixType>(type) )
+        {
+            auto rowCount = as<IRIntLit>(matrixType->getRowCount());
+            auto colCount = as<IRIntLit>(matrixType->getColumnCount());
+            if(!rowCount || !colCount)
+                return nullptr;
+            *outCount = UInt(rowCount->getValue() * colCount->getValue());
+            return matrixType->getElementType();
+        }
+        else if( as<IRBasicType>(type) )
+        {
+            *outCount = 1;
+            return type;
+        }
+        return nullptr;
+    }
+
+    static bool readScalar(IRInst* inst, ScalarVal& outVal)
+    {
+        outVal.kind = getScalarKind(inst->getDataType());
+        switch( inst->op )
+        {
+        case kIROp_IntLit:
+        case kIROp_BoolLit:
+            if(isFloatingPointKind(outVal.kind))
+                return false;
+            outVal.intVal = ((IRConstant*) inst)->value.intVal;
+            break;
+
+        case kIROp_FloatLit:
+            if(!isFloatingPointKind(outVal.kind))
+                return false;
+            outVal.floatVal = ((IRConstant*) inst)->value.floatVal;
+
+            // A `float` literal is stored in double precision, but
+            // the target will only ever see the nearest `float`.
+            //
+            if(outVal.kind == ScalarKind::Float)
+                outVal.floatVal = float(outVal.floatVal);
+            break;
+
+        default:
+            return false;
+        }
+        return outVal.kind != ScalarKind::Unsupported;
+    }
+
+    // Wrap an integer result to the range of its (32-bit) type.
+    //
+    static IRIntegerValue wrapInt(ScalarKind kind, IRIntegerValue value)
+    {
+        switch( kind )
+        {
+        case ScalarKind::Int:   return IRIntegerValue(int32_t(uint32_t(value)));
+        case ScalarKind::UInt:  return IRIntegerValue(uint32_t(value));
+        case ScalarKind::Bool:  return value != 0;
+        default:                return value;
+        }
+    }
+
+    static bool convertScalar(ScalarVal const& val, ScalarKind toKind, ScalarVal& outVal)
+    {
+        outVal.kind = toKind;
+        if( val.kind == toKind )
+        {
+            outVal = val;
+            return true;
+        }
+
+        if( isFloatingPointKind(toKind) )
+        {
+            double value = 0;
+            switch( val.kind )
+            {
+            case ScalarKind::Float:
+            case ScalarKind::Double:
+                value = val.floatVal;
+                break;
+            default:
+                value = double(val.intVal);
+                break;
+            }
+
+            // Integer-to-float conversions are rounded directly to
+            // the nearest `float`, rather than through `double`.
+            //
+            if( toKind == ScalarKind::Float )
+            {
+                if(isFloatingPointKind(val.kind))
+                    value = float(value);
+                else
+                    value = float(val.intVal);
+            }
+            outVal.floatVal = value;
+            return true;
+        }
+
+        if( toKind == ScalarKind::Bool )
+        {
+            outVal.intVal = isFloatingPointKind(val.kind) ? (val.floatVal != 0) : (val.intVal != 0);
+            return true;
+        }
+
+        if( isFloatingPointKind(val.kind) )
+        {
+            // Float-to-integer conversion truncates, and is undefined
+            // if the result is out of range of the integer type.
+            //
+            double truncated = std::trunc(val.floatVal);
+            double minVal = toKind == ScalarKind::Int ? -2147483648.0 : 0.0;
+            double maxVal = toKind == ScalarKind::Int ? 2147483647.0 : 4294967295.0;
+            if(!(truncated >= minVal && truncated <= maxVal))
+                return false;
+            outVal.intVal = IRIntegerValue(truncated);
+            return true;
+        }
+
+        outVal.intVal = wrapInt(toKind, val.intVal);
+        return true;
+    }
+
+    // Create a literal for a scalar result, or return null if the
+    // value is one that we shouldn't fold to.
+    //
+    IRInst* makeScalar(IRType* type, ScalarVal const& val)
+    {
+        auto builder = getBuilder();
+        switch( val.kind )
+        {
+        case ScalarKind::Bool:
+            return builder->getBoolValue(val.intVal != 0);
+
+        case ScalarKind::Int:
+            return builder->getIntValue(type, val.intVal);
+
+        case ScalarKind::UInt:
+            // An unsigned literal outside the range of `int` would need
+            // a suffix to be valid in some of our targets.
+            //
+            if(val.intVal > 0x7FFFFFFF)
+                return nullptr;
+            return builder->getIntValue(type, val.intVal);
+
+        case ScalarKind::Float:
+        case ScalarKind::Double:
+            if(!std::isfinite(val.floatVal))
+                return nullptr;
+            return builder->getFloatValue(type, val.floatVal);
+
+        default:
+            return nullptr;
+        }
+    }
+
+    // Get the constant value (a literal or a vector/matrix constructor)
+    // that an operand is known to have.
+    //
+    IRInst* getConstantOperand(IRInst* operand)
+    {
+        auto latticeVal = getLatticeVal(operand);
+        if(latticeVal.flavor != LatticeVal::Flavor::Constant)
+            return nullptr;
+        return latticeVal.value;
+    }
+
+    // Get the scalar components of a constant value, in order
+    // (row-major for matrices), converted to `kind`.
+    //
+    bool getComponents(IRInst* constant, ScalarKind kind, List<ScalarVal>& outComponents)
+    {
+        switch( constant->op )
+        {
+        case kIROp_IntLit:
+        case kIROp_FloatLit:
+        case kIROp_BoolLit:
+            {
+                ScalarVal val, converted;
+                if(!readScalar(constant, val))
+                    return false;
+                if(!convertScalar(val, kind, converted))
+                    return false;
+                outComponents.Add(converted);
+                return true;
+            }
+
+        case kIROp_constructVectorFromScalar:
+            {
+                UInt count = 0;
+                if(!getScalarElementType(constant->getDataType(), &count))
+                    return false;
+                auto operand = getConstantOperand(constant->getOperand(0));
+                if(!operand)
+                    return false;
+                List<ScalarVal> scalar;
+                if(!getComponents(operand, kind, scalar) || scalar.Count() != 1)
+                    return false;
+                for( UInt ii = 0; ii < count; ++ii )
+                    outComponents.Add(scalar[0]);
+                return true;
+            }
+
+        case kIROp_Construct:
+        case kIROp_makeVector:
+        case kIROp_MakeMatrix:
+            {
+                UInt count = 0;
+                if(!getScalarElementType(constant->getDataType(), &count))
+                    return false;
+
+                UInt startCount = outComponents.Count();
+                UInt operandCount = constant->getOperandCount();
+                for( UInt ii = 0; ii < operandCount; ++ii )
+                {
+                    auto operand = getConstantOperand(constant->getOperand(ii));
+                    if(!operand)
+                        return false;
+                    if(!getComponents(operand, kind, outComponents))
+                        return false;
+                }
+
+                // A vector can be constructed from a single scalar,
+                // in which case it is replicated.
+                //
+                UInt componentCount = outComponents.Count() - startCount;
+                if( componentCount == 1 && count > 1 && !as<IRMatrixType>(constant->getDataType()) )
+                {
+                    for( UInt ii = 1; ii < count; ++ii )
+                        outComponents.Add(outComponents[startCount]);
+                    componentCount = count;
+                }
+                return componentCount == count;
+            }
+
+        default:
+            return false;
+        }
+    }
+
+    bool getOperandComponents(IRInst* operand, ScalarKind kind, List<ScalarVal>& outComponents)
+    {
+        auto constant = getConstantOperand(operand);
+        if(!constant)
+            return false;
+        return getComponents(constant, kind, outComponents);
+    }
+
+    // Instructions that represent constant vectors/matrices in the
+    // input code are their own constant value, so that we don't
+    // replace them with an identical copy.
+    //
+    bool isLiteralConstructor(IRInst* inst)
+    {
+        switch( inst->op )
+        {
+        default:
+            return false;
+
+        case kIROp_Construct:
+        case kIROp_makeVector:
+        case kIROp_MakeMatrix:
+            break;
+        }
+
+        auto type = inst->getDataType();
+        if( as<IRMatrixType>(type) )
+        {
+            // Matrices are never created by folding, so a matrix
+            // constructor is constant as long as all its operands are.
+            //
+            List<ScalarVal> components;
+            return getComponents(inst, ScalarKind::Float, components)
+                || getComponents(inst, ScalarKind::Int, components);
+        }
+
+        UInt count = 0;
+        auto elementType = getScalarElementType(type, &count);
+        if(!elementType || !as<IRVectorType>(type))
+            return false;
+        if(inst->getOperandCount() != count)
+            return false;
+        for( UInt ii = 0; ii < count; ++ii )
+        {
+            auto operand = inst->getOperand(ii);
+            if(!as<IRConstant>(operand) || operand->getDataType() != elementType)
+                return false;
+        }
+        return true;
+    }
+
+    // Vectors created by folding are deduplicated, so that the same
+    // vector value is always represented by the same instruction, and
+    // our lattice values can be compared by identity.
+    //
+    Dictionary<IRInstKey, IRInst*> mapKeyToVectorConstant;
+
+    IRInst* makeConstant(IRType* type, List<ScalarVal> const& components)
+    {
+        UInt count = 0;
+        auto elementType = getScalarElementType(type, &count);
+        if(!elementType || count != components.Count())
+            return nullptr;
+
+        List<IRInst*> elements;
+        for( auto component : components )
+        {
+            auto element = makeScalar(elementType, component);
+            if(!element)
+                return nullptr;
+            elements.Add(element);
+        }
+
+        if( as<IRBasicType>(type) )
+            return elements[0];
+        if( !as<IRVectorType>(type) )
+            return nullptr;
+
+        // Note: the vector is created without being added to the
+        // function (our builder has no insertion location).
+        //
+        auto vector = getBuilder()->createIntrinsicInst(type, kIROp_makeVector, elements.Count(), elements.Buffer());
+
+        IRInstKey key = { vector };
+        IRInst* existing = nullptr;
+        if(mapKeyToVectorConstant.TryGetValue(key, existing))
+        {
+            // We already have an identical vector, so the one we
+            // just created isn't needed.
+            //
+            vector->removeAndDeallocate();
+            return existing;
+        }
+        mapKeyToVectorConstant.Add(key, vector);
+        return vector;
+    }
+
+    // The operations we know how to fold, either from IR opcodes
+    // or calls to standard library functions.
+    //
+    enum class FoldOp
+    {
+        None,
+
+        // Element-wise operations
+        Add, Sub, Mul, Div, Mod,
+        Lsh, Rsh, BitAnd, BitOr, BitXor, BitNot,
+        And, Or, Not,
+        Eql, Neq, Less, Greater, Leq, Geq,
+        Neg, Select,
+        Abs, Floor, Ceil, Trunc, Saturate, Min, Max, Clamp,
+
+        // Reductions
+        Dot,
+    };
+
+    static FoldOp getFoldOp(IROp op)
+    {
+        switch( op )
+        {
+        case kIROp_Add:     return FoldOp::Add;
+        case kIROp_Sub:     return FoldOp::Sub;
+        case kIROp_Mul:     return FoldOp::Mul;
+        case kIROp_Div:     return FoldOp::Div;
+        case kIROp_Mod:     return FoldOp::Mod;
+        case kIROp_Lsh:     return FoldOp::Lsh;
+        case kIROp_Rsh:     return FoldOp::Rsh;
+        case kIROp_BitAnd:  return FoldOp::BitAnd;
+        case kIROp_BitOr:   return FoldOp::BitOr;
+        case kIROp_BitXor:  return FoldOp::BitXor;
+        case kIROp_BitNot:  return FoldOp::BitNot;
+        case kIROp_And:     return FoldOp::And;
+        case kIROp_Or:      return FoldOp::Or;
+        case kIROp_Not:     return FoldOp::Not;
+        case kIROp_Eql:     return FoldOp::Eql;
+        case kIROp_Neq:     return FoldOp::Neq;
+        case kIROp_Less:    return FoldOp::Less;
+        case kIROp_Greater: return FoldOp::Greater;
+        case kIROp_Leq:     return FoldOp::Leq;
+        case kIROp_Geq:     return FoldOp::Geq;
+        case kIROp_Neg:     return FoldOp::Neg;
+        case kIROp_Select:  return FoldOp::Select;
+        default:            return FoldOp::None;
+        }
+    }
+
+    // Calls to the standard library functions in this table, with
+    // constant arguments, get evaluated at compile time.
+    //
+    struct IntrinsicFoldInfo
+    {
+        char const* name;
+        FoldOp      op;
+        UInt        argCount;
+    };
+
+    static FoldOp getFoldOpForIntrinsic(UnownedStringSlice const& name, UInt argCount)
+    {
+        static const IntrinsicFoldInfo kIntrinsics[] =
+        {
+            { "abs",        FoldOp::Abs,        1 },
+            { "floor",      FoldOp::Floor,      1 },
+            { "ceil",       FoldOp::Ceil,       1 },
+            { "trunc",      FoldOp::Trunc,      1 },
+            { "saturate",   FoldOp::Saturate,   1 },
+            { "min",        FoldOp::Min,        2 },
+            { "max",        FoldOp::Max,        2 },
+            { "clamp",      FoldOp::Clamp,      3 },
+            { "dot",        FoldOp::Dot,        2 },
+        };
+        for( auto const& info : kIntrinsics )
+        {
+            if( name == UnownedStringSlice(info.name) && argCount == info.argCount )
+                return info.op;
+        }
+        return FoldOp::None;
+    }
+
+    // Get the name of the standard library function that `call` invokes,
+    // or an empty string if the callee is anything else.
+    //
+    static UnownedStringSlice getStdlibCalleeName(IRCall* call)
+    {
+        auto func = as<IRFunc>(getResolvedInstForDecorations(call->getCallee()));
+        if(!func || func->isDefinition())
+            return UnownedStringSlice();
+
+        // If the callee is generic, then the mangled name will have
+        // been set on the outer-most generic.
+        //
+        IRInst* valueForName = func;
+        for(;;)
+        {
+            auto parentBlock = as<IRBlock>(valueForName->getParent());
+            if(!parentBlock)
+                break;
+            auto parentGeneric = as<IRGeneric>(parentBlock->getParent());
+            if(!parentGeneric)
+                break;
+            valueForName = parentGeneric;
+        }
+
+        auto linkage = valueForName->findDecoration<IRLinkageDecoration>();
+        if(!linkage)
+            return UnownedStringSlice();
+
+        // We are looking for a mangled name of the form `_S4hlsl<N><name>...`,
+        // for a function declared directly in the `hlsl` standard library
+        // module (rather than a method, or a user function).
+        //
+        static const char kPrefix[] = "_S4hlsl";
+        auto mangledName = linkage->getMangledName();
+        if(!mangledName.startsWith(kPrefix))
+            return UnownedStringSlice();
+
+        char const* cursor = mangledName.begin() + sizeof(kPrefix) - 1;
+        char const* end = mangledName.end();
+        UInt length = 0;
+        while( cursor != end && *cursor >= '0' && *cursor <= '9' )
+        {
+            length = length*10 + (*cursor++ - '0');
+        }
+        if(length == 0 || length > UInt(end - cursor))
+            return UnownedStringSlice();
+
+        char const* nameEnd = cursor + length;
+        if(nameEnd != end && *nameEnd >= '0' && *nameEnd <= '9')
+            return UnownedStringSlice();
+        return UnownedStringSlice(cursor, nameEnd);
+    }
+
+    static FoldOp getFoldOpForCall(IRCall* call)
+    {
+        return getFoldOpForIntrinsic(getStdlibCalleeName(call), call->getArgCount());
+    }
+
+    static bool canFoldInst(IRInst* inst)
+    {
+        switch( inst->op )
+        {
+        case kIROp_Construct:
+        case kIROp_makeVector:
+        case kIROp_MakeMatrix:
+        case kIROp_constructVectorFromScalar:
+        case kIROp_swizzle:
+        case kIROp_getElement:
+            return true;
+
+        case kIROp_Call:
+            return getFoldOpForCall(cast<IRCall>(inst)) != FoldOp::None;
+
+        default:
+            return getFoldOp(inst->op) != FoldOp::None;
+        }
+    }
+
+    // Evaluate a scalar operation, or return false if the result
+    // isn't something we can (or should) compute at compile time.
+    //
+    static bool foldScalar(FoldOp op, ScalarKind kind, ScalarVal const* args, ScalarVal& outVal)
+    {
+        outVal.kind = kind;
+
+        if( kind == ScalarKind::Float )
+        {
+            float a = float(args[0].floatVal);
+            float b = float(args[1].floatVal);
+            float c = float(args[2].floatVal);
+            float result = 0;
+            switch( op )
+            {
+            case FoldOp::Add:       result = a + b; break;
+            case FoldOp::Sub:       result = a - b; break;
+            case FoldOp::Mul:       result = a * b; break;
+            case FoldOp::Neg:       result = -a; break;
+            case FoldOp::Abs:       result = std::fabs(a); break;
+            case FoldOp::Floor:     result = std::floor(a); break;
+            case FoldOp::Ceil:      result = std::ceil(a); break;
+            case FoldOp::Trunc:     result = std::trunc(a); break;
+
+            // The sign of a zero result from `min`/`max`/`saturate`
+            // isn't consistent across implementations.
+            case FoldOp::Saturate:
+                if(a == 0) return false;
+                result = a < 0 ? 0.0f : (a > 1 ? 1.0f : a);
+                break;
+            case FoldOp::Min:
+                if(a == 0 && b == 0) return false;
+                result = a < b ? a : b;
+                break;
+            case FoldOp::Max:
+                if(a == 0 && b == 0) return false;
+                result = a > b ? a : b;
+                break;
+            case FoldOp::Clamp:
+                if(a == 0 || b == 0 || c == 0) return false;
+                result = a < b ? b : (a > c ? c : a);
+                break;
+
+            default:
+                return false;
+            }
+            outVal.floatVal = result;
+            return true;
+        }
+        else if( kind == ScalarKind::Double )
+        {
+            double a = args[0].floatVal;
+            double b = args[1].floatVal;
+            double result = 0;
+            switch( op )
+            {
+            case FoldOp::Add:       result = a + b; break;
+            case FoldOp::Sub:       result = a - b; break;
+            case FoldOp::Mul:       result = a * b; break;
+            case FoldOp::Neg:       result = -a; break;
+            case FoldOp::Abs:       result = std::fabs(a); break;
+            default:
+                return false;
+            }
+            outVal.floatVal = result;
+            return true;
+        }
+        else if( kind == ScalarKind::Int || kind == ScalarKind::UInt )
+        {
+            // We perform the arithmetic on the unsigned representation,
+            // so that overflow wraps around as it does on the target.
+            //
+            bool isSigned = kind == ScalarKind::Int;
+            IRIntegerValue a = args[0].intVal;
+            IRIntegerValue b = args[1].intVal;
+            IRIntegerValue c = args[2].intVal;
+            uint32_t ua = uint32_t(a);
+            uint32_t ub = uint32_t(b);
+            IRIntegerValue result = 0;
+            switch( op )
+            {
+            case FoldOp::Add:       result = ua + ub; break;
+            case FoldOp::Sub:       result = ua - ub; break;
+            case FoldOp::Mul:       result = ua * ub; break;
+            case FoldOp::BitAnd:    result = ua & ub; break;
+            case FoldOp::BitOr:     result = ua | ub; break;
+            case FoldOp::BitXor:    result = ua ^ ub; break;
+            case FoldOp::BitNot:    result = ~ua; break;
+            case FoldOp::Neg:       result = 0u - ua; break;
+
+            // Division and remainder with a negative operand aren't
+            // consistently defined across our targets.
+            case FoldOp::Div:
+                if(b <= 0 || a < 0) return false;
+                result = a / b;
+                break;
+            case FoldOp::Mod:
+                if(b <= 0 || a < 0) return false;
+                result = a % b;
+                break;
+
+            case FoldOp::Lsh:
+                if(b < 0 || b >= 32) return false;
+                result = ua << b;
+                break;
+            case FoldOp::Rsh:
+                if(b < 0 || b >= 32) return false;
+                result = isSigned ? IRIntegerValue(int32_t(ua) >> b) : IRIntegerValue(ua >> b);
+                break;
+
+            case FoldOp::Abs:
+                if(!isSigned) return false;
+                if(a == INT32_MIN) return false;
+                result = a < 0 ? -a : a;
+                break;
+            case FoldOp::Min:       result = a < b ? a : b; break;
+            case FoldOp::Max:       result = a > b ? a : b; break;
+            case FoldOp::Clamp:     result = a < b ? b : (a > c ? c : a); break;
+
+            default:
+                return false;
+            }
+            outVal.intVal = wrapInt(kind, result);
+            return true;
+        }
+        else if( kind == ScalarKind::Bool )
+        {
+            bool a = args[0].intVal != 0;
+            bool b = args[1].intVal != 0;
+            bool result = false;
+            switch( op )
+            {
+            case FoldOp::And:
+            case FoldOp::BitAnd:    result = a && b; break;
+            case FoldOp::Or:
+            case FoldOp::BitOr:     result = a || b; break;
+            case FoldOp::BitXor:    result = a != b; break;
+            case FoldOp::Not:       result = !a; break;
+            default:
+                return false;
+            }
+            outVal.intVal = result;
+            return true;
+        }
+        return false;
+    }
+
+    // Evaluate a comparison between two scalars of kind `kind`.
+    //
+    static bool foldComparison(FoldOp op, ScalarKind kind, ScalarVal const* args, ScalarVal& outVal)
+    {
+        int order = 0;
+        if( isFloatingPointKind(kind) )
+        {
+            double a = args[0].floatVal;
+            double b = args[1].floatVal;
+            order = a < b ? -1 : (a > b ? 1 : 0);
+        }
+        else
+        {
+            IRIntegerValue a = args[0].intVal;
+            IRIntegerValue b = args[1].intVal;
+            order = a < b ? -1 : (a > b ? 1 : 0);
+        }
+
+        bool result = false;
+        switch( op )
+        {
+        case FoldOp::Eql:       result = order == 0; break;
+        case FoldOp::Neq:       result = order != 0; break;
+        case FoldOp::Less:      result = order < 0; break;
+        case FoldOp::Greater:   result = order > 0; break;
+        case FoldOp::Leq:       result = order <= 0; break;
+        case FoldOp::Geq:       result = order >= 0; break;
+        default:
+            return false;
+        }
+        outVal.kind = ScalarKind::Bool;
+        outVal.intVal = result;
+        return true;
+    }
+
+    static bool isComparison(FoldOp op)
+    {
+        switch( op )
+        {
+        case FoldOp::Eql:
+        case FoldOp::Neq:
+        case FoldOp::Less:
+        case FoldOp::Greater:
+        case FoldOp::Leq:
+        case FoldOp::Geq:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Apply an operation element-wise to the (constant) `args`, where
+    // scalar arguments are broadcast to the size of the result.
+    //
+    IRInst* foldElementwise(IRInst* inst, FoldOp op, UInt argCount, IRInst* const* args)
+    {
+        auto resultType = inst->getDataType();
+        UInt count = 0;
+        auto resultElementType = getScalarElementType(resultType, &count);
+        if(!resultElementType || as<IRMatrixType>(resultType))
+            return nullptr;
+        ScalarKind resultKind = getScalarKind(resultElementType);
+
+        // The operands of a comparison have their own type, while
+        // for other operations the operands have the type of the result.
+        //
+        ScalarKind operandKind = resultKind;
+        if( isComparison(op) )
+        {
+            UInt operandCount = 0;
+            auto operandElementType = getScalarElementType(args[0]->getDataType(), &operandCount);
+            if(!operandElementType)
+                return nullptr;
+            operandKind = getScalarKind(operandElementType);
+        }
+        if(operandKind == ScalarKind::Unsupported)
+            return nullptr;
+
+        List<ScalarVal> argComponents[3];
+        SLANG_ASSERT(argCount <= 3);
+        for( UInt aa = 0; aa < argCount; ++aa )
+        {
+            // The condition of a `select` is always Boolean.
+            //
+            ScalarKind argKind = (op == FoldOp::Select && aa == 0) ? ScalarKind::Bool : operandKind;
+            if(!getOperandComponents(args[aa], argKind, argComponents[aa]))
+                return nullptr;
+            UInt argComponentCount = argComponents[aa].Count();
+            if(argComponentCount != 1 && argComponentCount != count)
+                return nullptr;
+        }
+
+        List<ScalarVal> resultComponents;
+        for( UInt ii = 0; ii < count; ++ii )
+        {
+            ScalarVal elementArgs[3];
+            for( UInt aa = 0; aa < argCount; ++aa )
+            {
+                auto& components = argComponents[aa];
+                elementArgs[aa] = components[components.Count() == 1 ? 0 : ii];
+            }
+
+            ScalarVal result;
+            if( op == FoldOp::Select )
+            {
+                result = elementArgs[0].intVal ? elementArgs[1] : elementArgs[2];
+            }
+            else if( isComparison(op) )
+            {
+                if(!foldComparison(op, operandKind, elementArgs, result))
+                    return nullptr;
+            }
+            else
+            {
+                if(!foldScalar(op, resultKind, elementArgs, result))
+                    return nullptr;
+            }
+            resultComponents.Add(result);
+        }
+        return makeConstant(resultType, resultComponents);
+    }
+
+    // Evaluate an integer `dot`, which reduces vectors to a scalar.
+    //
+    IRInst* foldReduction(IRInst* inst, FoldOp op, IRInst* const* args)
+    {
+        SLANG_ASSERT(op == FoldOp::Dot);
+
+        auto resultType = inst->getDataType();
+        ScalarKind kind = getScalarKind(resultType);
+        if(kind != ScalarKind::Int && kind != ScalarKind::UInt)
+            return nullptr;
+
+        List<ScalarVal> left, right;
+        if(!getOperandComponents(args[0], kind, left))
+            return nullptr;
+        if(!getOperandComponents(args[1], kind, right))
+            return nullptr;
+        if(left.Count() != right.Count() || left.Count() == 0)
+            return nullptr;
+
+        ScalarVal sum;
+        for( UInt ii = 0; ii < left.Count(); ++ii )
+        {
+            ScalarVal productArgs[3] = { left[ii], right[ii], ScalarVal() };
+            ScalarVal product;
+            if(!foldScalar(FoldOp::Mul, kind, productArgs, product))
+                return nullptr;
+
+            if( ii == 0 )
+            {
+                sum = product;
+                continue;
+            }
+
+            ScalarVal sumArgs[3] = { sum, product, ScalarVal() };
+            if(!foldScalar(FoldOp::Add, kind, sumArgs, sum))
+                return nullptr;
+        }
+
+        List<ScalarVal> result;
+        result.Add(sum);
+        return makeConstant(resultType, result);
+    }
+
+    // Try to compute the constant value of `inst`, given that its
+    // operands have constant values, or return null if we can't.
+    //
+    IRInst* tryFoldInst(IRInst* inst)
+    {
+        auto type = inst->getDataType();
+        switch( inst->op )
+        {
+        case kIROp_Construct:
+        case kIROp_makeVector:
+        case kIROp_MakeMatrix:
+        case kIROp_constructVectorFromScalar:
+            {
+                // A constructor (or conversion) of a scalar or vector
+                // yields the components of its operands, converted to
+                // the element type of the result.
+                //
+                if(isLiteralConstructor(inst))
+                    return inst;
+
+                UInt count = 0;
+                auto elementType = getScalarElementType(type, &count);
+                if(!elementType || as<IRMatrixType>(type))
+                    return nullptr;
+
+                List<ScalarVal> components;
+                if(!getComponents(inst, getScalarKind(elementType), components))
+                    return nullptr;
+                return makeConstant(type, components);
+            }
+
+        case kIROp_swizzle:
+            {
+                auto swizzle = cast<IRSwizzle>(inst);
+                UInt baseCount = 0;
+                auto baseElementType = getScalarElementType(swizzle->getBase()->getDataType(), &baseCount);
+                if(!baseElementType)
+                    return nullptr;
+
+                List<ScalarVal> baseComponents;
+                if(!getOperandComponents(swizzle->getBase(), getScalarKind(baseElementType), baseComponents))
+                    return nullptr;
+
+                List<ScalarVal> components;
+                for( UInt ii = 0; ii < swizzle->getElementCount(); ++ii )
+                {
+                    auto index = as<IRIntLit>(swizzle->getElementIndex(ii));
+                    if(!index || index->getValue() < 0 || UInt(index->getValue()) >= baseComponents.Count())
+                        return nullptr;
+                    components.Add(baseComponents[UInt(index->getValue())]);
+                }
+                return makeConstant(type, components);
+            }
+
+        case kIROp_getElement:
+            {
+                // Extracting an element from a vector yields a scalar,
+                // and extracting one from a matrix yields a row.
+                //
+                auto base = inst->getOperand(0);
+                auto index = as<IRIntLit>(getConstantOperand(inst->getOperand(1)));
+                if(!index)
+                    return nullptr;
+
+                UInt baseCount = 0;
+                auto baseElementType = getScalarElementType(base->getDataType(), &baseCount);
+                if(!baseElementType || as<IRBasicType>(base->getDataType()))
+                    return nullptr;
+
+                List<ScalarVal> baseComponents;
+                if(!getOperandComponents(base, getScalarKind(baseElementType), baseComponents))
+                    return nullptr;
+
+                UInt count = 0;
+                if(!getScalarElementType(type, &count))
+                    return nullptr;
+
+                IRIntegerValue start = index->getValue() * IRIntegerValue(count);
+                if(index->getValue() < 0 || UInt(start + count) > baseComponents.Count())
+                    return nullptr;
+
+                List<ScalarVal> components;
+                for( UInt ii = 0; ii < count; ++ii )
+                    components.Add(baseComponents[UInt(start) + ii]);
+                return makeConstant(type, components);
+            }
+
+        case kIROp_Select:
+            {
+                // If the condition is a single Boolean, then the result
+                // is just one of the other operands, which need not be
+                // constant itself.
+                //
+                auto condition = as<IRBoolLit>(getConstantOperand(inst->getOperand(0)));
+                if( condition )
+                {
+                    auto chosen = getConstantOperand(inst->getOperand(condition->getValue() ? 1 : 2));
+                    if(!chosen)
+                        return nullptr;
+                    return chosen;
+                }
+
+                for( UInt ii = 1; ii < 3; ++ii )
+                {
+                    if(!getConstantOperand(inst->getOperand(ii)))
+                        return nullptr;
+                }
+
+                IRInst* args[] = { inst->getOperand(0), inst->getOperand(1), inst->getOperand(2) };
+                return foldElementwise(inst, FoldOp::Select, 3, args);
+            }
+
+        case kIROp_Call:
+            {
+                auto call = cast<IRCall>(inst);
+                FoldOp op = getFoldOpForCall(call);
+                UInt argCount = call->getArgCount();
+                List<IRInst*> args;
+                for( UInt ii = 0; ii < argCount; ++ii )
+                    args.Add(call->getArg(ii));
+
+                switch( op )
+                {
+                case FoldOp::Dot:
+                    return foldReduction(inst, op, args.Buffer());
+                default:
+                    return foldElementwise(inst, op, argCount, args.Buffer());
+                }
+            }
+
+        default:
+            {
+                FoldOp op = getFoldOp(inst->op);
+                UInt operandCount = inst->getOperandCount();
+                if(operandCount > 3)
+                    return nullptr;
+
+                IRInst* args[3] = {};
+                for( UInt ii = 0; ii < operandCount; ++ii )
+                    args[ii] = inst->getOperand(ii);
+                return foldElementwise(inst, op, operandCount, args);
+            }
+        }
+    }
+
+    // When we replace an instruction with its constant value,
+    // a vector constant created during folding needs to be
+    // inserted into the function.
+    //
+    IRInst* materializeConstant(IRInst* constant, IRInst* inst)
+    {
+        // Literals live at the global scope, and can be used directly.
+        //
+        if(as<IRConstant>(constant))
+            return constant;
+
+        // Other values that are already part of the function (e.g., the
+        // constant operand of a `select`) aren't guaranteed to be
+        // visible at `inst`, so we leave those alone.
+        //
+        if(constant->getParent())
+            return nullptr;
+
+        auto builder = getBuilder();
+        if( as<IRParam>(inst) )
+        {
+            auto block = cast<IRBlock>(inst->getParent());
+            builder->setInsertBefore(block->getFirstOrdinaryInst());
+        }
+        else
+        {
+            builder->setInsertBefore(inst);
+        }
+
+        // A vector with all elements equal is emitted as a conversion
+        // from a scalar, which is how such vectors are usually written.
+        //
+        UInt operandCount = constant->getOperandCount();
+        bool isSplat = true;
+        List<IRInst*> operands;
+        for( UInt ii = 0; ii < operandCount; ++ii )
+        {
+            operands.Add(constant->getOperand(ii));
+            isSplat = isSplat && operands[ii] == operands[0];
+        }
+
+        IRInst* copy = nullptr;
+        if( isSplat )
+            copy = builder->emitIntrinsicInst(constant->getDataType(), kIROp_constructVectorFromScalar, 1, operands.Buffer());
+        else
+            copy = builder->emitMakeVector(constant->getDataType(), operands);
+        copy->sourceLoc = inst->sourceLoc;
+        builder->setInsertInto(nullptr);
+        return copy;
+    }
 
     // For basic blocks, we will do tracking very similar to what we do for
     // ordinary instructions, just with a simpler lattice: every block
@@ -306,7 +1405,7 @@ struct SCCPContext
     // state. We track this as a set of the blocks that have been
     // marked as possibly executed, plus a getter and setter function.
 
-    HashSet<IRBlock*> executedBlocks;
+    IRInstSet executedBlocks;
 
     bool isMarkedAsExecuted(IRBlock* block)
     {
@@ -575,6 +1674,11 @@ struct SCCPContext
         //
         builderStorage.sharedBuilder = &shared->sharedBuilder;
 
+        // Every instruction we will track state for is in the
+        // function, so we number them all up front.
+        //
+        instNumbering.addRec(code);
+
         // We expect the caller to have filtered out functions with
         // no bodies, so there should always be at least one basic block.
         //
@@ -720,13 +1824,25 @@ struct SCCPContext
                 if(constantVal == inst)
                     continue;
 
+                // A constant vector that we computed during folding
+                // needs a copy of it to be inserted into the function
+                // before we can use it.
+                //
+                constantVal = materializeConstant(constantVal, inst);
+                if(!constantVal)
+                    continue;
+
                 // We replace any uses of the instruction with its
                 // constant expected value, and add it to a list of
                 // instructions to be removed *iff* the instruction
                 // is known to have no obersvable side effects.
                 //
+                // Calls to the standard library functions we fold
+                // (e.g., `sqrt`) are conservatively treated as having
+                // side effects, but we know that they are pure.
+                //
                 inst->replaceUsesWith(constantVal);
-                if( !inst->mightHaveSideEffects() )
+                if( !inst->mightHaveSideEffects() || as<IRCall>(inst) )
                 {
                     instsToRemove.Add(inst);
                 }
@@ -911,6 +2027,18 @@ struct SCCPContext
                 builder->emitUnreachable();
             }
         }
+
+        // The vectors we computed while folding were never inserted
+        // into the function (only copies of them were), so they can
+        // all be freed now that we are done with our lattice values.
+        //
+        for( auto pair : mapKeyToVectorConstant )
+        {
+            auto vector = pair.Value;
+            SLANG_ASSERT(!vector->hasUses());
+            vector->removeAndDeallocate();
+        }
+        mapKeyToVectorConstant.Clear();
     }
 };
 
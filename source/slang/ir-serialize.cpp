@@ -3,6 +3,7 @@
 
 #include "../core/text-io.h"
 #include "../core/slang-byte-encode-util.h"
+#include "../core/slang-lz-compress-util.h"
 
 #include "ir-insts.h"
 
@@ -273,6 +274,36 @@ char* StringRepresentationCache::getCStr(Handle handle)
     }
 }
 
+/* static */void SerialStringTableUtil::calcStringOffsets(const List<char>& stringTable, List<uint32_t>& offsetsOut)
+{
+    // The default handles don't have an entry in the table
+    offsetsOut.SetSize(StringSlicePool::kNumDefaultHandles);
+    for (int i = 0; i < StringSlicePool::kNumDefaultHandles; ++i)
+    {
+        offsetsOut[i] = 0;
+    }
+
+    const char* start = stringTable.begin();
+    const char* cur = start;
+    const char* end = stringTable.end();
+
+    while (cur < end)
+    {
+        offsetsOut.Add(uint32_t(cur - start));
+
+        CharReader reader(cur);
+        const int len = GetUnicodePointFromUTF8(reader);
+        cur = reader.m_pos + len;
+    }
+}
+
+/* static */UnownedStringSlice SerialStringTableUtil::decodeString(const char* stringTable, uint32_t offset)
+{
+    CharReader reader(stringTable + offset);
+    const int len = GetUnicodePointFromUTF8(reader);
+    return UnownedStringSlice(reader.m_pos, len);
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialData !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 template<typename T>
@@ -290,6 +321,7 @@ size_t IRSerialData::calcSizeInBytes() const
         _calcArraySize(m_stringTable) +
         /* Raw source locs */
         _calcArraySize(m_rawSourceLocs) +
+        _calcArraySize(m_globalSymbols) +
         /* Debug */
         _calcArraySize(m_debugStringTable) +
         _calcArraySize(m_debugLineInfos) +
@@ -312,6 +344,7 @@ void IRSerialData::clear()
     m_childRuns.Clear();
     m_externalOperands.Clear();
     m_rawSourceLocs.Clear();
+    m_globalSymbols.Clear();
 
     m_stringTable.Clear();
     
@@ -359,6 +392,7 @@ bool IRSerialData::operator==(const ThisType& rhs) const
         _isEqual(m_childRuns, rhs.m_childRuns) &&
         _isEqual(m_externalOperands, rhs.m_externalOperands) &&
         _isEqual(m_rawSourceLocs, rhs.m_rawSourceLocs) &&
+        _isEqual(m_globalSymbols, rhs.m_globalSymbols) &&
         _isEqual(m_stringTable, rhs.m_stringTable) &&
         /* Debug */
         _isEqual(m_debugStringTable, rhs.m_debugStringTable) &&
@@ -370,6 +404,14 @@ bool IRSerialData::operator==(const ThisType& rhs) const
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
+static int _compareStringSlices(const UnownedStringSlice& a, const UnownedStringSlice& b)
+{
+    const size_t aSize = a.size();
+    const size_t bSize = b.size();
+    const int compare = (aSize && bSize) ? memcmp(a.begin(), b.begin(), Math::Min(aSize, bSize)) : 0;
+    return compare ? compare : ((aSize < bSize) ? -1 : int(aSize > bSize));
+}
+
 void IRSerialWriter::_addInstruction(IRInst* inst)
 {
     // It cannot already be in the map
@@ -637,6 +679,9 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
         }
     }
 
+    // Put the runs in parent order, so the children of an instruction can be found with a binary search
+    m_serialData->m_childRuns.Sort([](const Ser::InstRun& a, const Ser::InstRun& b) { return a.m_parentIndex < b.m_parentIndex; });
+
 #if 0
     {
         List<IRInst*> workInsts;
@@ -762,6 +807,31 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
         }
     }
 
+    // Add the global values with linkage to the symbol index, so that they can be found without reading the whole module
+    {
+        List<Ser::GlobalSymbol>& globalSymbols = serialData->m_globalSymbols;
+        for (IRInst* globalInst : moduleInst->getChildren())
+        {
+            auto linkage = globalInst->findDecoration<IRLinkageDecoration>();
+            if (!linkage)
+            {
+                continue;
+            }
+
+            Ser::GlobalSymbol symbol;
+            symbol.m_mangledNameIndex = getStringIndex(linkage->getMangledName());
+            symbol.m_instIndex = getInstIndex(globalInst);
+            globalSymbols.Add(symbol);
+        }
+
+        // Order by name. Symbols with the same name stay in module order.
+        globalSymbols.Sort([&](const Ser::GlobalSymbol& a, const Ser::GlobalSymbol& b) -> bool
+        {
+            const int compare = _compareStringSlices(getStringSlice(a.m_mangledNameIndex), getStringSlice(b.m_mangledNameIndex));
+            return compare < 0 || (compare == 0 && a.m_instIndex < b.m_instIndex);
+        });
+    }
+
     // Convert strings into a string table
     {
         SerialStringTableUtil::encodeStringTable(m_stringSlicePool, serialData->m_stringTable);
@@ -792,36 +862,26 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
     return SLANG_OK;
 }
 
-template <typename T>
-static size_t _calcChunkSize(IRSerialBinary::CompressionType compressionType, const List<T>& array)
+static void _writeAlignmentPadChunk(size_t headerSize, Stream* stream)
 {
     typedef IRSerialBinary Bin;
 
-    if (array.Count())
-    {
-        switch (compressionType)
-        {
-            case Bin::CompressionType::None:
-            {
-                const size_t size = sizeof(Bin::ArrayHeader) + sizeof(T) * array.Count();
-                return (size + 3) & ~size_t(3);
-            }
-            case Bin::CompressionType::VariableByteLite:
-            {
-                const size_t payloadSize = ByteEncodeUtil::calcEncodeLiteSizeUInt32((const uint32_t*)array.begin(), (array.Count() * sizeof(T)) / sizeof(uint32_t));
-                const size_t size = sizeof(Bin::CompressedArrayHeader) + payloadSize;
-                return (size + 3) & ~size_t(3);
-            }
-            default:
-            {
-                SLANG_ASSERT(!"Unhandled compression type");
-                return 0;
-            }
-        }
-    }
-    else
+    // If the payload that follows a header of headerSize would not be aligned, write a chunk that just moves it along
+    const size_t alignMask = Bin::kArrayAlignment - 1;
+    const size_t payloadOffset = size_t(stream->GetPosition()) + headerSize;
+    if (payloadOffset & alignMask)
     {
-        return 0;
+        const size_t padSize = Bin::kArrayAlignment - (payloadOffset & alignMask);
+        // All chunks are a multiple of 4 bytes in size
+        SLANG_ASSERT((padSize & 3) == 0);
+
+        Bin::Chunk padChunk;
+        padChunk.m_type = Bin::kPadFourCc;
+        padChunk.m_size = uint32_t(padSize);
+        stream->Write(&padChunk, sizeof(padChunk));
+
+        const uint8_t pad[Bin::kArrayAlignment] = { 0 };
+        stream->Write(pad, padSize);
     }
 }
 
@@ -840,6 +900,9 @@ static Result _writeArrayChunk(IRSerialBinary::CompressionType compressionType,
     {
         case Bin::CompressionType::None:
         {
+            // Uncompressed arrays are aligned, so they can be used in place (see IRSerialReader::mapData)
+            _writeAlignmentPadChunk(sizeof(Bin::ArrayHeader), stream);
+
             payloadSize = sizeof(Bin::ArrayHeader) - sizeof(Bin::Chunk) + typeSize * numEntries;
 
             Bin::ArrayHeader header;
@@ -873,6 +936,26 @@ static Result _writeArrayChunk(IRSerialBinary::CompressionType compressionType,
             stream->Write(compressedPayload.begin(), compressedPayload.Count());
             break;
         }
+        case Bin::CompressionType::LZ:
+        {
+            const size_t dataSize = numEntries * typeSize;
+
+            List<uint8_t> compressedPayload;
+            LZCompressUtil::compress(data, dataSize, compressedPayload);
+
+            payloadSize = sizeof(Bin::CompressedArrayHeader) - sizeof(Bin::Chunk) + compressedPayload.Count();
+
+            Bin::CompressedArrayHeader header;
+            header.m_chunk.m_type = SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId);
+            header.m_chunk.m_size = uint32_t(payloadSize);
+            header.m_numEntries = uint32_t(numEntries);
+            header.m_numCompressedEntries = uint32_t(dataSize);
+
+            stream->Write(&header, sizeof(header));
+
+            stream->Write(compressedPayload.begin(), compressedPayload.Count());
+            break;
+        }
         default:
         {
             return SLANG_FAIL;
@@ -997,6 +1080,7 @@ Result _writeInstArrayChunk(IRSerialBinary::CompressionType compressionType, uin
     switch (compressionType)
     {
         case Bin::CompressionType::None:
+        case Bin::CompressionType::LZ:
         {
             return _writeArrayChunk(compressionType, chunkId, array, stream);
         }
@@ -1031,129 +1115,59 @@ Result _writeInstArrayChunk(IRSerialBinary::CompressionType compressionType, uin
     return SLANG_FAIL;
 }
 
-static size_t _calcInstChunkSize(IRSerialBinary::CompressionType compressionType, const List<IRSerialData::Inst>& instsIn)
+/* static */Result IRSerialWriter::writeStream(const IRSerialData& data, Bin::CompressionType compressionType, Stream* stream)
 {
-    typedef IRSerialBinary Bin;
-    typedef IRSerialData::Inst::PayloadType PayloadType;
+    // The chunks are written to memory first, because the RIFF header holds the total size, and
+    // the padding needed to align the arrays depends on where they end up.
+    // As the RIFF header is a multiple of the alignment, a position in the body is aligned if
+    // the same position in the RIFF is.
+    SLANG_COMPILE_TIME_ASSERT(sizeof(Bin::Chunk) % Bin::kArrayAlignment == 0);
 
-    switch (compressionType)
+    MemoryStream body(FileAccess::Write);
     {
-        case Bin::CompressionType::None:
-        {
-            return _calcChunkSize(compressionType, instsIn);
-        }
-        case Bin::CompressionType::VariableByteLite:
-        {
-            size_t size = sizeof(Bin::CompressedArrayHeader);
-
-            size_t numInsts = size_t(instsIn.Count());
-            size += numInsts * 2;           // op and payload
-
-            IRSerialData::Inst* insts = instsIn.begin();
+        Bin::SlangHeader slangHeader;
+        slangHeader.m_chunk.m_type = Bin::kSlangFourCc;
+        slangHeader.m_chunk.m_size = uint32_t(sizeof(slangHeader) - sizeof(Bin::Chunk));
+        slangHeader.m_compressionType = uint32_t(compressionType);
 
-            for (size_t i = 0; i < numInsts; ++i)
-            {
-                const auto& inst = insts[i];
+        body.Write(&slangHeader, sizeof(slangHeader));
+    }
 
-                size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_resultTypeIndex);
+    // VariableByteLite can only compress arrays of uint32_t, whereas LZ can compress any array
+    const Bin::CompressionType byteCompressionType = (compressionType == Bin::CompressionType::LZ) ? compressionType : Bin::CompressionType::None;
 
-                switch (inst.m_payloadType)
-                {
-                    case PayloadType::Empty:    
-                    {
-                        break;
-                    }
-                    case PayloadType::Operand_1:
-                    case PayloadType::String_1:
-                    case PayloadType::UInt32:
-                    {
-                        // 1 UInt32
-                        size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_payload.m_operands[0]);
-                        break;
-                    }
-                    case PayloadType::Operand_2:
-                    case PayloadType::OperandAndUInt32:
-                    case PayloadType::OperandExternal:
-                    case PayloadType::String_2:
-                    {
-                        // 2 UInt32
-                        size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_payload.m_operands[0]);
-                        size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_payload.m_operands[1]);
-                        break;
-                    }
-                    case PayloadType::Float64:
-                    {
-                        size += sizeof(inst.m_payload.m_float64);
-                        break;
-                    }
-                    case PayloadType::Int64:
-                    {
-                        size += sizeof(inst.m_payload.m_int64);
-                        break;
-                    }
-                }
-            }
+    SLANG_RETURN_ON_FAIL(_writeInstArrayChunk(compressionType, Bin::kInstFourCc, data.m_insts, &body));
+    SLANG_RETURN_ON_FAIL(_writeArrayChunk(compressionType, Bin::kChildRunFourCc, data.m_childRuns, &body));
+    SLANG_RETURN_ON_FAIL(_writeArrayChunk(compressionType, Bin::kExternalOperandsFourCc, data.m_externalOperands, &body));
+    SLANG_RETURN_ON_FAIL(_writeArrayChunk(byteCompressionType, Bin::kStringFourCc, data.m_stringTable, &body));
 
-            return (size + 3) & ~size_t(3);
-        }
-        default: break;
+    // The offsets of the strings are only needed to look strings up in place, so they are not part of IRSerialData
+    {
+        List<uint32_t> stringOffsets;
+        SerialStringTableUtil::calcStringOffsets(data.m_stringTable, stringOffsets);
+        SLANG_RETURN_ON_FAIL(_writeArrayChunk(Bin::CompressionType::None, Bin::kStringOffsetFourCc, stringOffsets, &body));
     }
 
-    SLANG_ASSERT(!"Unhandled compression type");
-    return 0;
-}
-
-/* static */Result IRSerialWriter::writeStream(const IRSerialData& data, Bin::CompressionType compressionType, Stream* stream)
-{
-    size_t totalSize = 0;
-    
-    totalSize += sizeof(Bin::SlangHeader) +
-        _calcInstChunkSize(compressionType, data.m_insts) +
-        _calcChunkSize(compressionType, data.m_childRuns) +
-        _calcChunkSize(compressionType, data.m_externalOperands) +
-        _calcChunkSize(Bin::CompressionType::None, data.m_stringTable) +
-        _calcChunkSize(Bin::CompressionType::None, data.m_rawSourceLocs);
+    SLANG_RETURN_ON_FAIL(_writeArrayChunk(byteCompressionType, Bin::kUInt32SourceLocFourCc, data.m_rawSourceLocs, &body));
+    SLANG_RETURN_ON_FAIL(_writeArrayChunk(compressionType, Bin::kGlobalSymbolFourCc, data.m_globalSymbols, &body));
 
     if (data.m_debugSourceInfos.Count())
     {
-        totalSize += _calcChunkSize(Bin::CompressionType::None, data.m_debugStringTable) +
-            _calcChunkSize(Bin::CompressionType::None, data.m_debugLineInfos) +
-            _calcChunkSize(Bin::CompressionType::None, data.m_debugAdjustedLineInfos) +
-            _calcChunkSize(Bin::CompressionType::None, data.m_debugSourceInfos) +
-            _calcChunkSize(compressionType, data.m_debugSourceLocRuns);
+        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugStringFourCc, data.m_debugStringTable, &body);
+        _writeArrayChunk(byteCompressionType, Bin::kDebugLineInfoFourCc, data.m_debugLineInfos, &body);
+        _writeArrayChunk(byteCompressionType, Bin::kDebugAdjustedLineInfoFourCc, data.m_debugAdjustedLineInfos, &body);
+        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugSourceInfoFourCc, data.m_debugSourceInfos, &body);
+        _writeArrayChunk(compressionType, Bin::kDebugSourceLocRunFourCc, data.m_debugSourceLocRuns, &body);
     }
 
     {
         Bin::Chunk riffHeader;
         riffHeader.m_type = Bin::kRiffFourCc;
-        riffHeader.m_size = uint32_t(totalSize);
+        riffHeader.m_size = uint32_t(body.m_contents.Count());
         
         stream->Write(&riffHeader, sizeof(riffHeader));
     }
-    {
-        Bin::SlangHeader slangHeader;
-        slangHeader.m_chunk.m_type = Bin::kSlangFourCc;
-        slangHeader.m_chunk.m_size = uint32_t(sizeof(slangHeader) - sizeof(Bin::Chunk));
-        slangHeader.m_compressionType = uint32_t(Bin::CompressionType::VariableByteLite);
-
-        stream->Write(&slangHeader, sizeof(slangHeader));
-    }
-
-    SLANG_RETURN_ON_FAIL(_writeInstArrayChunk(compressionType, Bin::kInstFourCc, data.m_insts, stream));
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(compressionType, Bin::kChildRunFourCc, data.m_childRuns, stream));
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(compressionType, Bin::kExternalOperandsFourCc, data.m_externalOperands, stream));
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(Bin::CompressionType::None, Bin::kStringFourCc, data.m_stringTable, stream));
-
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(Bin::CompressionType::None, Bin::kUInt32SourceLocFourCc, data.m_rawSourceLocs, stream));
-
-    if (data.m_debugSourceInfos.Count())
-    {
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugStringFourCc, data.m_debugStringTable, stream);
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugLineInfoFourCc, data.m_debugLineInfos, stream);
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugAdjustedLineInfoFourCc, data.m_debugAdjustedLineInfos, stream);
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugSourceInfoFourCc, data.m_debugSourceInfos, stream);
-        _writeArrayChunk(compressionType, Bin::kDebugSourceLocRunFourCc, data.m_debugSourceLocRuns, stream);
-    }
+    stream->Write(body.m_contents.begin(), body.m_contents.Count());
 
     return SLANG_OK;
 }
@@ -1226,6 +1240,31 @@ static Result _readArrayChunk(IRSerialBinary::CompressionType compressionType, c
             ByteEncodeUtil::decodeLiteUInt32(compressedPayload.begin(), header.m_numCompressedEntries, (uint32_t*)data);
             break;
         }
+        case Bin::CompressionType::LZ:
+        {
+            Bin::CompressedArrayHeader header;
+            header.m_chunk = chunk;
+
+            stream->Read(&header.m_chunk + 1, sizeof(header) - sizeof(Bin::Chunk));
+            *numReadInOut += sizeof(header) - sizeof(Bin::Chunk);
+
+            const size_t payloadSize = header.m_chunk.m_size - (sizeof(header) - sizeof(Bin::Chunk));
+
+            List<uint8_t> compressedPayload;
+            compressedPayload.SetSize(payloadSize);
+
+            stream->Read(compressedPayload.begin(), payloadSize);
+            *numReadInOut += payloadSize;
+
+            if (header.m_numCompressedEntries != header.m_numEntries * typeSize)
+            {
+                return SLANG_FAIL;
+            }
+
+            void* data = listOut.setSize(header.m_numEntries);
+            SLANG_RETURN_ON_FAIL(LZCompressUtil::decompress(compressedPayload.begin(), payloadSize, data, header.m_numCompressedEntries));
+            break;
+        }
         case Bin::CompressionType::None:
         {
             // Read uncompressed
@@ -1364,6 +1403,7 @@ Result _readInstArrayChunk(const IRSerialBinary::SlangHeader& slangHeader, const
     switch (compressionType)
     {
         case Bin::CompressionType::None:
+        case Bin::CompressionType::LZ:
         {
             ListResizerForType<IRSerialData::Inst> resizer(arrayOut);
             return _readArrayChunk(compressionType, chunk, stream, numReadInOut, resizer);
@@ -1496,15 +1536,24 @@ int64_t _calcChunkTotalSize(const IRSerialBinary::Chunk& chunk)
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kStringFourCc):
             case Bin::kStringFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_stringTable));
+                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_stringTable));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kUInt32SourceLocFourCc):
             case Bin::kUInt32SourceLocFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_rawSourceLocs));
+                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_rawSourceLocs));
+                remainingBytes -= _calcChunkTotalSize(chunk);
+                break;
+            }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kGlobalSymbolFourCc):
+            case Bin::kGlobalSymbolFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_globalSymbols));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
@@ -1514,15 +1563,17 @@ int64_t _calcChunkTotalSize(const IRSerialBinary::Chunk& chunk)
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugLineInfoFourCc):
             case Bin::kDebugLineInfoFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugLineInfos));
+                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugLineInfos));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugAdjustedLineInfoFourCc):
             case Bin::kDebugAdjustedLineInfoFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugAdjustedLineInfos));
+                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugAdjustedLineInfos));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
@@ -1551,6 +1602,110 @@ int64_t _calcChunkTotalSize(const IRSerialBinary::Chunk& chunk)
     return SLANG_OK;
 }
 
+template <typename T>
+static Result _mapArrayChunk(const IRSerialBinary::Chunk* chunk, IRSerialMappedData::Array<T>& arrayOut)
+{
+    typedef IRSerialBinary Bin;
+
+    const size_t headerPayloadSize = sizeof(Bin::ArrayHeader) - sizeof(Bin::Chunk);
+    if (chunk->m_size < headerPayloadSize)
+    {
+        return SLANG_FAIL;
+    }
+
+    const Bin::ArrayHeader* header = reinterpret_cast<const Bin::ArrayHeader*>(chunk);
+    if (uint64_t(header->m_numEntries) * sizeof(T) > chunk->m_size - headerPayloadSize)
+    {
+        return SLANG_FAIL;
+    }
+
+    // The writer aligns arrays relative to the start of the data, so this only fails if the data itself isn't aligned
+    const T* entries = reinterpret_cast<const T*>(header + 1);
+    if (size_t(entries) & (SLANG_ALIGN_OF(T) - 1))
+    {
+        return SLANG_FAIL;
+    }
+
+    arrayOut.m_data = entries;
+    arrayOut.m_count = header->m_numEntries;
+    return SLANG_OK;
+}
+
+/* static */Result IRSerialReader::mapData(const void* data, size_t size, IRSerialMappedData* dataOut)
+{
+    typedef IRSerialBinary Bin;
+
+    *dataOut = IRSerialMappedData();
+
+    if ((size_t(data) & (Bin::kArrayAlignment - 1)) || size < sizeof(Bin::Chunk))
+    {
+        return SLANG_FAIL;
+    }
+
+    const uint8_t* start = (const uint8_t*)data;
+    const Bin::Chunk* riffHeader = (const Bin::Chunk*)start;
+    if (riffHeader->m_type != Bin::kRiffFourCc || riffHeader->m_size > size - sizeof(Bin::Chunk))
+    {
+        return SLANG_FAIL;
+    }
+
+    const uint8_t* cur = start + sizeof(Bin::Chunk);
+    const uint8_t* end = cur + riffHeader->m_size;
+
+    while (cur < end)
+    {
+        const Bin::Chunk* chunk = (const Bin::Chunk*)cur;
+        if (size_t(end - cur) < sizeof(Bin::Chunk) || _calcChunkTotalSize(*chunk) > int64_t(end - cur))
+        {
+            return SLANG_FAIL;
+        }
+
+        switch (chunk->m_type)
+        {
+            case Bin::kInstFourCc:              SLANG_RETURN_ON_FAIL(_mapArrayChunk(chunk, dataOut->m_insts)); break;
+            case Bin::kChildRunFourCc:          SLANG_RETURN_ON_FAIL(_mapArrayChunk(chunk, dataOut->m_childRuns)); break;
+            case Bin::kExternalOperandsFourCc:  SLANG_RETURN_ON_FAIL(_mapArrayChunk(chunk, dataOut->m_externalOperands)); break;
+            case Bin::kStringFourCc:            SLANG_RETURN_ON_FAIL(_mapArrayChunk(chunk, dataOut->m_stringTable)); break;
+            case Bin::kStringOffsetFourCc:      SLANG_RETURN_ON_FAIL(_mapArrayChunk(chunk, dataOut->m_stringOffsets)); break;
+            case Bin::kUInt32SourceLocFourCc:   SLANG_RETURN_ON_FAIL(_mapArrayChunk(chunk, dataOut->m_rawSourceLocs)); break;
+            case Bin::kGlobalSymbolFourCc:      SLANG_RETURN_ON_FAIL(_mapArrayChunk(chunk, dataOut->m_globalSymbols)); break;
+
+            case Bin::kCompressedInstFourCc:
+            case Bin::kCompressedChildRunFourCc:
+            case Bin::kCompressedExternalOperandsFourCc:
+            case Bin::kCompressedGlobalSymbolFourCc:
+            case Bin::kCompressedStringFourCc:
+            case Bin::kCompressedUInt32SourceLocFourCc:
+            {
+                // Compressed arrays can't be used in place
+                return SLANG_FAIL;
+            }
+            default: break;
+        }
+
+        cur += _calcChunkTotalSize(*chunk);
+    }
+
+    // Must at least have the null instruction, and the module
+    if (dataOut->m_insts.getCount() < 2 ||
+        (dataOut->m_stringTable.getCount() && dataOut->m_stringOffsets.getCount() == 0))
+    {
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+UnownedStringSlice IRSerialMappedData::getStringSlice(Ser::StringIndex index) const
+{
+    switch (index)
+    {
+        case Ser::kNullStringIndex:     return UnownedStringSlice(nullptr, size_t(0));
+        case Ser::kEmptyStringIndex:    return UnownedStringSlice("", size_t(0));
+        default: break;
+    }
+    return SerialStringTableUtil::decodeString(m_stringTable.begin(), m_stringOffsets[UInt(index)]);
+}
+
 static SourceRange _toSourceRange(const IRSerialData::DebugSourceInfo& info)
 {
     SourceRange range;
@@ -1579,6 +1734,99 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
     return int(sourceView->getRange().begin.getRaw()) - int(info.m_startSourceLoc);
 }
 
+/// Create an instruction (without its type, operands or children) from srcInst.
+/// stringPayload is the string held by the instruction, if it has one.
+static IRInst* _createInst(IRModule* module, const IRSerialData::Inst& srcInst, const UnownedStringSlice& stringPayload)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    const IROp op((IROp)srcInst.m_op);
+
+    if (isConstant(op))
+    {
+        // Handling of constants
+
+        // Calculate the minimum object size (ie not including the payload of value)    
+        const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+        IRConstant* irConst = nullptr;
+        switch (op)
+        {                    
+            case kIROp_BoolLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
+                break;
+            }
+            case kIROp_IntLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_PtrLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*)));
+                irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op,  prefixSize + sizeof(IRFloatingPointValue)));
+                irConst->value.floatVal = srcInst.m_payload.m_float64;
+                break;
+            }
+            case kIROp_StringLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+
+                const UnownedStringSlice slice = stringPayload;
+                    
+                const size_t sliceSize = slice.size();
+                const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize));
+
+                IRConstant::StringValue& dstString = irConst->value.stringVal;
+
+                dstString.numChars = uint32_t(sliceSize);
+                // Turn into pointer to avoid warning of array overrun
+                char* dstChars = dstString.chars;
+                // Copy the chars
+                memcpy(dstChars, slice.begin(), sliceSize);
+                break;
+            }
+            default:
+            {
+                SLANG_ASSERT(!"Unknown constant type");
+                return nullptr;
+            }
+        }
+
+        return irConst;
+    }
+    else if (isTextureTypeBase(op))
+    {
+        IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1));
+        SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
+
+        // Reintroduce the texture type bits into the the
+        const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
+        inst->op = IROp(uint32_t(inst->op) | (other << kIROpMeta_OtherShift));
+
+        return inst;
+    }
+    else
+    {
+        int numOperands = srcInst.getNumOperands();
+        return createEmptyInst(module, op, numOperands);
+    }
+}
+
 /* static */Result IRSerialReader::read(const IRSerialData& data, Session* session, SourceManager* sourceManager, RefPtr<IRModule>& moduleOut)
 {
     typedef Ser::Inst::PayloadType PayloadType;
@@ -1626,90 +1874,16 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
     {
         const Ser::Inst& srcInst = data.m_insts[i];
 
-        const IROp op((IROp)srcInst.m_op);
-
-        if (isConstant(op))
+        UnownedStringSlice stringPayload;
+        if (srcInst.m_payloadType == PayloadType::String_1)
         {
-            // Handling of constants
-
-            // Calculate the minimum object size (ie not including the payload of value)    
-            const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
-
-            IRConstant* irConst = nullptr;
-            switch (op)
-            {                    
-                case kIROp_BoolLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
-                    break;
-                }
-                case kIROp_IntLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_PtrLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*)));
-                    irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_FloatLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op,  prefixSize + sizeof(IRFloatingPointValue)));
-                    irConst->value.floatVal = srcInst.m_payload.m_float64;
-                    break;
-                }
-                case kIROp_StringLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
-
-                    const UnownedStringSlice slice = m_stringRepresentationCache.getStringSlice(StringHandle(srcInst.m_payload.m_stringIndices[0]));
-                        
-                    const size_t sliceSize = slice.size();
-                    const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
-
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize));
-
-                    IRConstant::StringValue& dstString = irConst->value.stringVal;
-
-                    dstString.numChars = uint32_t(sliceSize);
-                    // Turn into pointer to avoid warning of array overrun
-                    char* dstChars = dstString.chars;
-                    // Copy the chars
-                    memcpy(dstChars, slice.begin(), sliceSize);
-                    break;
-                }
-                default:
-                {
-                    SLANG_ASSERT(!"Unknown constant type");
-                    return SLANG_FAIL;
-                }
-            }
-
-            insts[i] = irConst;
+            stringPayload = m_stringRepresentationCache.getStringSlice(StringHandle(srcInst.m_payload.m_stringIndices[0]));
         }
-        else if (isTextureTypeBase(op))
-        {
-            IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1));
-            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
-
-            // Reintroduce the texture type bits into the the
-            const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
-            inst->op = IROp(uint32_t(inst->op) | (other << kIROpMeta_OtherShift));
 
-            insts[i] = inst;
-        }
-        else
+        insts[i] = _createInst(module, srcInst, stringPayload);
+        if (!insts[i])
         {
-            int numOperands = srcInst.getNumOperands();
-            insts[i] = createEmptyInst(module, op, numOperands);
+            return SLANG_FAIL;
         }
     }
 
@@ -1937,6 +2111,223 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
     return SLANG_OK;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialLazyModule !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+Result IRSerialLazyModule::init(Session* session, ISlangBlob* blob)
+{
+    m_blob = blob;
+    SLANG_RETURN_ON_FAIL(IRSerialReader::mapData(blob->getBufferPointer(), blob->getBufferSize(), &m_data));
+
+    // 0 holds null
+    // 1 holds the IRModuleInst
+    const Ser::Inst& srcModuleInst = m_data.m_insts[1];
+    if (srcModuleInst.m_op != kIROp_Module)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_module = new IRModule();
+    m_module->session = session;
+
+    auto moduleInst = static_cast<IRModuleInst*>(createEmptyInstWithSize(m_module, kIROp_Module, sizeof(IRModuleInst)));
+    m_module->moduleInst = moduleInst;
+    moduleInst->module = m_module;
+
+    const UInt numInsts = m_data.m_insts.getCount();
+    m_insts.SetSize(numInsts);
+    memset(m_insts.begin(), 0, sizeof(IRInst*) * numInsts);
+    m_insts[1] = moduleInst;
+
+    m_moduleRun = _findChildRun(Ser::InstIndex(1));
+    return SLANG_OK;
+}
+
+void IRSerialLazyModule::findSymbols(const UnownedStringSlice& mangledName, List<IRInst*>& instsOut)
+{
+    const Ser::GlobalSymbol* symbols = m_data.m_globalSymbols.begin();
+    const UInt numSymbols = m_data.m_globalSymbols.getCount();
+
+    // The symbols are in name order, so find the first one that isn't before mangledName
+    UInt lo = 0;
+    UInt hi = numSymbols;
+    while (lo < hi)
+    {
+        const UInt mid = (lo + hi) >> 1;
+        if (_compareStringSlices(m_data.getStringSlice(symbols[mid].m_mangledNameIndex), mangledName) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    for (UInt i = lo; i < numSymbols && m_data.getStringSlice(symbols[i].m_mangledNameIndex) == mangledName; ++i)
+    {
+        if (IRInst* inst = _materializeGlobal(symbols[i].m_instIndex))
+        {
+            instsOut.Add(inst);
+        }
+    }
+}
+
+const IRSerialData::InstRun* IRSerialLazyModule::_findChildRun(Ser::InstIndex parentIndex) const
+{
+    // The runs are in parent order
+    const Ser::InstRun* runs = m_data.m_childRuns.begin();
+    UInt lo = 0;
+    UInt hi = m_data.m_childRuns.getCount();
+    while (lo < hi)
+    {
+        const UInt mid = (lo + hi) >> 1;
+        if (runs[mid].m_parentIndex < parentIndex)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return (lo < m_data.m_childRuns.getCount() && runs[lo].m_parentIndex == parentIndex) ? &runs[lo] : nullptr;
+}
+
+IRSerialData::InstIndex IRSerialLazyModule::_findParentIndex(Ser::InstIndex index) const
+{
+    // This is only needed for references to instructions nested inside another global value, which are rare,
+    // so we just search all of the runs
+    for (const auto& run : m_data.m_childRuns)
+    {
+        if (index >= run.m_startInstIndex && uint32_t(index) < uint32_t(run.m_startInstIndex) + run.m_numChildren)
+        {
+            return run.m_parentIndex;
+        }
+    }
+    return Ser::InstIndex(0);
+}
+
+IRInst* IRSerialLazyModule::_getInst(Ser::InstIndex index)
+{
+    SLANG_ASSERT(UInt(index) < m_insts.Count());
+    if (IRInst* inst = m_insts[UInt(index)])
+    {
+        return inst;
+    }
+    if (index == Ser::InstIndex(0))
+    {
+        return nullptr;
+    }
+
+    // Instructions are materialized along with the global value that they belong to
+    Ser::InstIndex globalIndex = index;
+    while (true)
+    {
+        const Ser::InstIndex parentIndex = _findParentIndex(globalIndex);
+        if (parentIndex == Ser::InstIndex(1) || parentIndex == Ser::InstIndex(0))
+        {
+            break;
+        }
+        globalIndex = parentIndex;
+    }
+
+    _materializeGlobal(globalIndex);
+    return m_insts[UInt(index)];
+}
+
+Result IRSerialLazyModule::_createInstTree(Ser::InstIndex index, List<Ser::InstIndex>& indicesOut)
+{
+    typedef Ser::Inst::PayloadType PayloadType;
+
+    const Ser::Inst& srcInst = m_data.m_insts[UInt(index)];
+
+    UnownedStringSlice stringPayload;
+    if (srcInst.m_payloadType == PayloadType::String_1)
+    {
+        stringPayload = m_data.getStringSlice(srcInst.m_payload.m_stringIndices[0]);
+    }
+
+    IRInst* inst = _createInst(m_module, srcInst, stringPayload);
+    if (!inst)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_insts[UInt(index)] = inst;
+    indicesOut.Add(index);
+
+    if (const Ser::InstRun* run = _findChildRun(index))
+    {
+        for (uint32_t i = 0; i < run->m_numChildren; ++i)
+        {
+            SLANG_RETURN_ON_FAIL(_createInstTree(Ser::InstIndex(uint32_t(run->m_startInstIndex) + i), indicesOut));
+        }
+    }
+    return SLANG_OK;
+}
+
+IRInst* IRSerialLazyModule::_materializeGlobal(Ser::InstIndex index)
+{
+    if (IRInst* inst = m_insts[UInt(index)])
+    {
+        return inst;
+    }
+
+    SLANG_ASSERT(m_moduleRun && index >= m_moduleRun->m_startInstIndex && uint32_t(index) < uint32_t(m_moduleRun->m_startInstIndex) + m_moduleRun->m_numChildren);
+
+    // Create the global value and everything nested inside it
+    List<Ser::InstIndex> indices;
+    if (SLANG_FAILED(_createInstTree(index, indices)))
+    {
+        SLANG_ASSERT(!"Unable to create instruction");
+        return nullptr;
+    }
+
+    // Put the children in place, so the global value is complete before anything it references
+    // (which may in turn reference it) is materialized
+    for (auto instIndex : indices)
+    {
+        if (const Ser::InstRun* run = _findChildRun(instIndex))
+        {
+            IRInst* parent = m_insts[UInt(instIndex)];
+            for (uint32_t i = 0; i < run->m_numChildren; ++i)
+            {
+                m_insts[uint32_t(run->m_startInstIndex) + i]->insertAtEnd(parent);
+            }
+        }
+    }
+
+    IRInst* globalInst = m_insts[UInt(index)];
+    globalInst->insertAtEnd(m_module->getModuleInst());
+
+    // Patch up the types and operands, which may reference other global values
+    const bool hasSourceLocs = m_data.m_rawSourceLocs.getCount() == m_data.m_insts.getCount();
+    for (auto instIndex : indices)
+    {
+        const Ser::Inst& srcInst = m_data.m_insts[UInt(instIndex)];
+        IRInst* dstInst = m_insts[UInt(instIndex)];
+
+        if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
+        {
+            dstInst->setFullType(static_cast<IRType*>(_getInst(srcInst.m_resultTypeIndex)));
+        }
+
+        const Ser::InstIndex* srcOperandIndices;
+        const int numOperands = m_data.getOperands(srcInst, &srcOperandIndices);
+        for (int j = 0; j < numOperands; j++)
+        {
+            dstInst->setOperand(j, _getInst(srcOperandIndices[j]));
+        }
+
+        if (hasSourceLocs)
+        {
+            dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(m_data.m_rawSourceLocs[UInt(instIndex)]));
+        }
+    }
+
+    return globalInst;
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 /* static */void IRSerialUtil::calcInstructionList(IRModule* module, List<IRInst*>& instsOut)
@@ -62,6 +62,11 @@ struct SerialStringTableUtil
 
         /// Produces an index map, from slices to indices in pool
     static void calcStringSlicePoolMap(const List<UnownedStringSlice>& slices, StringSlicePool& pool, List<StringSlicePool::Handle>& indexMap);
+
+        /// Calculates the offset of each (encoded) string in the string table, indexed in the same way as the StringSlicePool
+    static void calcStringOffsets(const List<char>& stringTable, List<uint32_t>& offsetsOut);
+        /// Decodes the string starting at offset in the string table
+    static UnownedStringSlice decodeString(const char* stringTable, uint32_t offset);
 };
 
 // Pre-declare
@@ -113,6 +118,17 @@ struct IRSerialData
         SizeType m_numInst;                 ///< The number of children
     };
 
+    /// A global value that has linkage (and so can be looked up by the linker)
+    struct GlobalSymbol
+    {
+        typedef GlobalSymbol ThisType;
+        bool operator==(const ThisType& rhs) const { return m_mangledNameIndex == rhs.m_mangledNameIndex && m_instIndex == rhs.m_instIndex; }
+        bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        StringIndex m_mangledNameIndex;     ///< The mangled name of the global value
+        InstIndex m_instIndex;              ///< The global value
+    };
+
     struct PayloadInfo
     {
         uint8_t m_numOperands;
@@ -270,7 +286,7 @@ struct IRSerialData
     
     List<Inst> m_insts;                         ///< The instructions
 
-    List<InstRun> m_childRuns;                  ///< Holds the information about children that belong to an instruction
+    List<InstRun> m_childRuns;                  ///< Holds the information about children that belong to an instruction, in parent index order
 
     List<InstIndex> m_externalOperands;         ///< Holds external operands (for instructions with more than kNumOperands)
 
@@ -278,6 +294,8 @@ struct IRSerialData
 
     List<RawSourceLoc> m_rawSourceLocs;         ///< A source location per instruction (saved without modification from IRInst)s
 
+    List<GlobalSymbol> m_globalSymbols;         ///< The global values with linkage, in mangled name order
+
     // Data only set if we have debug information
 
     List<char> m_debugStringTable;              ///< String table for debug use only
@@ -368,6 +386,7 @@ struct IRSerialBinary
     {
         None,
         VariableByteLite,
+        LZ,                         ///< Byte oriented LZ compression (see LZCompressUtil). Works on any array.
     };
 
     
@@ -383,14 +402,29 @@ struct IRSerialBinary
     static const uint32_t kCompressedExternalOperandsFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kExternalOperandsFourCc);
 
     static const uint32_t kStringFourCc = SLANG_FOUR_CC('S', 'L', 's', 't');
+    static const uint32_t kStringOffsetFourCc = SLANG_FOUR_CC('S', 'L', 's', 'o');
+
+    static const uint32_t kCompressedStringFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kStringFourCc);
+
+    static const uint32_t kGlobalSymbolFourCc = SLANG_FOUR_CC('S', 'L', 'g', 's');
+    static const uint32_t kCompressedGlobalSymbolFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kGlobalSymbolFourCc);
+
+        /// Chunk that holds no data, and is just used to align the chunk that follows
+    static const uint32_t kPadFourCc = SLANG_FOUR_CC('J', 'U', 'N', 'K');
+        /// The alignment of the payload of uncompressed arrays (relative to the start of the RIFF),
+        /// so that they can be used in place
+    static const size_t kArrayAlignment = 8;
 
     static const uint32_t kUInt32SourceLocFourCc = SLANG_FOUR_CC('S', 'r', 's', '4');
+    static const uint32_t kCompressedUInt32SourceLocFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kUInt32SourceLocFourCc);
 
     static const uint32_t kDebugStringFourCc = SLANG_FOUR_CC('S', 'd', 's', 't');
     static const uint32_t kDebugLineInfoFourCc = SLANG_FOUR_CC('S', 'd', 'l', 'n');
     static const uint32_t kDebugAdjustedLineInfoFourCc = SLANG_FOUR_CC('S', 'd', 'a', 'l');
     static const uint32_t kDebugSourceInfoFourCc = SLANG_FOUR_CC('S', 'd', 's', 'o');
     static const uint32_t kDebugSourceLocRunFourCc = SLANG_FOUR_CC('S', 'd', 's', 'r');
+    // NOTE! The compressed forms of kDebugStringFourCc and kDebugSourceInfoFourCc are the same as those of kStringFourCc
+    // and kStringOffsetFourCc, so those chunks (and the string offsets) are never compressed.
 
     struct SlangHeader
     {
@@ -406,7 +440,7 @@ struct IRSerialBinary
     {
         Chunk m_chunk;
         uint32_t m_numEntries;              ///< The number of entries
-        uint32_t m_numCompressedEntries;    ///< The amount of compressed entries
+        uint32_t m_numCompressedEntries;    ///< The amount of compressed entries (for LZ the amount of compressed bytes)
     };
 };
 
@@ -504,6 +538,52 @@ protected:
     SourceManager* m_sourceManager;                     ///< The source manager
 };
 
+/// A view of serialized IR that refers directly to the memory that holds it (for example a memory mapped file)
+struct IRSerialMappedData
+{
+    typedef IRSerialData Ser;
+
+    template <typename T>
+    struct Array
+    {
+        SLANG_FORCE_INLINE const T& operator[](UInt index) const { SLANG_ASSERT(index < m_count); return m_data[index]; }
+        SLANG_FORCE_INLINE UInt getCount() const { return m_count; }
+        SLANG_FORCE_INLINE const T* begin() const { return m_data; }
+        SLANG_FORCE_INLINE const T* end() const { return m_data + m_count; }
+
+        const T* m_data = nullptr;
+        UInt m_count = 0;
+    };
+
+        /// Get the operands of an instruction
+    SLANG_FORCE_INLINE int getOperands(const Ser::Inst& inst, const Ser::InstIndex** operandsOut) const;
+        /// Get a string from the string table
+    UnownedStringSlice getStringSlice(Ser::StringIndex index) const;
+
+    Array<Ser::Inst> m_insts;
+    Array<Ser::InstRun> m_childRuns;
+    Array<Ser::InstIndex> m_externalOperands;
+    Array<char> m_stringTable;
+    Array<uint32_t> m_stringOffsets;            ///< The offset of each string in m_stringTable
+    Array<Ser::RawSourceLoc> m_rawSourceLocs;
+    Array<Ser::GlobalSymbol> m_globalSymbols;
+};
+
+// --------------------------------------------------------------------------
+SLANG_FORCE_INLINE int IRSerialMappedData::getOperands(const Ser::Inst& inst, const Ser::InstIndex** operandsOut) const
+{
+    if (inst.m_payloadType == Ser::Inst::PayloadType::OperandExternal)
+    {
+        *operandsOut = m_externalOperands.begin() + int(inst.m_payload.m_externalOperand.m_arrayIndex);
+        return int(inst.m_payload.m_externalOperand.m_size);
+    }
+    else
+    {
+        *operandsOut = inst.m_payload.m_operands;
+        return Ser::s_payloadInfos[int(inst.m_payloadType)].m_numOperands;
+    }
+}
+
 struct IRSerialReader
 {
     typedef IRSerialData Ser;
@@ -512,6 +592,10 @@ struct IRSerialReader
         /// Read a stream to fill in dataOut IRSerialData
     static Result readStream(Stream* stream, IRSerialData* dataOut);
 
+        /// Set up dataOut to refer to the arrays held in data (as written by writeStream without compression), without copying them.
+        /// data must be aligned to IRSerialBinary::kArrayAlignment.
+    static Result mapData(const void* data, size_t size, IRSerialMappedData* dataOut);
+
         /// Read a module from serial data
     Result read(const IRSerialData& data, Session* session, SourceManager* sourceManager, RefPtr<IRModule>& moduleOut);
 
@@ -534,6 +618,46 @@ struct IRSerialReader
     IRModule* m_module;
 };
 
+/// An IR module that is read from serialized IR on demand.
+///
+/// Global values are only turned into IRInsts (along with everything that they reference) the first
+/// time they are looked up by mangled name, so a module that is mostly unused costs little more
+/// than the memory holding the serialized data.
+class IRSerialLazyModule : public RefObject
+{
+public:
+    typedef IRSerialData Ser;
+
+        /// Initialize to read from the serialized IR held in blob (as written by IRSerialWriter::writeStream without compression)
+    Result init(Session* session, ISlangBlob* blob);
+
+        /// Find all of the global values with the mangled name, materializing them if needed
+    void findSymbols(const UnownedStringSlice& mangledName, List<IRInst*>& instsOut);
+
+        /// Get the module that holds the global values that have been materialized so far
+    IRModule* getModule() const { return m_module; }
+
+protected:
+        /// Get the instruction for index, materializing the global value it belongs to if needed
+    IRInst* _getInst(Ser::InstIndex index);
+        /// Turn the global value at index (and everything it references) into IRInsts
+    IRInst* _materializeGlobal(Ser::InstIndex index);
+        /// Create the (unlinked) instruction at index and all of its descendants
+    Result _createInstTree(Ser::InstIndex index, List<Ser::InstIndex>& indicesOut);
+
+        /// Find the children of the instruction at parentIndex. Returns nullptr if it doesn't have any
+    const Ser::InstRun* _findChildRun(Ser::InstIndex parentIndex) const;
+        /// Find the parent of the instruction at index
+    Ser::InstIndex _findParentIndex(Ser::InstIndex index) const;
+
+    ComPtr<ISlangBlob> m_blob;                  ///< Holds the serialized data
+    IRSerialMappedData m_data;                  ///< View of the data in m_blob
+
+    RefPtr<IRModule> m_module;
+    List<IRInst*> m_insts;                      ///< The instruction for each index, or nullptr if not materialized yet
+    const Ser::InstRun* m_moduleRun = nullptr;  ///< The run holding the global values
+};
+
 struct IRSerialUtil
 {
         /// Produces an instruction list which is in same order as written through IRSerialWriter
@@ -3,7 +3,9 @@
 
 #include "ir.h"
 #include "ir-clone.h"
+#include "ir-inst-map.h"
 #include "ir-insts.h"
+#include "ir-link.h"
 
 namespace Slang
 {
@@ -50,10 +52,16 @@ struct SpecializationContext
     // specialized-ness of an instruction depends on the
     // fully-specialized-ness of its operands.
     //
-    // We will build an explicit hash set to encode those
-    // instructions that are fully specialized.
+    // We will build an explicit set to encode those
+    // instructions that are fully specialized. The set
+    // is a bit set over a dense numbering of instructions.
     //
-    HashSet<IRInst*> fullySpecializedInsts;
+    IRInstNumbering instNumbering;
+    IRInstSet fullySpecializedInsts;
+
+    SpecializationContext()
+        : fullySpecializedInsts(&instNumbering)
+    {}
 
     // An instruction is then fully specialized if and only
     // if it is in our set.
@@ -617,6 +625,62 @@ struct SpecializationContext
         // which case we wouldn't want to specialize it anyway.
     }
 
+    // When code is generated for multiple entry points, the same
+    // generics will often be specialized to the same arguments for
+    // each of them. We can record the specialized functions and
+    // types we created in a cache, so that they can be copied
+    // when the code for later entry points is linked.
+    //
+    void addSpecializationsToCache(IRSpecializationCache* cache)
+    {
+        // A specialization key refers to the generic and its arguments,
+        // and an argument might itself be the result of another
+        // specialization (e.g., `Foo<Bar<int>>`), so we compute
+        // keys until no more can be found.
+        //
+        Dictionary<IRInst*, String> knownKeys;
+        Dictionary<String, IRInst*> specializations;
+        bool changed = true;
+        while( changed )
+        {
+            changed = false;
+            for( auto entry : genericSpecializations )
+            {
+                auto specializedVal = entry.Value;
+                if(knownKeys.ContainsKey(specializedVal))
+                    continue;
+
+                auto& vals = entry.Key.vals;
+                String key;
+                if(!getSpecializationCacheKey(vals[0], vals.Count() - 1, vals.Buffer() + 1, knownKeys, key))
+                    continue;
+
+                knownKeys.Add(specializedVal, key);
+                changed = true;
+
+                // We only cache functions with a body and `struct` types;
+                // other generics produce values that are cheap to
+                // specialize again.
+                //
+                switch( specializedVal->op )
+                {
+                default:
+                    break;
+
+                case kIROp_Func:
+                    if(!as<IRFunc>(specializedVal)->getFirstBlock())
+                        break;
+                    /* fallthrough */
+                case kIROp_StructType:
+                    specializations.AddIfNotExists(key, specializedVal);
+                    break;
+                }
+            }
+        }
+
+        Slang::addSpecializationsToCache(cache, module, specializations);
+    }
+
     // Given a `call` instruction in the IR, we need to detect the case
     // where the callee has some interface-type parameter(s) and at the
     // call site it is statically clear what concrete type(s) the arguments
@@ -1338,11 +1402,15 @@ struct SpecializationContext
 };
 
 void specializeModule(
-    IRModule*   module)
+    IRModule*               module,
+    IRSpecializationCache*  cache)
 {
     SpecializationContext context;
     context.module = module;
     context.processModule();
+
+    if(cache)
+        context.addSpecializationsToCache(cache);
 }
 
 
@@ -4,9 +4,16 @@
 namespace Slang
 {
 struct IRModule;
+struct IRSpecializationCache;
 
     /// Specialize generic and interface-based code to use concrete types.
+    ///
+    /// If a `cache` is given, the specialized functions and types that
+    /// are created get added to it, so that they can be re-used when
+    /// linking code for other entry points.
+    ///
 void specializeModule(
-    IRModule*   module);
+    IRModule*               module,
+    IRSpecializationCache*  cache = nullptr);
 
 }
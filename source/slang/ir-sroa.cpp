@@ -0,0 +1,508 @@
+// ir-sroa.cpp
+#include "ir-sroa.h"
+
+#include "ir.h"
+#include "ir-insts.h"
+
+namespace Slang {
+
+// This file implements Scalar Replacement of Aggregates (SROA).
+//
+// Our SSA construction pass can only promote a variable when all of
+// the stores to it write the whole variable. A local `struct` that
+// gets initialized one field at a time:
+//
+//      MyStruct s;
+//      s.a = ...;
+//      s.b = ...;
+//      use(s.a + s.b);
+//
+// therefore stays in memory, and ends up as a temporary (along with
+// copies into and out of it) in the code we emit.
+//
+// We can do better by splitting `s` into one variable per field,
+// after which each of `s_a` and `s_b` is a simple variable that SSA
+// construction can promote. Any places where `s` was loaded or stored
+// as a whole become loads/stores of the individual fields.
+//
+// The same logic applies to local arrays, as long as every element
+// access uses a constant index, and the array is small.
+//
+struct SROAContext
+{
+    SharedIRBuilder sharedBuilderStorage;
+    IRBuilder       builderStorage;
+    IRBuilder* getBuilder() { return &builderStorage; }
+
+    // We won't split arrays bigger than this, so that we don't
+    // turn a big array that happens to be indexed with constants
+    // into a huge number of variables.
+    //
+    static const IRIntegerValue kMaxArrayElementCount = 16;
+
+    // The variables that we still need to consider for splitting.
+    // Splitting a variable can create new variables of aggregate
+    // type (for nested structs), and those get added here too.
+    //
+    List<IRVar*> workList;
+
+    // The variables that have been split (and deallocated). A variable
+    // can be added to the work list more than once (e.g., when it is the
+    // source of several copies), so we need to skip any that have
+    // already been split when they come off the list again.
+    //
+    HashSet<IRVar*> splitVars;
+
+    // Each variable is split into a list of "elements" that
+    // each have their own variable.
+    //
+    struct Element
+    {
+        // The struct field key, or constant index, for the element
+        IRInst* key;
+
+        IRType* type;
+        IRVar*  var;
+    };
+
+    void processFunc(IRFunc* func)
+    {
+        List<IRVar*> vars;
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                if( auto var = as<IRVar>(inst) )
+                    vars.Add(var);
+            }
+        }
+
+        // We process the variables in the order they are declared,
+        // so that a copy `p = o` is usually rewritten after `o` has
+        // been split, and can then use the fields of `o` directly
+        // (see `extractElement`).
+        //
+        for( UInt ii = vars.Count(); ii > 0; --ii )
+        {
+            workList.Add(vars[ii - 1]);
+        }
+
+        while( workList.Count() )
+        {
+            IRVar* var = workList.Last();
+            workList.RemoveLast();
+
+            if(splitVars.Contains(var))
+                continue;
+            maybeSplitVar(var);
+        }
+    }
+
+    // Get the value of `inst` if it is an integer constant
+    // in the range `[0, count)`, or -1 otherwise.
+    //
+    static IRIntegerValue getConstantIndex(IRInst* inst, IRIntegerValue count)
+    {
+        auto intLit = as<IRIntLit>(inst);
+        if(!intLit)
+            return -1;
+        IRIntegerValue value = intLit->getValue();
+        if(value < 0 || value >= count)
+            return -1;
+        return value;
+    }
+
+    // Get the elements that a variable of type `type` would be split into,
+    // or return false if the type isn't an aggregate we can split.
+    //
+    bool getElements(IRType* type, List<Element>& outElements)
+    {
+        if( auto structType = as<IRStructType>(type) )
+        {
+            for( auto field : structType->getFields() )
+            {
+                // Type legalization can leave behind fields of `void`
+                // type, which we can't declare variables of.
+                //
+                if(as<IRVoidType>(field->getFieldType()))
+                    return false;
+
+                Element element;
+                element.key = field->getKey();
+                element.type = field->getFieldType();
+                element.var = nullptr;
+                outElements.Add(element);
+            }
+            return outElements.Count() != 0;
+        }
+        else if( auto arrayType = as<IRArrayType>(type) )
+        {
+            auto elementCount = as<IRIntLit>(arrayType->getElementCount());
+            if(!elementCount)
+                return false;
+            IRIntegerValue count = elementCount->getValue();
+            if(count <= 0 || count > kMaxArrayElementCount)
+                return false;
+
+            auto builder = getBuilder();
+            for( IRIntegerValue ii = 0; ii < count; ++ii )
+            {
+                Element element;
+                element.key = builder->getIntValue(builder->getIntType(), ii);
+                element.type = arrayType->getElementType();
+                element.var = nullptr;
+                outElements.Add(element);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // Find the element of an aggregate accessed by a field or element
+    // address/extract instruction, or -1 if it can't be determined.
+    //
+    static Int findElement(IRInst* accessInst, List<Element> const& elements)
+    {
+        auto keyOrIndex = accessInst->getOperand(1);
+        switch( accessInst->op )
+        {
+        case kIROp_FieldAddress:
+        case kIROp_FieldExtract:
+            for( Int ii = 0; ii < Int(elements.Count()); ++ii )
+            {
+                if(elements[ii].key == keyOrIndex)
+                    return ii;
+            }
+            return -1;
+
+        case kIROp_getElementPtr:
+        case kIROp_getElement:
+            return Int(getConstantIndex(keyOrIndex, IRIntegerValue(elements.Count())));
+
+        default:
+            return -1;
+        }
+    }
+
+    // Is `use` the base operand of an extract of a single element?
+    //
+    static bool isElementExtract(IRUse* use, List<Element> const& elements)
+    {
+        auto user = use->getUser();
+        if(use != user->getOperands())
+            return false;
+        switch( user->op )
+        {
+        default:
+            return false;
+
+        case kIROp_FieldExtract:
+        case kIROp_getElement:
+            return findElement(user, elements) >= 0;
+        }
+    }
+
+    // Is `use` an argument to a call, for a parameter that
+    // is passed by reference (e.g., an `inout` parameter)?
+    //
+    static bool isPassedByReference(IRUse* use)
+    {
+        auto call = cast<IRCall>(use->getUser());
+        UInt operandIndex = UInt(use - call->getOperands());
+        if(operandIndex == 0)
+            return false;
+
+        auto funcType = as<IRFuncType>(call->getCallee()->getDataType());
+        if(!funcType)
+            return true;
+
+        UInt paramIndex = operandIndex - 1;
+        if(paramIndex >= funcType->getParamCount())
+            return true;
+        return as<IRPtrTypeBase>(funcType->getParamType(paramIndex)) != nullptr;
+    }
+
+    // Check that every use of `var` is one that we know how to
+    // rewrite in terms of the elements. We also require at least
+    // one access to an individual element (through an address,
+    // or by extracting it from a loaded value), since splitting
+    // a variable that is only ever used as a whole would just
+    // mean re-assembling the aggregate at every load.
+    //
+    bool canSplitVar(IRVar* var, List<Element> const& elements)
+    {
+        bool hasElementAccess = false;
+        for( auto use = var->firstUse; use; use = use->nextUse )
+        {
+            auto user = use->getUser();
+            switch( user->op )
+            {
+            default:
+                return false;
+
+            case kIROp_Load:
+                for( auto loadUse = user->firstUse; loadUse; loadUse = loadUse->nextUse )
+                {
+                    if(isElementExtract(loadUse, elements))
+                        hasElementAccess = true;
+
+                    // The front end sometimes uses a loaded value where
+                    // an address is expected (e.g., for the `this`
+                    // argument of a `[mutating]` method), and we can't
+                    // rewrite those in terms of the elements.
+                    //
+                    switch( loadUse->getUser()->op )
+                    {
+                    default:
+                        break;
+
+                    case kIROp_FieldAddress:
+                    case kIROp_getElementPtr:
+                    case kIROp_Store:
+                        if(loadUse == loadUse->getUser()->getOperands())
+                            return false;
+                        break;
+
+                    case kIROp_Call:
+                        if(isPassedByReference(loadUse))
+                            return false;
+                        break;
+                    }
+                }
+                break;
+
+            case kIROp_Store:
+                // Storing the address of the variable somewhere
+                // else would let it escape.
+                if(use != &((IRStore*) user)->ptr)
+                    return false;
+                break;
+
+            case kIROp_FieldAddress:
+            case kIROp_getElementPtr:
+                if(use != user->getOperands())
+                    return false;
+                if(findElement(user, elements) < 0)
+                    return false;
+                hasElementAccess = true;
+                break;
+            }
+        }
+        return hasElementAccess;
+    }
+
+    // Emit code to extract element number `index` from the aggregate
+    // value `val`, before the instruction `user`.
+    //
+    IRInst* extractElement(
+        IRInst*         user,
+        IRType*         type,
+        IRInst*         val,
+        Element const&  element,
+        Int             index)
+    {
+        // When the stored value was built with `makeStruct` or
+        // `makeArray` (which includes any whole-aggregate load
+        // that we have already split), we can use the operand
+        // directly instead of extracting it again.
+        //
+        switch( val->op )
+        {
+        default:
+            break;
+
+        case kIROp_makeStruct:
+        case kIROp_makeArray:
+            if( UInt(index) < val->getOperandCount() )
+                return val->getOperand(index);
+            break;
+        }
+
+        auto builder = getBuilder();
+        IRInst* elementVal = nullptr;
+        if( as<IRStructType>(type) )
+            elementVal = builder->emitFieldExtract(element.type, val, element.key);
+        else
+            elementVal = builder->emitElementExtract(element.type, val, element.key);
+        elementVal->sourceLoc = user->sourceLoc;
+        return elementVal;
+    }
+
+    void maybeSplitVar(IRVar* var)
+    {
+        auto type = var->getDataType()->getValueType();
+
+        List<Element> elements;
+        if(!getElements(type, elements))
+            return;
+        if(!canSplitVar(var, elements))
+            return;
+
+        auto builder = getBuilder();
+
+        // We create the variables for the elements where the
+        // original variable was declared, and give them names
+        // based on the name of the original (if it had one).
+        //
+        auto nameHint = var->findDecoration<IRNameHintDecoration>();
+
+        builder->setInsertBefore(var);
+        for( Int ii = 0; ii < Int(elements.Count()); ++ii )
+        {
+            auto& element = elements[ii];
+            element.var = builder->emitVar(element.type);
+            element.var->sourceLoc = var->sourceLoc;
+
+            if( nameHint )
+            {
+                StringBuilder name;
+                name << nameHint->getName() << "_";
+                if( auto keyNameHint = element.key->findDecoration<IRNameHintDecoration>() )
+                    name << keyNameHint->getName();
+                else
+                    name << ii;
+                builder->addNameHintDecoration(element.var, name.getUnownedSlice());
+            }
+
+            // An element might be an aggregate itself.
+            //
+            workList.Add(element.var);
+        }
+
+        // Now we can rewrite each use of the original variable. We
+        // collect the uses first, since we will be removing them
+        // as we go.
+        //
+        List<IRInst*> users;
+        for( auto use = var->firstUse; use; use = use->nextUse )
+        {
+            users.Add(use->getUser());
+        }
+
+        for( auto user : users )
+        {
+            switch( user->op )
+            {
+            case kIROp_FieldAddress:
+            case kIROp_getElementPtr:
+                {
+                    // An access to one element is replaced with
+                    // the variable for that element.
+                    //
+                    auto& element = elements[findElement(user, elements)];
+                    user->replaceUsesWith(element.var);
+                }
+                break;
+
+            case kIROp_Load:
+                {
+                    // A load of the whole aggregate is replaced
+                    // with loads of each element, which are then
+                    // assembled into a value of the aggregate type.
+                    //
+                    builder->setInsertBefore(user);
+
+                    List<IRInst*> elementVals;
+                    for( auto& element : elements )
+                    {
+                        auto elementVal = builder->emitLoad(element.var);
+                        elementVal->sourceLoc = user->sourceLoc;
+                        elementVals.Add(elementVal);
+                    }
+
+                    IRInst* val = nullptr;
+                    if( as<IRStructType>(type) )
+                        val = builder->emitMakeStruct(type, elementVals);
+                    else
+                        val = builder->emitMakeArray(type, elementVals.Count(), elementVals.Buffer());
+                    val->sourceLoc = user->sourceLoc;
+
+                    // Any extraction of a single element from the loaded
+                    // value can use the load of that element directly.
+                    //
+                    List<IRInst*> extracts;
+                    for( auto use = user->firstUse; use; use = use->nextUse )
+                    {
+                        if(isElementExtract(use, elements))
+                            extracts.Add(use->getUser());
+                    }
+                    for( auto extract : extracts )
+                    {
+                        extract->replaceUsesWith(elementVals[findElement(extract, elements)]);
+                        extract->removeAndDeallocate();
+                    }
+
+                    user->replaceUsesWith(val);
+                }
+                break;
+
+            case kIROp_Store:
+                {
+                    // A store of the whole aggregate is replaced
+                    // with stores of each element.
+                    //
+                    builder->setInsertBefore(user);
+
+                    auto val = ((IRStore*) user)->val.get();
+
+                    // If we are copying from another variable, then the
+                    // extracts we emit here might make it worth splitting
+                    // that variable too, even if we already decided not to.
+                    //
+                    if( val->op == kIROp_Load )
+                    {
+                        if( auto srcVar = as<IRVar>(val->getOperand(0)) )
+                            workList.Add(srcVar);
+                    }
+                    for( Int ii = 0; ii < Int(elements.Count()); ++ii )
+                    {
+                        auto& element = elements[ii];
+                        auto elementVal = extractElement(user, type, val, element, ii);
+
+                        auto elementStore = builder->emitStore(element.var, elementVal);
+                        elementStore->sourceLoc = user->sourceLoc;
+                    }
+                }
+                break;
+
+            default:
+                SLANG_UNEXPECTED("unhandled use of variable in SROA");
+                break;
+            }
+
+            user->removeAndDeallocate();
+        }
+
+        splitVars.Add(var);
+        var->removeAndDeallocate();
+    }
+};
+
+static void applyScalarReplacementOfAggregatesRec(
+    SROAContext*    context,
+    IRInst*         inst)
+{
+    if( auto func = as<IRFunc>(inst) )
+    {
+        context->processFunc(func);
+        return;
+    }
+
+    for( auto childInst : inst->getDecorationsAndChildren() )
+    {
+        applyScalarReplacementOfAggregatesRec(context, childInst);
+    }
+}
+
+void applyScalarReplacementOfAggregates(
+    IRModule*   module)
+{
+    SROAContext context;
+    context.sharedBuilderStorage.module = module;
+    context.sharedBuilderStorage.session = module->getSession();
+    context.builderStorage.sharedBuilder = &context.sharedBuilderStorage;
+
+    applyScalarReplacementOfAggregatesRec(&context, module->getModuleInst());
+}
+
+}
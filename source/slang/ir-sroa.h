@@ -0,0 +1,18 @@
+// ir-sroa.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Apply Scalar Replacement of Aggregates (SROA) to the functions in a module.
+        ///
+        /// A local variable of `struct` type (or of array type, with a small constant
+        /// size) that is only accessed through loads, stores, and field/element
+        /// addresses with constant keys/indices is split into one variable per
+        /// field/element. This lets SSA construction promote the individual fields,
+        /// even when the aggregate as a whole would not be promotable.
+        ///
+    void applyScalarReplacementOfAggregates(
+        IRModule*   module);
+}
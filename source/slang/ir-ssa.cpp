@@ -2,6 +2,7 @@
 #include "ir-ssa.h"
 
 #include "ir.h"
+#include "ir-inst-map.h"
 #include "ir-insts.h"
 
 namespace Slang {
@@ -78,8 +79,12 @@ struct ConstructSSAContext
     // to SSA values.
     List<IRVar*> promotableVars;
 
+    // Dense numbering of the instructions in `globalVal`,
+    // used to index the per-block and per-phi side tables.
+    IRInstNumbering instNumbering;
+
     // Information about each basic block
-    Dictionary<IRBlock*, RefPtr<SSABlockInfo>> blockInfos;
+    IRInstMap<RefPtr<SSABlockInfo>> blockInfos;
 
     // IR building state to use during the operation
     SharedIRBuilder sharedBuilder;
@@ -91,7 +96,12 @@ struct ConstructSSAContext
     IRBuilder* getBuilder() { return &builder; }
 
 
-    Dictionary<IRParam*, RefPtr<PhiInfo>> phiInfos;
+    IRInstMap<RefPtr<PhiInfo>> phiInfos;
+
+    ConstructSSAContext()
+        : blockInfos(&instNumbering)
+        , phiInfos(&instNumbering)
+    {}
 
     PhiInfo* getPhiInfo(IRParam* phi)
     {
@@ -38,12 +38,16 @@ namespace Slang
         IRInst*             parent)
     {
         IRInst* prevChild = nullptr;
+        uint32_t decorationSummary = 0;
         for(auto child : parent->getDecorationsAndChildren() )
         {
+            if(isIRDecorationOp(child->op))
+                decorationSummary |= getIRDecorationSummaryBit(child->op);
+
             // We need to check the integrity of the parent/next/prev links of
             // all of our instructions
             validate(context, child->parent == parent,  child, "parent link");
-            validate(context, child->prev == prevChild, child, "next/prev link");
+            validate(context, child->getPrevInst() == prevChild, child, "next/prev link");
 
             // Recursively validate the instruction itself.
             validateIRInst(context, child);
@@ -65,6 +69,10 @@ namespace Slang
 
             prevChild = child;
         }
+
+        // The summary of decorations on the parent needs to agree
+        // with the decorations that are actually attached.
+        validate(context, parent->decorationSummary == decorationSummary, parent, "decoration summary");
     }
 
     void validateIRInstOperand(
@@ -100,6 +108,9 @@ namespace Slang
             return;
         }
 
+        // The use had better be linked into the list of uses of the value.
+        validate(context, operandUse->prevLink && *operandUse->prevLink == operandUse, inst, "operand use link");
+
         auto operandParent = operandValue->getParent();
 
         if (auto instParentBlock = as<IRBlock>(instParent))
@@ -170,6 +181,12 @@ namespace Slang
     {
         // Validate that any operands of the instruction are used appropriately
         validateIRInstOperands(context, inst);
+
+        // Every use in the list of uses of the instruction needs to refer back to it.
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            validate(context, use->get() == inst, inst, "use list");
+        }
         context->seenInsts.Add(inst);
 
         // If `inst` is itself a parent instruction, then we need to recursively
@@ -195,7 +195,10 @@ namespace Slang
 
     IRDecoration* IRInst::findDecorationImpl(IROp decorationOp)
     {
-        for(auto dd : getDecorations())
+        if(!(decorationSummary & getIRDecorationSummaryBit(decorationOp)))
+            return nullptr;
+
+        for(auto dd = getFirstDecoration(); dd; dd = dd->getNextDecoration())
         {
             if(dd->op == decorationOp)
                 return dd;
@@ -203,6 +206,27 @@ namespace Slang
         return nullptr;
     }
 
+    void IRInst::_updateDecorationSummary()
+    {
+        uint32_t summary = 0;
+        for(auto dd = getFirstDecoration(); dd; dd = dd->getNextDecoration())
+        {
+            summary |= getIRDecorationSummaryBit(dd->op);
+        }
+        decorationSummary = summary;
+    }
+
+    uint32_t calcIRDecorationSummaryMask(bool (*isa)(IROp op))
+    {
+        uint32_t mask = 0;
+        for(int op = kIROp_FirstDecoration; op <= kIROp_LastDecoration; ++op)
+        {
+            if(isa(IROp(op)))
+                mask |= getIRDecorationSummaryBit(IROp(op));
+        }
+        return mask;
+    }
+
     // IRConstant
 
     IRIntegerValue GetIntVal(IRInst* inst)
@@ -870,6 +894,7 @@ namespace Slang
         SLANG_ASSERT(module);
         IRInst* inst = (IRInst*)module->memoryArena.allocateAndZero(size);
 
+        SLANG_ASSERT(UInt(totalArgCount) <= kMaxIROperandCount);
         inst->operandCount = uint32_t(totalArgCount);
         inst->op = op;
 
@@ -1003,6 +1028,7 @@ namespace Slang
         // TODO: Do we need to run ctor after zeroing?
         new(inst)T();
 
+        SLANG_ASSERT(UInt(fixedArgCount + varArgCount) <= kMaxIROperandCount);
         inst->operandCount = (uint32_t)(fixedArgCount + varArgCount);
 
         inst->op = op;
@@ -1528,6 +1554,7 @@ namespace Slang
         new(inst) IRInst();
         inst->op = op;
         inst->typeUse.usedValue = type;
+        SLANG_ASSERT(operandCount <= kMaxIROperandCount);
         inst->operandCount = (uint32_t) operandCount;
 
         // Don't link up as we may free (if we already have this key)
@@ -3953,13 +3980,21 @@ namespace Slang
         SLANG_ASSERT(!inPrev || (inPrev->getNextInst() == inNext) && (inPrev->getParent() == inParent));
         SLANG_ASSERT(!inNext || (inNext->getPrevInst() == inPrev) && (inNext->getParent() == inParent));
 
+        // The `prev` link of the first entry in the list of
+        // children refers to the last entry.
+        //
+        IRInst* oldFirst = inParent->m_firstDecorationOrChild;
+        IRInst* oldLast = oldFirst ? oldFirst->prev : nullptr;
+
         if( inPrev )
         {
             inPrev->next = this;
+            this->prev = inPrev;
         }
         else
         {
-            inParent->m_decorationsAndChildren.first = this;
+            inParent->m_firstDecorationOrChild = this;
+            this->prev = inNext ? oldLast : this;
         }
 
         if (inNext)
@@ -3968,12 +4003,14 @@ namespace Slang
         }
         else
         {
-            inParent->m_decorationsAndChildren.last = this;
+            inParent->m_firstDecorationOrChild->prev = this;
         }
 
-        this->prev = inPrev;
         this->next = inNext;
         this->parent = inParent;
+
+        if(isIRDecorationOp(op))
+            inParent->decorationSummary |= getIRDecorationSummaryBit(op);
     }
 
     void IRInst::insertAfter(IRInst* other)
@@ -4017,22 +4054,34 @@ namespace Slang
         }
         else
         {
-            oldParent->m_decorationsAndChildren.first = nn;
+            oldParent->m_firstDecorationOrChild = nn;
         }
 
+        // The `prev` link of the first entry in the list of
+        // children refers to the last entry, so when we remove
+        // the first entry, its `prev` link moves to the new
+        // first entry, and when we remove the last entry, the
+        // first entry needs to refer to the new last entry.
+        //
         if(nn)
         {
             SLANG_ASSERT(nn->getParent() == oldParent);
-            nn->prev = pp;
+            nn->prev = pp ? pp : prev;
         }
-        else
+        else if(pp)
         {
-            oldParent->m_decorationsAndChildren.last = pp;
+            oldParent->m_firstDecorationOrChild->prev = pp;
         }
 
         prev = nullptr;
         next = nullptr;
         parent = nullptr;
+
+        // Another decoration with the same summary bit might still
+        // be attached, so we rebuild the summary from scratch.
+        //
+        if(isIRDecorationOp(op))
+            oldParent->_updateDecorationSummary();
     }
 
     void IRInst::removeArguments()
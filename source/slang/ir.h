@@ -221,6 +221,9 @@ struct IRInstList : IRInstListBase
 
 
 
+    /// The largest number of operands an instruction can have (see `IRInst::operandCount`).
+static const UInt kMaxIROperandCount = (UInt(1) << 24) - 1;
+
 // Every value in the IR is an instruction (even things
 // like literal values).
 //
@@ -236,13 +239,36 @@ struct IRInst
     // instructions that need "vararg" support to
     // allocate this field ahead of the `this`
     // pointer.
-    uint32_t operandCount = 0;
+    //
+    // Only the low 24 bits of the word hold the count (see
+    // `kMaxIROperandCount`). The rest of the word holds
+    // `decorationSummary`, so that it doesn't make `IRInst` any bigger.
+    uint32_t operandCount : 24;
+
+    // A summary of the opcodes of the decorations attached to
+    // this instruction (see `getIRDecorationSummaryBit`), so that
+    // looking up a decoration that isn't present doesn't need to
+    // walk the decoration list.
+    //
+    // The summary is maintained as decorations are inserted into
+    // and removed from their parent.
+    //
+    uint32_t decorationSummary : 8;
 
     UInt getOperandCount()
     {
         return operandCount;
     }
 
+    // A dense index for this instruction, assigned on demand by
+    // an `IRInstNumbering` (see `ir-inst-map.h`) so that passes
+    // can keep per-instruction state in flat side tables.
+    //
+    // The value is only meaningful to the numbering that assigned it.
+    // It occupies what would otherwise be padding ahead of the first
+    // pointer field, so it doesn't make `IRInst` any bigger.
+    uint32_t scratchIndex = 0;
+
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
@@ -260,6 +286,8 @@ struct IRInst
     template<typename T>
     T* findDecoration();
 
+    void _updateDecorationSummary();
+
     // The first use of this value (start of a linked list)
     IRUse*      firstUse = nullptr;
 
@@ -270,11 +298,17 @@ struct IRInst
     IRInst* getParent() { return parent; }
 
     // The next and previous instructions with the same parent
+    //
+    // Note: the `prev` link of the first decoration or child of
+    // an instruction refers to the *last* decoration or child
+    // (see `m_firstDecorationOrChild`), so code should use
+    // `getPrevInst()` rather than reading `prev` directly.
+    //
     IRInst*         next;
     IRInst*         prev;
 
     IRInst* getNextInst() { return next; }
-    IRInst* getPrevInst() { return prev; }
+    IRInst* getPrevInst() { return (parent && parent->m_firstDecorationOrChild == this) ? nullptr : prev; }
 
     // An instruction can have zero or more children, although
     // only certain instruction opcodes are allowed to have
@@ -293,22 +327,26 @@ struct IRInst
             getLastChild());
     }
 
-        /// A doubly-linked list containing any decorations and then any children of this instruction.
+        /// The first entry in a doubly-linked list containing any decorations and then any children of this instruction.
         ///
         /// We store both the decorations and children of an instruction
         /// in the same list, to conserve space in the instruction itself
         /// (rather than storing distinct lists for decorations and children).
         ///
+        /// For the same reason we don't store a pointer to the last entry
+        /// in the list. Instead, the `prev` link of the first entry (which
+        /// would otherwise always be null) refers to the last entry.
+        ///
         // Note: This field is *not* being declared `private` because doing so could
         // mess with our required memory layout, where `typeUse` below is assumed
         // to be the last field in `IRInst` and to come right before any additional
         // `IRUse` values that represent operands.
         //
-    IRInstListBase m_decorationsAndChildren;
+    IRInst* m_firstDecorationOrChild = nullptr;
 
-    IRInst* getFirstDecorationOrChild() { return m_decorationsAndChildren.first; }
-    IRInst* getLastDecorationOrChild()  { return m_decorationsAndChildren.last;  }
-    IRInstListBase getDecorationsAndChildren() { return m_decorationsAndChildren; }
+    IRInst* getFirstDecorationOrChild() { return m_firstDecorationOrChild; }
+    IRInst* getLastDecorationOrChild()  { return m_firstDecorationOrChild ? m_firstDecorationOrChild->prev : nullptr; }
+    IRInstListBase getDecorationsAndChildren() { return IRInstListBase(getFirstDecorationOrChild(), getLastDecorationOrChild()); }
 
     void removeAndDeallocateAllDecorationsAndChildren();
 
@@ -447,12 +485,45 @@ T* cast(IRInst* inst, T* /* */ = nullptr)
 
 // Now that `IRInst` is defined we can back-fill the definitions that need to access it.
 
+    /// Get the bit that represents decoration opcode `op` in `IRInst::decorationSummary`.
+    ///
+    /// There are only 8 bits, so only the decorations that are looked up most
+    /// often (on every instruction, or from many places) get a bit of their own.
+    /// All other decoration opcodes share the last bit.
+SLANG_FORCE_INLINE uint32_t getIRDecorationSummaryBit(IROp op)
+{
+    switch (op & kIROpMeta_PseudoOpMask)
+    {
+        case kIROp_ImportDecoration:        return 1 << 0;
+        case kIROp_ExportDecoration:        return 1 << 1;
+        case kIROp_LayoutDecoration:        return 1 << 2;
+        case kIROp_NameHintDecoration:      return 1 << 3;
+        case kIROp_TransitoryDecoration:    return 1 << 4;
+        case kIROp_KeepAliveDecoration:     return 1 << 5;
+        case kIROp_EntryPointDecoration:    return 1 << 6;
+        default:                            return 1 << 7;
+    }
+}
+
+    /// Get the union of the summary bits of the decoration opcodes accepted by `isa`.
+uint32_t calcIRDecorationSummaryMask(bool (*isa)(IROp op));
+
+SLANG_FORCE_INLINE bool isIRDecorationOp(IROp op)
+{
+    const int pseudoOp = op & kIROpMeta_PseudoOpMask;
+    return pseudoOp >= kIROp_FirstDecoration && pseudoOp <= kIROp_LastDecoration;
+}
+
 template<typename T>
 T* IRInst::findDecoration()
 {
-    for( auto decoration : getDecorations() )
+    static const uint32_t mask = calcIRDecorationSummaryMask(&T::isaImpl);
+    if( !(decorationSummary & mask) )
+        return nullptr;
+
+    for( auto inst = getFirstDecorationOrChild(); inst && isIRDecorationOp(inst->op); inst = inst->getNextInst() )
     {
-        if(auto match = as<T>(decoration))
+        if(auto match = as<T>(inst))
             return match;
     }
     return nullptr;
@@ -25,6 +25,7 @@
 
 #include "../core/basic.h"
 #include "ir-insts.h"
+#include "ir-inst-map.h"
 #include "syntax.h"
 #include "type-layout.h"
 #include "name.h"
@@ -462,7 +463,10 @@ struct IRTypeLegalizationContext
     // When inserting new parameters, put them before this one.
     IRParam* insertBeforeParam = nullptr;
 
-    Dictionary<IRInst*, LegalVal> mapValToLegalVal;
+    // Legalized values are stored in a side table indexed
+    // by a dense numbering of the instructions they replace.
+    IRInstNumbering instNumbering;
+    IRInstMap<LegalVal> mapValToLegalVal;
 
     IRVar* insertBeforeLocalVar = nullptr;
 
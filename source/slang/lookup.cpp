@@ -1,7 +1,10 @@
 // lookup.cpp
 #include "lookup.h"
+#include "compiler.h"
 #include "name.h"
 
+#include <mutex>
+
 namespace Slang {
 
 void checkDecl(SemanticsVisitor* visitor, Decl* decl);
@@ -35,12 +38,22 @@ void DoLocalLookupImpl(
 
 //
 
-void buildMemberDictionary(ContainerDecl* decl)
+void buildMemberDictionary(Session* session, ContainerDecl* decl)
 {
     // Don't rebuild if already built
-    if (decl->memberDictionaryIsValid)
+    if (decl->memberDictionaryIsValid.load(std::memory_order_acquire))
         return;
 
+    // More than one thread can look up members of the same container
+    // whilst function bodies are checked in parallel
+    std::unique_lock<std::mutex> lock;
+    if (session->memberDictionaryMutex)
+    {
+        lock = std::unique_lock<std::mutex>(*session->memberDictionaryMutex);
+        if (decl->memberDictionaryIsValid.load(std::memory_order_relaxed))
+            return;
+    }
+
     decl->memberDictionary.Clear();
     decl->transparentMembers.Clear();
 
@@ -77,7 +90,7 @@ void buildMemberDictionary(ContainerDecl* decl)
         decl->memberDictionary[name] = m.Ptr();
 
     }
-    decl->memberDictionaryIsValid = true;
+    decl->memberDictionaryIsValid.store(true, std::memory_order_release);
 }
 
 
@@ -306,9 +319,9 @@ void DoLocalLookupImpl(
     ContainerDecl* containerDecl = containerDeclRef.getDecl();
 
     // Ensure that the lookup dictionary in the container is up to date
-    if (!containerDecl->memberDictionaryIsValid)
+    if (!containerDecl->memberDictionaryIsValid.load(std::memory_order_acquire))
     {
-        buildMemberDictionary(containerDecl);
+        buildMemberDictionary(session, containerDecl);
     }
 
     // Look up the declarations with the chosen name in the container.
@@ -13,7 +13,7 @@ LookupResult refineLookup(LookupResult const& inResult, LookupMask mask);
 
 // Ensure that the dictionary for name-based member lookup has been
 // built for the given container declaration.
-void buildMemberDictionary(ContainerDecl* decl);
+void buildMemberDictionary(Session* session, ContainerDecl* decl);
 
 // Look up a name in the given scope, proceeding up through
 // parent scopes as needed.
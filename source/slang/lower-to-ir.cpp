@@ -5,9 +5,11 @@
 
 #include "check.h"
 #include "ir.h"
+#include "ir-compact.h"
 #include "ir-constexpr.h"
 #include "ir-insts.h"
 #include "ir-missing-return.h"
+#include "ir-pass-manager.h"
 #include "ir-sccp.h"
 #include "ir-ssa.h"
 #include "ir-validate.h"
@@ -5841,6 +5843,16 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
             getBuilder()->addSimpleDecoration<IREarlyDepthStencilDecoration>(irFunc);
         }
 
+        if (decl->FindModifier<ForceInlineAttribute>())
+        {
+            getBuilder()->addSimpleDecoration<IRForceInlineDecoration>(irFunc);
+        }
+
+        if (decl->FindModifier<NoInlineAttribute>())
+        {
+            getBuilder()->addSimpleDecoration<IRNoInlineDecoration>(irFunc);
+        }
+
         // For convenience, ensure that any additional global
         // values that were emitted while outputting the function
         // body appear before the function itself in the list
@@ -6232,6 +6244,19 @@ static void lowerProgramEntryPointToIR(
 
 
 
+}
+
+    /// Is `decl` a function whose body was never checked, because it wasn't reachable?
+static bool isUnreachableFunctionDecl(
+    Decl*   decl)
+{
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+
+    if (auto funcDecl = as<FunctionDeclBase>(decl))
+        return funcDecl->isBodyCheckDeferred;
+
+    return false;
 }
 
     /// Ensure that `decl` and all relevant declarations under it get emitted.
@@ -6239,6 +6264,12 @@ static void ensureAllDeclsRec(
     IRGenContext*   context,
     Decl*           decl)
 {
+    // When function body checking was deferred, only the reachable
+    // functions have been checked, and only they should be emitted.
+    //
+    if (isUnreachableFunctionDecl(decl))
+        return;
+
     ensureDecl(context, decl);
 
     // Note: We are checking here for aggregate type declarations, and
@@ -6334,23 +6365,44 @@ IRModule* generateIRForTranslationUnit(
 
     //      dumpIR(module);
 
+    // The passes are run through a pass manager, so that
+    // they can be timed and dumped individually.
+    IRPassManager passManager(compileRequest, module);
+
     // First, attempt to promote local variables to SSA
     // temporaries whenever possible.
-    constructSSA(module);
+    passManager.run("constructSSA.afterLowering", [&]() { constructSSA(module); });
 
     // Do basic constant folding and dead code elimination
     // using Sparse Conditional Constant Propagation (SCCP)
     //
-    applySparseConditionalConstantPropagation(module);
+    passManager.run("applySparseConditionalConstantPropagation.afterLowering", [&]() { applySparseConditionalConstantPropagation(module); });
 
     // Propagate `constexpr`-ness through the dataflow graph (and the
     // call graph) based on constraints imposed by different instructions.
-    propagateConstExpr(module, compileRequest->getSink());
+    passManager.run("propagateConstExpr", [&]() { propagateConstExpr(module, compileRequest->getSink()); });
 
     // TODO: give error messages if any `undefined` or
     // `unreachable` instructions remain.
 
-    checkForMissingReturns(module, compileRequest->getSink());
+    passManager.run("checkForMissingReturns", [&]() { checkForMissingReturns(module, compileRequest->getSink()); });
+
+    // The passes above remove instructions from the module, but the
+    // memory for them stays allocated for as long as the module
+    // does, which can be the lifetime of the whole `Linkage` for an
+    // imported module. If enough of the memory is wasted, we copy
+    // the module into a fresh arena.
+    //
+    // Note: this invalidates the caches of `sharedBuilder`, which
+    // must not be used to add to the module after this point.
+    //
+    passManager.run("compactIRModule", [&]()
+    {
+        if (compileRequest->shouldCompactIR)
+            compactIRModule(module);
+        else
+            compactIRModuleIfWasteful(module);
+    });
 
     // TODO: consider doing some more aggressive optimizations
     // (in particular specialization of generics) here, so
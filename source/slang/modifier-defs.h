@@ -431,6 +431,18 @@ SIMPLE_SYNTAX_CLASS(MutatingAttribute, Attribute)
 //
 SIMPLE_SYNTAX_CLASS(ReadNoneAttribute, Attribute)
 
+// A `[forceInline]` attribute, which indicates that calls to a
+// function should always be inlined into their caller by the
+// IR inlining pass, regardless of the size of the function.
+//
+SIMPLE_SYNTAX_CLASS(ForceInlineAttribute, Attribute)
+
+// A `[noinline]` attribute, which indicates that calls to a
+// function should never be inlined into their caller by the
+// IR inlining pass.
+//
+SIMPLE_SYNTAX_CLASS(NoInlineAttribute, Attribute)
+
 
 // HLSL modifiers for geometry shader input topology
 SIMPLE_SYNTAX_CLASS(HLSLGeometryShaderInputPrimitiveTypeModifier, Modifier)
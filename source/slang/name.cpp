@@ -16,6 +16,10 @@ UnownedStringSlice getUnownedStringSliceText(Name* name)
 
 Name* NamePool::getName(String const& text)
 {
+    std::unique_lock<std::mutex> lock;
+    if (rootPool->mutex)
+        lock = std::unique_lock<std::mutex>(*rootPool->mutex);
+
     RefPtr<Name> name;
     if (rootPool->names.TryGetValue(text, name))
         return name;
@@ -28,6 +32,10 @@ Name* NamePool::getName(String const& text)
 
 Name* NamePool::tryGetName(String const& text)
 {
+    std::unique_lock<std::mutex> lock;
+    if (rootPool->mutex)
+        lock = std::unique_lock<std::mutex>(*rootPool->mutex);
+
     RefPtr<Name> name;
     if (rootPool->names.TryGetValue(text, name))
         return name;
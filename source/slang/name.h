@@ -7,6 +7,8 @@
 
 #include "../core/basic.h"
 
+#include <mutex>
+
 namespace Slang {
 
 // The `Name` type is used to represent the name of a type, variable, etc.
@@ -48,6 +50,12 @@ struct RootNamePool
 {
     // The mapping from text strings to the corresponding name.
     Dictionary<String, RefPtr<Name> > names;
+
+    // Set to a mutex that is held while `names` is accessed, for as long
+    // as names are looked up from more than one thread (e.g., whilst
+    // function bodies are checked in parallel). Null otherwise, so that
+    // a serial compile doesn't take a lock.
+    std::mutex* mutex = nullptr;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -448,11 +448,41 @@ struct OptionsParser
                 {
                     flags |= SLANG_COMPILE_FLAG_NO_CODEGEN;
                 }
+                else if (argStr == "-lazy-function-bodies")
+                {
+                    flags |= SLANG_COMPILE_FLAG_LAZY_FUNCTION_BODIES;
+                }
+                else if (argStr == "-parallel-parse")
+                {
+                    flags |= SLANG_COMPILE_FLAG_PARALLEL_PARSE;
+                }
+                else if (argStr == "-parallel-check")
+                {
+                    flags |= SLANG_COMPILE_FLAG_PARALLEL_CHECK;
+                }
                 else if(argStr == "-dump-ir" )
                 {
                     requestImpl->getFrontEndReq()->shouldDumpIR = true;
                     requestImpl->getBackEndReq()->shouldDumpIR = true;
                 }
+                else if (argStr == "-dump-ir-after")
+                {
+                    String passName;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, passName));
+
+                    requestImpl->getFrontEndReq()->irPassNamesToDump.Add(passName);
+                    requestImpl->getBackEndReq()->irPassNamesToDump.Add(passName);
+                }
+                else if (argStr == "-time-passes")
+                {
+                    requestImpl->setRecordIRPassStats(true);
+                    requestImpl->shouldReportIRPassStats = true;
+                }
+                else if (argStr == "-trace-compile")
+                {
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, requestImpl->compileTracePath));
+                    requestImpl->setRecordCompileStats(true);
+                }
                 else if (argStr == "-serial-ir")
                 {
                     requestImpl->getFrontEndReq()->useSerialIRBottleneck = true;
@@ -461,6 +491,10 @@ struct OptionsParser
                 {
                     requestImpl->getSink()->flags |= DiagnosticSink::Flag::VerbosePath;
                 }
+                else if (argStr == "-compact-ir")
+                {
+                    requestImpl->getFrontEndReq()->shouldCompactIR = true;
+                }
                 else if (argStr == "-verify-debug-serial-ir")
                 {
                     requestImpl->getFrontEndReq()->verifyDebugSerialization = true;
@@ -477,6 +511,10 @@ struct OptionsParser
                 {
                     getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_PARAMETER_BLOCKS_USE_REGISTER_SPACES;
                 }
+                else if(argStr == "-no-inline" )
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_NO_INLINING;
+                }
                 else if (argStr == "-target")
                 {
                     String name;
@@ -1077,7 +1077,7 @@ namespace Slang
             member->ParentDecl = container.Ptr();
             container->Members.Add(member);
 
-            container->memberDictionaryIsValid = false;
+            container->memberDictionaryIsValid.store(false, std::memory_order_release);
         }
     }
 
@@ -194,8 +194,14 @@ struct Preprocessor
     // represent end-of-input situations.
     Token                                   endOfFileToken;
 
-        /// The linkage the provides the context for preprocessing
-    Linkage*                                linkage = nullptr;
+        /// The source manager that views of source files are created on
+    SourceManager*                          sourceManager = nullptr;
+
+        /// The pool that identifiers are looked up in
+    NamePool*                               namePool = nullptr;
+
+        /// The file system used to read `#include`d files
+    ISlangFileSystemExt*                    fileSystemExt = nullptr;
 
         /// The module, if any, that the preprocessed result will belong to
     Module*                                 parentModule = nullptr;
@@ -204,8 +210,8 @@ struct Preprocessor
     // stop them from being included again.
     HashSet<String>                         pragmaOnceUniqueIdentities;
 
-    NamePool* getNamePool() { return linkage->getNamePool(); }
-    SourceManager* getSourceManager() { return linkage->getSourceManager(); }
+    NamePool* getNamePool() { return namePool; }
+    SourceManager* getSourceManager() { return sourceManager; }
 };
 
 // Convenience routine to access the diagnostic sink
@@ -1582,10 +1588,9 @@ static SlangResult readFile(
     ISlangBlob**                    outBlob)
 {
     // The actual file loading will be handled by the file system
-    // associated with the parent linkage.
+    // we were given (normally that of the parent linkage).
     //
-    auto linkage = context->preprocessor->linkage;
-    auto fileSystemExt = linkage->getFileSystemExt();
+    auto fileSystemExt = context->preprocessor->fileSystemExt;
     SLANG_RETURN_ON_FAIL(fileSystemExt->loadFile(path.Buffer(), outBlob));
 
     // If we are running the preprocessor as part of compiling a
@@ -2253,10 +2258,33 @@ TokenList preprocessSource(
     Dictionary<String, String>  defines,
     Linkage*                    linkage,
     Module*                     parentModule)
+{
+    return preprocessSource(
+        file,
+        sink,
+        includeHandler,
+        defines,
+        linkage->getSourceManager(),
+        linkage->getNamePool(),
+        linkage->getFileSystemExt(),
+        parentModule);
+}
+
+TokenList preprocessSource(
+    SourceFile*                 file,
+    DiagnosticSink*             sink,
+    IncludeHandler*             includeHandler,
+    Dictionary<String, String>  defines,
+    SourceManager*              sourceManager,
+    NamePool*                   namePool,
+    ISlangFileSystemExt*        fileSystemExt,
+    Module*                     parentModule)
 {
     Preprocessor preprocessor;
     InitializePreprocessor(&preprocessor, sink);
-    preprocessor.linkage = linkage;
+    preprocessor.sourceManager = sourceManager;
+    preprocessor.namePool = namePool;
+    preprocessor.fileSystemExt = fileSystemExt;
     preprocessor.parentModule = parentModule;
 
     preprocessor.includeHandler = includeHandler;
@@ -2265,8 +2293,6 @@ TokenList preprocessSource(
         DefineMacro(&preprocessor, p.Key, p.Value);
     }
 
-    SourceManager* sourceManager = linkage->getSourceManager();
-
     SourceView* sourceView = sourceManager->createSourceView(file, nullptr);
 
     // create an initial input stream based on the provided buffer
@@ -11,6 +11,7 @@ class DiagnosticSink;
 class Linkage;
 class Module;
 class ModuleDecl;
+struct NamePool;
 
 // Callback interface for the preprocessor to use when looking
 // for files in `#include` directives.
@@ -33,6 +34,23 @@ TokenList preprocessSource(
     Linkage*                    linkage,
     Module*                     parentModule);
 
+// As above, but rather than using the source manager, name pool and file system of a
+// linkage, they are given explicitly. If `parentModule` is null the paths of `#include`d
+// files are not recorded anywhere; they can be found from the files on `sourceManager`.
+//
+// Preprocessing only touches the state that is passed in, so with a source manager, name
+// pool, sink and (thread safe) file system of its own, a translation unit can be
+// preprocessed on a thread of its own (see `FrontEndCompileRequest::parseAllTranslationUnits`).
+TokenList preprocessSource(
+    SourceFile*                 file,
+    DiagnosticSink*             sink,
+    IncludeHandler*             includeHandler,
+    Dictionary<String, String>  defines,
+    SourceManager*              sourceManager,
+    NamePool*                   namePool,
+    ISlangFileSystemExt*        fileSystemExt,
+    Module*                     parentModule);
+
 } // namespace Slang
 
 #endif
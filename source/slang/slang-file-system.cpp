@@ -504,4 +504,76 @@ SlangResult CacheFileSystem::getCanonicalPath(const char* path, ISlangBlob** out
     return SLANG_OK;
 }
 
-} 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! LockedFileSystem !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+// Copy a blob that was returned by the wrapped file system, so that the copy can be used without holding the mutex.
+// Must be called with the mutex held. The copy is a StringBlob, so that (like the blobs returned by the other file
+// systems) the contents are followed by a terminating 0.
+static SlangResult _copyLockedBlob(SlangResult res, ISlangBlob* blob, ISlangBlob** outBlob)
+{
+    if (SLANG_SUCCEEDED(res) && blob)
+    {
+        const char* chars = (const char*)blob->getBufferPointer();
+        *outBlob = StringUtil::createStringBlob(String(chars, chars + blob->getBufferSize())).detach();
+    }
+    return res;
+}
+
+ISlangUnknown* LockedFileSystem::getInterface(const Guid& guid)
+{
+    return _getInterface(this, guid);
+}
+
+SlangResult LockedFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    ComPtr<ISlangBlob> blob;
+    SlangResult res = m_fileSystem->loadFile(path, blob.writeRef());
+    return _copyLockedBlob(res, blob, outBlob);
+}
+
+SlangResult LockedFileSystem::getFileUniqueIdentity(const char* path, ISlangBlob** outUniqueIdentity)
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    ComPtr<ISlangBlob> blob;
+    SlangResult res = m_fileSystem->getFileUniqueIdentity(path, blob.writeRef());
+    return _copyLockedBlob(res, blob, outUniqueIdentity);
+}
+
+SlangResult LockedFileSystem::calcCombinedPath(SlangPathType fromPathType, const char* fromPath, const char* path, ISlangBlob** pathOut)
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    ComPtr<ISlangBlob> blob;
+    SlangResult res = m_fileSystem->calcCombinedPath(fromPathType, fromPath, path, blob.writeRef());
+    return _copyLockedBlob(res, blob, pathOut);
+}
+
+SlangResult LockedFileSystem::getPathType(const char* path, SlangPathType* outPathType)
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    return m_fileSystem->getPathType(path, outPathType);
+}
+
+SlangResult LockedFileSystem::getSimplifiedPath(const char* path, ISlangBlob** outSimplifiedPath)
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    ComPtr<ISlangBlob> blob;
+    SlangResult res = m_fileSystem->getSimplifiedPath(path, blob.writeRef());
+    return _copyLockedBlob(res, blob, outSimplifiedPath);
+}
+
+SlangResult LockedFileSystem::getCanonicalPath(const char* path, ISlangBlob** outCanonicalPath)
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    ComPtr<ISlangBlob> blob;
+    SlangResult res = m_fileSystem->getCanonicalPath(path, blob.writeRef());
+    return _copyLockedBlob(res, blob, outCanonicalPath);
+}
+
+void LockedFileSystem::clearCache()
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    m_fileSystem->clearCache();
+}
+
+}
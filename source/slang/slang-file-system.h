@@ -8,6 +8,8 @@
 #include "../core/slang-string-util.h"
 #include "../core/dictionary.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -199,6 +201,64 @@ protected:
     ComPtr<ISlangFileSystemExt> m_fileSystemExt;        ///< Optionally set -> if nullptr will fall back on the m_fileSystem and emulate all the other methods of ISlangFileSystemExt
 };
 
+/* Wraps an ISlangFileSystemExt so that it can be used from more than one thread.
+
+Calls to the wrapped file system are made one at a time, whilst holding a mutex that is shared by all of the wrappers
+of that file system. Any blob returned by the wrapped file system is copied (and the original released) whilst the
+mutex is held. That way reference counts on blobs that the wrapped file system may also be holding (in a cache, say)
+are never changed concurrently.
+
+The reference count of the wrapper itself is not thread safe, so each thread should use its own wrapper. The wrapped
+file system is not retained - it must outlive the wrapper. */
+class LockedFileSystem : public ISlangFileSystemExt, public RefObject
+{
+public:
+    // ISlangUnknown
+    SLANG_REF_OBJECT_IUNKNOWN_ALL
+
+    // ISlangFileSystem
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(
+        char const*     path,
+        ISlangBlob**    outBlob) SLANG_OVERRIDE;
+
+    // ISlangFileSystemExt
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getFileUniqueIdentity(
+        const char* path,
+        ISlangBlob** outUniqueIdentity) SLANG_OVERRIDE;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL calcCombinedPath(
+        SlangPathType fromPathType,
+        const char* fromPath,
+        const char* path,
+        ISlangBlob** pathOut) SLANG_OVERRIDE;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPathType(
+        const char* path,
+        SlangPathType* outPathType) SLANG_OVERRIDE;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getSimplifiedPath(
+        const char* path,
+        ISlangBlob** outSimplifiedPath) SLANG_OVERRIDE;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getCanonicalPath(
+        const char* path,
+        ISlangBlob** outCanonicalPath) SLANG_OVERRIDE;
+
+    virtual SLANG_NO_THROW void SLANG_MCALL clearCache() SLANG_OVERRIDE;
+
+        /// Ctor. All the wrappers of `fileSystem` must use the same `mutex`.
+    LockedFileSystem(ISlangFileSystemExt* fileSystem, std::mutex* mutex):
+        m_fileSystem(fileSystem),
+        m_mutex(mutex)
+    {}
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid);
+
+    ISlangFileSystemExt* m_fileSystem;                  ///< The wrapped file system. Not retained, as that would change its reference count.
+    std::mutex* m_mutex;                                ///< Held for the duration of every call to m_fileSystem
+};
+
 }
 
 #endif // SLANG_FILE_SYSTEM_H_INCLUDED
@@ -3,6 +3,7 @@
 #include "../core/slang-io.h"
 #include "../core/slang-string-util.h"
 #include "../core/slang-shared-library.h"
+#include "../core/slang-thread-pool.h"
 
 #include "parameter-binding.h"
 #include "lower-to-ir.h"
@@ -17,11 +18,15 @@
 
 #include "source-loc.h"
 
+#include "ir-link.h"
 #include "ir-serialize.h"
 
 // Used to print exception type names in internal-compiler-error messages
 #include <typeinfo>
 
+#include <exception>
+#include <mutex>
+
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
@@ -90,14 +95,21 @@ Session::Session()
     addBuiltinSource(hlslLanguageScope, "hlsl", getHLSLLibraryCode());
 }
 
+ThreadPool* Session::getThreadPool()
+{
+    if (!m_threadPool)
+        m_threadPool = new ThreadPool(ThreadPool::getDefaultThreadCount());
+    return m_threadPool;
+}
+
 struct IncludeHandlerImpl : IncludeHandler
 {
-    Linkage*    linkage;
+    ISlangFileSystemExt*    fileSystemExt;
     SearchDirectoryList*    searchDirectories;
 
     ISlangFileSystemExt* _getFileSystemExt()
     {
-        return linkage->getFileSystemExt();
+        return fileSystemExt;
     }
 
     SlangResult _findFile(SlangPathType fromPathType, const String& fromPath, const String& path, PathInfo& pathInfoOut)
@@ -582,6 +594,44 @@ FrontEndCompileRequest::FrontEndCompileRequest(
 {
 }
 
+    /// Get the scope that a translation unit in `language` is parsed in
+static RefPtr<Scope> _getLanguageScope(Session* session, SourceLanguage language)
+{
+    switch (language)
+    {
+    case SourceLanguage::HLSL:
+        return session->hlslLanguageScope;
+
+    case SourceLanguage::Slang:
+    default:
+        return session->slangLanguageScope;
+    }
+}
+
+    /// Get all the preprocessor definitions that apply to `translationUnit`
+static void _getPreprocessorDefinitions(
+    FrontEndCompileRequest*     compileRequest,
+    TranslationUnitRequest*     translationUnit,
+    Dictionary<String, String>& outDefinitions)
+{
+    for(auto& def : compileRequest->getLinkage()->preprocessorDefinitions)
+        outDefinitions.Add(def.Key, def.Value);
+    for(auto& def : compileRequest->preprocessorDefinitions)
+        outDefinitions.Add(def.Key, def.Value);
+    for(auto& def : translationUnit->preprocessorDefinitions)
+        outDefinitions.Add(def.Key, def.Value);
+}
+
+    /// Create the (initially empty) module declaration that `translationUnit` is parsed into
+static void _createModuleDecl(TranslationUnitRequest* translationUnit)
+{
+    auto module = translationUnit->getModule();
+    RefPtr<ModuleDecl> translationUnitSyntax = new ModuleDecl();
+    translationUnitSyntax->nameAndLoc.name = translationUnit->moduleName;
+    translationUnitSyntax->module = module;
+    module->setModuleDecl(translationUnitSyntax);
+}
+
 void FrontEndCompileRequest::parseTranslationUnit(
     TranslationUnitRequest* translationUnit)
 {
@@ -596,46 +646,34 @@ void FrontEndCompileRequest::parseTranslationUnit(
     // If searchDirectories.parent pointed to the one in the Linkage would mean linkage paths
     // would be checked too (after those on the FrontEndCompileRequest). 
 
-    includeHandler.linkage = linkage;
+    includeHandler.fileSystemExt = linkage->getFileSystemExt();
     includeHandler.searchDirectories = &linkage->searchDirectories;
 
-    RefPtr<Scope> languageScope;
-    switch (translationUnit->sourceLanguage)
-    {
-    case SourceLanguage::HLSL:
-        languageScope = getSession()->hlslLanguageScope;
-        break;
-
-    case SourceLanguage::Slang:
-    default:
-        languageScope = getSession()->slangLanguageScope;
-        break;
-    }
+    RefPtr<Scope> languageScope = _getLanguageScope(getSession(), translationUnit->sourceLanguage);
 
     Dictionary<String, String> combinedPreprocessorDefinitions;
-    for(auto& def : getLinkage()->preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
-    for(auto& def : preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
-    for(auto& def : translationUnit->preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
+    _getPreprocessorDefinitions(this, translationUnit, combinedPreprocessorDefinitions);
 
     auto module = translationUnit->getModule();
-    RefPtr<ModuleDecl> translationUnitSyntax = new ModuleDecl();
-    translationUnitSyntax->nameAndLoc.name = translationUnit->moduleName;
-    translationUnitSyntax->module = module;
-    module->setModuleDecl(translationUnitSyntax);
+    _createModuleDecl(translationUnit);
 
     for (auto sourceFile : translationUnit->getSourceFiles())
     {
-        auto tokens = preprocessSource(
-            sourceFile,
-            getSink(),
-            &includeHandler,
-            combinedPreprocessorDefinitions,
-            getLinkage(),
-            module);
+        TokenList tokens;
+        {
+            CompilePhaseScope phaseScope(compileStats, "preprocess");
+            tokens = preprocessSource(
+                sourceFile,
+                getSink(),
+                &includeHandler,
+                combinedPreprocessorDefinitions,
+                getLinkage(),
+                module);
+        }
+        if (compileStats)
+            compileStats->addToCounter("tokens", tokens.mTokens.Count());
 
+        CompilePhaseScope phaseScope(compileStats, "parse");
         parseSourceFile(
             translationUnit,
             tokens,
@@ -644,14 +682,311 @@ void FrontEndCompileRequest::parseTranslationUnit(
     }
 }
 
+    /// An `ISlangWriter` that keeps each diagnostic written to a `DiagnosticSink`, so that
+    /// they can be passed on to another sink later.
+class DiagnosticCaptureWriter : public AppendBufferWriter
+{
+public:
+    typedef AppendBufferWriter Super;
+
+    // ISlangWriter
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL write(const char* chars, size_t numChars) SLANG_OVERRIDE
+    {
+        m_diagnostics.Add(String(chars, chars + numChars));
+        return SLANG_OK;
+    }
+
+    DiagnosticCaptureWriter()
+        : Super(WriterFlag::IsStatic)
+    {}
+
+    List<String> m_diagnostics;
+};
+
+    /// Everything needed to preprocess one translation unit on a worker thread (see
+    /// `FrontEndCompileRequest::parseAllTranslationUnits`).
+    ///
+    /// A worker only touches the state of its own task. Anything the task needs from the
+    /// compile request is copied when the task is set up (on the main thread), including
+    /// strings, so no representation is shared with the main thread.
+struct PreprocessTask : public RefObject
+{
+        /// The result of preprocessing one of the source files of the translation unit
+    struct FileResult
+    {
+        TokenList tokens;
+        UInt diagnosticCount = 0;       ///< The number of diagnostics written up to the end of the file
+        int errorCount = 0;             ///< The error count of the sink at the end of the file
+    };
+
+    SourceManager sourceManager;
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    DiagnosticCaptureWriter diagnosticWriter;
+    DiagnosticSink sink;
+    ComPtr<ISlangFileSystemExt> fileSystemExt;
+    SearchDirectoryList searchDirectories;
+    IncludeHandlerImpl includeHandler;
+    Dictionary<String, String> preprocessorDefinitions;
+
+    List<SourceFile*> sourceFiles;                          ///< Copies (on sourceManager) of the source files of the translation unit
+    Dictionary<SourceFile*, SourceFile*> fileReplacements;  ///< Maps each copy to the source file it is a copy of
+
+    List<FileResult> fileResults;                           ///< A result for each source file preprocessed
+    std::exception_ptr exception;                           ///< Set if preprocessing threw an exception
+};
+
+    /// Make a copy of `str` that doesn't share its representation (and so its reference count)
+static String _cloneString(String const& str)
+{
+    return String(str.getUnownedSlice());
+}
+
+static PathInfo _clonePathInfo(PathInfo const& pathInfo)
+{
+    PathInfo clone;
+    clone.type = pathInfo.type;
+    clone.foundPath = _cloneString(pathInfo.foundPath);
+    clone.uniqueIdentity = _cloneString(pathInfo.uniqueIdentity);
+    return clone;
+}
+
+    /// Runs on a worker thread
+static void _preprocessTask(PreprocessTask* task)
+{
+    try
+    {
+        for (auto sourceFile : task->sourceFiles)
+        {
+            PreprocessTask::FileResult result;
+            result.tokens = preprocessSource(
+                sourceFile,
+                &task->sink,
+                &task->includeHandler,
+                task->preprocessorDefinitions,
+                &task->sourceManager,
+                &task->namePool,
+                task->fileSystemExt,
+                nullptr);
+            result.diagnosticCount = task->diagnosticWriter.m_diagnostics.Count();
+            result.errorCount = task->sink.GetErrorCount();
+            task->fileResults.Add(result);
+        }
+    }
+    catch (...)
+    {
+        task->exception = std::current_exception();
+    }
+}
+
+    /// Move `tokens` from the locations and names of a task to those of the linkage
+static void _adoptTokens(
+    TokenList&                  tokens,
+    Int                         locOffset,
+    NamePool*                   namePool,
+    Dictionary<Name*, Name*>&   ioNameMap)
+{
+    for (auto& token : tokens.mTokens)
+    {
+        if (token.loc.isValid())
+        {
+            token.loc = token.loc + locOffset;
+        }
+
+        // Only the value of an identifier is used, which is its name
+        if (token.type == TokenType::Identifier && token.ptrValue)
+        {
+            Name* name = (Name*)token.ptrValue;
+            Name* adoptedName = nullptr;
+            if (!ioNameMap.TryGetValue(name, adoptedName))
+            {
+                adoptedName = namePool->getName(name->text);
+                ioNameMap.Add(name, adoptedName);
+            }
+            token.ptrValue = adoptedName;
+        }
+    }
+}
+
+    /// Pass on the diagnostics in [startIndex, endIndex) that were captured by a task to `sink`
+static void _replayDiagnostics(PreprocessTask* task, UInt startIndex, UInt endIndex, DiagnosticSink* sink)
+{
+    for (UInt i = startIndex; i < endIndex; ++i)
+    {
+        sink->diagnoseRaw(Severity::Note, task->diagnosticWriter.m_diagnostics[i].getUnownedSlice());
+    }
+}
+
+void FrontEndCompileRequest::parseAllTranslationUnitsInParallel()
+{
+    auto linkage = getLinkage();
+    auto sink = getSink();
+
+    // Set up a task for each translation unit. Each gets its own source manager,
+    // name pool and sink, and its own wrapper of the file system, which makes
+    // calls to it one at a time.
+    std::mutex fileSystemMutex;
+
+    List<RefPtr<PreprocessTask>> tasks;
+    List<PreprocessTask*> rawTasks;
+    for (auto& translationUnit : translationUnits)
+    {
+        RefPtr<PreprocessTask> task = new PreprocessTask;
+
+        task->fileSystemExt = new LockedFileSystem(linkage->getFileSystemExt(), &fileSystemMutex);
+        task->sourceManager.initialize(nullptr, task->fileSystemExt);
+        task->namePool.setRootNamePool(&task->rootNamePool);
+
+        task->sink.sourceManager = &task->sourceManager;
+        task->sink.writer = &task->diagnosticWriter;
+        task->sink.flags = sink->flags;
+
+        for (auto searchDirectories = &linkage->searchDirectories; searchDirectories; searchDirectories = searchDirectories->parent)
+        {
+            for (auto& searchDirectory : searchDirectories->searchDirectories)
+                task->searchDirectories.searchDirectories.Add(SearchDirectory(_cloneString(searchDirectory.path)));
+        }
+
+        task->includeHandler.fileSystemExt = task->fileSystemExt;
+        task->includeHandler.searchDirectories = &task->searchDirectories;
+
+        // Copying the dictionary keeps its order, and so the order macros are defined in
+        _getPreprocessorDefinitions(this, translationUnit, task->preprocessorDefinitions);
+        for (auto& def : task->preprocessorDefinitions)
+        {
+            def.Key = _cloneString(def.Key);
+            def.Value = _cloneString(def.Value);
+        }
+
+        for (auto sourceFile : translationUnit->getSourceFiles())
+        {
+            SourceFile* copy = task->sourceManager.createSourceFileWithBlob(
+                _clonePathInfo(sourceFile->getPathInfo()),
+                sourceFile->getContentBlob());
+            task->sourceFiles.Add(copy);
+            task->fileReplacements.Add(copy, sourceFile);
+        }
+
+        tasks.Add(task);
+        rawTasks.Add(task);
+    }
+
+    {
+        CompilePhaseScope phaseScope(compileStats, "preprocess");
+
+        getSession()->getThreadPool()->runTasks(rawTasks.Count(), [&](UInt taskIndex) { _preprocessTask(rawTasks[taskIndex]); });
+    }
+
+    // Merge the results in translation unit order, parsing each translation unit
+    // as we go. Everything is done in the same order as by `parseTranslationUnit`.
+    auto sourceManager = getSourceManager();
+    auto namePool = getNamePool();
+
+    for (UInt i = 0; i < tasks.Count(); ++i)
+    {
+        auto translationUnit = translationUnits[i];
+        auto task = tasks[i];
+        auto module = translationUnit->getModule();
+
+        // A file that was loaded for an `#include` is a dependency of the module,
+        // unless the linkage already had the file loaded.
+        for (auto sourceFile : task->sourceManager.getSourceFiles())
+        {
+            const PathInfo& pathInfo = sourceFile->getPathInfo();
+            if (pathInfo.hasUniqueIdentity() &&
+                task->sourceManager.findSourceFile(pathInfo.uniqueIdentity) == sourceFile &&
+                !sourceManager->findSourceFileRecursively(pathInfo.uniqueIdentity))
+            {
+                module->addFilePathDependency(pathInfo.foundPath);
+            }
+        }
+
+        const Int locOffset = sourceManager->adoptSourceManager(&task->sourceManager, task->fileReplacements);
+        Dictionary<Name*, Name*> nameMap;
+
+        RefPtr<Scope> languageScope = _getLanguageScope(getSession(), translationUnit->sourceLanguage);
+        _createModuleDecl(translationUnit);
+
+        UInt diagnosticIndex = 0;
+        int errorCount = 0;
+        for (auto& fileResult : task->fileResults)
+        {
+            _replayDiagnostics(task, diagnosticIndex, fileResult.diagnosticCount, sink);
+            sink->errorCount += fileResult.errorCount - errorCount;
+            diagnosticIndex = fileResult.diagnosticCount;
+            errorCount = fileResult.errorCount;
+
+            _adoptTokens(fileResult.tokens, locOffset, namePool, nameMap);
+            if (compileStats)
+                compileStats->addToCounter("tokens", fileResult.tokens.mTokens.Count());
+
+            CompilePhaseScope phaseScope(compileStats, "parse");
+            parseSourceFile(
+                translationUnit,
+                fileResult.tokens,
+                sink,
+                languageScope);
+        }
+
+        // If preprocessing stopped with an exception, we stop at the same point
+        // that parsing serially would
+        if (task->exception)
+        {
+            _replayDiagnostics(task, diagnosticIndex, task->diagnosticWriter.m_diagnostics.Count(), sink);
+            sink->errorCount += task->sink.GetErrorCount() - errorCount;
+            std::rethrow_exception(task->exception);
+        }
+    }
+}
+
 RefPtr<Program> createUnspecializedProgram(
         FrontEndCompileRequest* compileRequest);
 
 RefPtr<Program> createSpecializedProgram(
     EndToEndCompileRequest* endToEndReq);
 
+void FrontEndCompileRequest::parseAllTranslationUnits()
+{
+    // Each translation unit gets its own `Preprocessor`, `Lexer`
+    // and `Parser`, but parsing mutates state shared across
+    // translation units:
+    //
+    // * The `SourceManager` hands out `SourceLoc` ranges in the
+    //   order that files are opened, so that order determines the
+    //   locations recorded in the AST (and any serialized IR).
+    //
+    // * Every identifier is interned in the shared `NamePool`, and
+    //   name identity is by `Name*`.
+    //
+    // * Diagnostics are written to a single `DiagnosticSink`, in
+    //   the order they are produced.
+    //
+    // * The parser links new scopes to the shared language scopes.
+    //
+    // With `SLANG_COMPILE_FLAG_PARALLEL_PARSE` the translation units
+    // are preprocessed (and lexed) in parallel, each into a source
+    // manager, name pool and sink of its own. The results are then
+    // merged in translation unit order - the locations are moved to
+    // where they would have been allocated, names are looked up
+    // again, and diagnostics are passed on - and parsed, so the
+    // result is the same as that of the serial loop.
+    //
+    if ((compileFlags & SLANG_COMPILE_FLAG_PARALLEL_PARSE) && translationUnits.Count() > 1)
+    {
+        parseAllTranslationUnitsInParallel();
+        return;
+    }
+
+    for (auto& translationUnit : translationUnits)
+    {
+        parseTranslationUnit(translationUnit.Ptr());
+    }
+}
+
 void FrontEndCompileRequest::checkAllTranslationUnits()
 {
+    CompilePhaseScope phaseScope(compileStats, "check");
+
     // Iterate over all translation units and
     // apply the semantic checking logic.
     for( auto& translationUnit : translationUnits )
@@ -678,41 +1013,66 @@ void FrontEndCompileRequest::generateIR()
         // * it can generate diagnostics
 
         /// Generate IR for translation unit
-        RefPtr<IRModule> irModule(generateIRForTranslationUnit(translationUnit));
+        RefPtr<IRModule> irModule;
+        {
+            CompilePhaseScope phaseScope(compileStats, "lower");
+            irModule = generateIRForTranslationUnit(translationUnit);
+        }
+        if (compileStats)
+            compileStats->addToCounter("irInsts", countIRInsts(irModule));
 
         if (verifyDebugSerialization)
         {
-            // Verify debug information
-            if (SLANG_FAILED(IRSerialUtil::verifySerialize(irModule, getSession(), getSourceManager(), IRSerialBinary::CompressionType::None, IRSerialWriter::OptionFlag::DebugInfo)))
+            // Verify debug information, with each of the ways the serialized data can be compressed
+            const IRSerialBinary::CompressionType compressionTypes[] =
+            {
+                IRSerialBinary::CompressionType::None,
+                IRSerialBinary::CompressionType::VariableByteLite,
+                IRSerialBinary::CompressionType::LZ,
+            };
+            for (auto compressionType : compressionTypes)
             {
-                getSink()->diagnose(irModule->moduleInst->sourceLoc, Diagnostics::serialDebugVerificationFailed);
+                if (SLANG_FAILED(IRSerialUtil::verifySerialize(irModule, getSession(), getSourceManager(), compressionType, IRSerialWriter::OptionFlag::DebugInfo)))
+                {
+                    getSink()->diagnose(irModule->moduleInst->sourceLoc, Diagnostics::serialDebugVerificationFailed);
+                    break;
+                }
             }
         }
 
         if (useSerialIRBottleneck)
         {              
-            IRSerialData serialData;
+            ComPtr<ISlangBlob> serialBlob;
             {
                 // Write IR out to serialData - copying over SourceLoc information directly
+                IRSerialData serialData;
                 IRSerialWriter writer;
                 writer.write(irModule, getSourceManager(), IRSerialWriter::OptionFlag::RawSourceLocation, &serialData);
 
                 // Destroy irModule such that memory can be used for newly constructed read irReadModule  
                 irModule = nullptr;
+
+                // Write uncompressed, so that the serialized IR can be used in place
+                MemoryStream memoryStream(FileAccess::Write);
+                IRSerialWriter::writeStream(serialData, IRSerialBinary::CompressionType::None, &memoryStream);
+                serialBlob = createRawBlob(memoryStream.m_contents.begin(), memoryStream.m_contents.Count());
             }
-            RefPtr<IRModule> irReadModule;
+
+            // The global values are read back from the blob as the linker asks for them
+            RefPtr<IRSerialLazyModule> lazyIRModule = new IRSerialLazyModule();
+            if (SLANG_FAILED(lazyIRModule->init(getSession(), serialBlob)))
             {
-                // Read IR back from serialData
-                IRSerialReader reader;
-                reader.read(serialData, getSession(), nullptr, irReadModule);
+                SLANG_UNEXPECTED("unable to read serialized IR");
             }
 
-            // Set irModule to the read module
-            irModule = irReadModule;
+            // Set the module on the translation unit
+            translationUnit->getModule()->setLazyIRModule(lazyIRModule);
+        }
+        else
+        {
+            // Set the module on the translation unit
+            translationUnit->getModule()->setIRModule(irModule);
         }
-
-        // Set the module on the translation unit
-        translationUnit->getModule()->setIRModule(irModule);
     }
 }
 
@@ -761,10 +1121,7 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
 
 
     // Parse everything from the input files requested
-    for (auto& translationUnit : translationUnits)
-    {
-        parseTranslationUnit(translationUnit.Ptr());
-    }
+    parseAllTranslationUnits();
     if (getSink()->GetErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -931,11 +1288,78 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
 // Act as expected of the API-based compiler
 SlangResult EndToEndCompileRequest::executeActions()
 {
-    SlangResult res = executeActionsInner();
+    SlangResult res = SLANG_OK;
+    {
+        CompilePhaseScope phaseScope(getCompileStats(), "compile");
+        res = executeActionsInner();
+    }
+
+    if (compileTracePath.Length() != 0 && getCompileStats())
+    {
+        StringBuilder trace;
+        getCompileStats()->appendChromeTrace(trace);
+
+        FILE* file = fopen(compileTracePath.Buffer(), "w");
+        if (!file || fwrite(trace.Buffer(), trace.Length(), 1, file) != 1)
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, compileTracePath);
+        }
+        if (file)
+            fclose(file);
+    }
+
+    if (shouldReportIRPassStats)
+    {
+        List<IRPassStats> stats;
+        getIRPassStats(stats);
+
+        StringBuilder report;
+        appendIRPassStatsReport(stats, report);
+
+        DiagnosticSinkWriter writer(getSink());
+        writer.write(report.Buffer(), report.Length());
+    }
+
     mDiagnosticOutput = getSink()->outputBuffer.ProduceString();
     return res;
 }
 
+void EndToEndCompileRequest::setRecordIRPassStats(bool enable)
+{
+    getFrontEndReq()->shouldRecordIRPassStats = enable;
+    getBackEndReq()->shouldRecordIRPassStats = enable;
+}
+
+void EndToEndCompileRequest::getIRPassStats(List<IRPassStats>& outStats)
+{
+    outStats.AddRange(getFrontEndReq()->irPassStats);
+    outStats.AddRange(getBackEndReq()->irPassStats);
+}
+
+void EndToEndCompileRequest::setRecordCompileStats(bool enable)
+{
+    if (enable && !m_compileStats)
+        m_compileStats = new CompileStats();
+    else if (!enable)
+        m_compileStats = nullptr;
+
+    getFrontEndReq()->compileStats = m_compileStats;
+    getBackEndReq()->compileStats = m_compileStats;
+}
+
+UInt EndToEndCompileRequest::getIRPassStatCount()
+{
+    return getFrontEndReq()->irPassStats.Count() + getBackEndReq()->irPassStats.Count();
+}
+
+IRPassStats const& EndToEndCompileRequest::getIRPassStat(UInt index)
+{
+    auto& frontEndStats = getFrontEndReq()->irPassStats;
+    if (index < frontEndStats.Count())
+        return frontEndStats[index];
+    return getBackEndReq()->irPassStats[index - frontEndStats.Count()];
+}
+
 int FrontEndCompileRequest::addTranslationUnit(SourceLanguage language, Name* moduleName)
 {
     UInt result = translationUnits.Count();
@@ -1242,7 +1666,7 @@ RefPtr<Module> Linkage::findOrImportModule(
     // using our ordinary include-handling logic.
 
     IncludeHandlerImpl includeHandler;
-    includeHandler.linkage = this;
+    includeHandler.fileSystemExt = getFileSystemExt();
     includeHandler.searchDirectories = &searchDirectories;
 
     // Get the original path info
@@ -1361,6 +1785,12 @@ void Module::addFilePathDependency(String const& path)
     m_filePathDependencyList.addDependency(path);
 }
 
+void Module::setLazyIRModule(IRSerialLazyModule* lazyIRModule)
+{
+    m_lazyIRModule = lazyIRModule;
+    m_irModule = lazyIRModule->getModule();
+}
+
 // Program
 
 Program::Program(Linkage* linkage)
@@ -1426,6 +1856,17 @@ TargetProgram::TargetProgram(
     m_entryPointResults.SetSize(program->getEntryPoints().Count());
 }
 
+IRSpecializationCache* TargetProgram::getOrCreateSpecializationCache(CodeGenTarget target)
+{
+    if(!m_specializationCache)
+    {
+        m_specializationCache = new IRSpecializationCache();
+        m_specializationCache->target = target;
+    }
+    SLANG_ASSERT(m_specializationCache->target == target);
+    return m_specializationCache;
+}
+
 //
 
 void DiagnosticSink::noteInternalErrorLoc(SourceLoc const& loc)
@@ -1570,6 +2011,8 @@ Session::~Session()
 
     destroyTypeCheckingCache();
 
+    delete m_threadPool;
+
     builtinTypes = decltype(builtinTypes)();
     // destroy modules next
     loadedModuleCode = decltype(loadedModuleCode)();
@@ -1748,6 +2191,20 @@ SLANG_API void spSetDumpIntermediates(
     convert(request)->getBackEndReq()->shouldDumpIntermediates = enable != 0;
 }
 
+SLANG_API void spSetRecordIRPassStats(
+    SlangCompileRequest*    request,
+    int                     enable)
+{
+    convert(request)->setRecordIRPassStats(enable != 0);
+}
+
+SLANG_API void spSetRecordCompileStats(
+    SlangCompileRequest*    request,
+    int                     enable)
+{
+    convert(request)->setRecordCompileStats(enable != 0);
+}
+
 SLANG_API void spSetLineDirectiveMode(
     SlangCompileRequest*    request,
     SlangLineDirectiveMode  mode)
@@ -2241,6 +2698,55 @@ spGetDependencyFilePath(
     return program->getFilePathDependencies()[index].begin();
 }
 
+SLANG_API int
+spGetIRPassStatCount(
+    SlangCompileRequest*    request)
+{
+    if(!request) return 0;
+    auto req = convert(request);
+    return (int) req->getIRPassStatCount();
+}
+
+SLANG_API SlangResult
+spGetIRPassStat(
+    SlangCompileRequest*    request,
+    int                     index,
+    SlangIRPassStat*        outStat)
+{
+    if(!request || !outStat) return SLANG_E_INVALID_ARG;
+    auto req = convert(request);
+
+    if(index < 0 || Slang::UInt(index) >= req->getIRPassStatCount())
+        return SLANG_E_INVALID_ARG;
+
+    // The name is owned by the request, and so
+    // lives as long as the request does.
+    auto& passStats = req->getIRPassStat(Slang::UInt(index));
+    outStat->passName = passStats.passName.Buffer();
+    outStat->timeInSeconds = passStats.timeInSeconds;
+    outStat->instCountBefore = passStats.instCountBefore;
+    outStat->instCountAfter = passStats.instCountAfter;
+    outStat->memoryUsedBefore = passStats.memoryUsedBefore;
+    outStat->memoryUsedAfter = passStats.memoryUsedAfter;
+    return SLANG_OK;
+}
+
+SLANG_API SlangResult
+spGetCompileStats(
+    SlangCompileRequest*    request,
+    SlangCompileStats*      outStats)
+{
+    if(!request || !outStats) return SLANG_E_INVALID_ARG;
+    auto req = convert(request);
+
+    auto compileStats = req->getCompileStats();
+    if(!compileStats)
+        return SLANG_FAIL;
+
+    compileStats->getStats(outStats);
+    return SLANG_OK;
+}
+
 SLANG_API int
 spGetTranslationUnitCount(
     SlangCompileRequest*    request)
@@ -202,6 +202,8 @@ void SourceFile::setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets)
 {
     m_lineBreakOffsets.Clear();
     m_lineBreakOffsets.AddRange(offsets, numOffsets);
+    // With no offsets, they are calculated on the first request instead
+    m_lineBreakOffsetsAreValid.store(numOffsets > 0, std::memory_order_release);
 }
 
 const List<uint32_t>& SourceFile::getLineBreakOffsets()
@@ -209,7 +211,13 @@ const List<uint32_t>& SourceFile::getLineBreakOffsets()
     // We now have a raw input file that we can search for line breaks.
     // We obviously don't want to do a linear scan over and over, so we will
     // cache an array of line break locations in the file.
-    if (m_lineBreakOffsets.Count() == 0)
+    if (m_lineBreakOffsetsAreValid.load(std::memory_order_acquire))
+    {
+        return m_lineBreakOffsets;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lineBreakOffsetsMutex);
+    if (!m_lineBreakOffsetsAreValid.load(std::memory_order_relaxed))
     {
         UnownedStringSlice content = getContent();
 
@@ -250,6 +258,8 @@ const List<uint32_t>& SourceFile::getLineBreakOffsets()
         // break, because otherwise we would report errors like
         // "end of file inside string literal" with a line number
         // that points at a line that doesn't exist.
+
+        m_lineBreakOffsetsAreValid.store(true, std::memory_order_release);
     }
 
     return m_lineBreakOffsets;
@@ -384,6 +394,90 @@ SourceManager::~SourceManager()
     {
         delete item;
     }
+
+    for (auto arena : m_adoptedMemoryArenas)
+    {
+        delete arena;
+    }
+}
+
+Int SourceManager::adoptSourceManager(SourceManager* other, const Dictionary<SourceFile*, SourceFile*>& fileReplacements)
+{
+    SLANG_ASSERT(other != this && other->m_parent == nullptr);
+
+    // The locations of `other` go directly after the ones allocated so far
+    const Int offset = Int(m_nextLoc.getRaw()) - Int(other->m_startLoc.getRaw());
+
+    // Work out which file each file of `other` is replaced with (if any), and
+    // take ownership of all of them. The files that are replaced are still kept
+    // alive, as there may be tokens that point into their contents.
+    Dictionary<SourceFile*, SourceFile*> replacements;
+    for (auto sourceFile : other->m_sourceFiles)
+    {
+        SourceFile* replacement = nullptr;
+        if (!fileReplacements.TryGetValue(sourceFile, replacement))
+        {
+            const PathInfo& pathInfo = sourceFile->getPathInfo();
+            if (pathInfo.hasUniqueIdentity() && other->findSourceFile(pathInfo.uniqueIdentity) == sourceFile)
+            {
+                replacement = findSourceFileRecursively(pathInfo.uniqueIdentity);
+                if (!replacement)
+                {
+                    addSourceFile(pathInfo.uniqueIdentity, sourceFile);
+                }
+            }
+        }
+        if (replacement)
+        {
+            replacements.Add(sourceFile, replacement);
+        }
+
+        sourceFile->m_sourceManager = this;
+        m_sourceFiles.Add(sourceFile);
+    }
+
+    // Move the views, remapping their locations, files and #line paths
+    for (auto sourceView : other->m_sourceViews)
+    {
+        sourceView->m_range.begin = sourceView->m_range.begin + offset;
+        sourceView->m_range.end = sourceView->m_range.end + offset;
+
+        SourceFile* replacement = nullptr;
+        if (replacements.TryGetValue(sourceView->m_sourceFile, replacement))
+        {
+            SLANG_ASSERT(replacement->getContentSize() == sourceView->m_sourceFile->getContentSize());
+            sourceView->m_sourceFile = replacement;
+        }
+
+        for (auto& entry : sourceView->m_entries)
+        {
+            entry.m_startLoc = entry.m_startLoc + offset;
+            if (entry.m_pathHandle != StringSlicePool::Handle(0))
+            {
+                entry.m_pathHandle = m_slicePool.add(other->m_slicePool.getSlice(entry.m_pathHandle));
+            }
+        }
+
+        m_sourceViews.Add(sourceView);
+    }
+
+    m_nextLoc = other->m_nextLoc + offset;
+
+    // Keep the allocations of `other` (such as the contents of tokens) alive
+    MemoryArena* arena = new MemoryArena(2048);
+    arena->swapWith(other->m_memoryArena);
+    m_adoptedMemoryArenas.Add(arena);
+    m_adoptedMemoryArenas.AddRange(other->m_adoptedMemoryArenas);
+
+    // Leave `other` empty
+    other->m_sourceFiles.Clear();
+    other->m_sourceViews.Clear();
+    other->m_sourceFileMap.Clear();
+    other->m_adoptedMemoryArenas.Clear();
+    other->m_slicePool.clear();
+    other->m_nextLoc = other->m_startLoc;
+
+    return offset;
 }
 
 UnownedStringSlice SourceManager::allocateStringSlice(const UnownedStringSlice& slice)
@@ -9,6 +9,9 @@
 #include "../../slang-com-ptr.h"
 #include "../../slang.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang {
 
 /** Overview: 
@@ -153,7 +156,8 @@ class SourceFile
 public:
 
         /// Returns the line break offsets (in bytes from start of content)
-        /// Note that this is lazily evaluated - the line breaks are only calculated on the first request 
+        /// Note that this is lazily evaluated - the line breaks are only calculated on the first request.
+        /// Can be called from more than one thread at a time.
     const List<uint32_t>& getLineBreakOffsets();
 
         /// Set the line break offsets
@@ -197,6 +201,7 @@ public:
     ~SourceFile();
 
     protected:
+    friend struct SourceManager;
 
     SourceManager* m_sourceManager;       ///< The source manager this belongs to
     PathInfo m_pathInfo;                  ///< The path The logical file path to report for locations inside this span.
@@ -208,6 +213,13 @@ public:
     // we will cache the starting offset of each line break in
     // the input file:
     List<uint32_t> m_lineBreakOffsets;
+
+    // Set once `m_lineBreakOffsets` has been filled in. Diagnostics can be
+    // written by more than one thread (e.g., when function bodies are checked
+    // in parallel), so the first request fills the offsets in whilst holding
+    // `m_lineBreakOffsetsMutex`.
+    std::atomic<bool> m_lineBreakOffsetsAreValid{false};
+    std::mutex m_lineBreakOffsetsMutex;
 };
 
 enum class SourceLocType
@@ -296,6 +308,8 @@ class SourceView
     }
 
     protected:
+    friend struct SourceManager;
+
         /// Get the pathInfo from a string handle. If it's 0, it will return the _getPathInfo
     PathInfo _getPathInfoFromHandle(StringSlicePool::Handle pathHandle) const;
         /// Gets the pathInfo for this view. It may be different from the m_sourceFile's if the path has been
@@ -371,6 +385,25 @@ struct SourceManager
 
         /// Allocate a string slice
     UnownedStringSlice allocateStringSlice(const UnownedStringSlice& slice);
+
+        /// Get all of the source files constructed on this manager, in the order they were created
+    const List<SourceFile*>& getSourceFiles() const { return m_sourceFiles; }
+
+        /// Move all of the source files, views and allocations of `other` into this manager, as if they had been
+        /// created on this manager in the first place.
+        ///
+        /// This allows a `SourceManager` to be filled in without touching this one (for example on another thread),
+        /// and then merged. `other` must not have a parent, and is left empty.
+        ///
+        /// The locations from `other` are placed directly after the locations already allocated on this manager. So
+        /// that locations match those that would have been produced by creating the views on this manager directly,
+        /// the returned offset must be added to any location from `other` that is still in use.
+        ///
+        /// A file from `other` that has a unique identity which is already known to this manager (or a parent) is
+        /// not added to this manager's map of files, and its views are switched to the already known file.
+        /// `fileReplacements` can be used to switch the views of other files in the same way - it maps a file in
+        /// `other` to the file (which must have the same contents) on this manager its views should use.
+    Int adoptSourceManager(SourceManager* other, const Dictionary<SourceFile*, SourceFile*>& fileReplacements);
     
     SourceManager() :
         m_memoryArena(2048)
@@ -401,6 +434,9 @@ struct SourceManager
     // Can be used for storing the decoded contents of Token. Content for example.
     MemoryArena m_memoryArena;
 
+    // The memory arenas of SourceManagers that have been adopted. Owned by this manager.
+    List<MemoryArena*> m_adoptedMemoryArenas;
+
     // Maps uniqueIdentities to source files
     Dictionary<String, SourceFile*> m_sourceFileMap;
 
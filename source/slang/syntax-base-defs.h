@@ -94,7 +94,10 @@ protected:
     virtual bool EqualsImpl(Type* type) = 0;
 
     virtual RefPtr<Type> CreateCanonicalType() = 0;
-    Type* canonicalType = nullptr;
+
+    // Computed on demand. Atomic, as a type may be shared by threads that
+    // check function bodies in parallel.
+    std::atomic<Type*> canonicalType{nullptr};
     
     Session* session = nullptr;
     )
@@ -275,17 +278,23 @@ ABSTRACT_SYNTAX_CLASS(Decl, DeclBase)
     )
 
 
-    FIELD_INIT(DeclCheckState, checkState, DeclCheckState::Unchecked)
+    RAW(
+    // Atomic, as function bodies may be checked in parallel, and a body
+    // can look at the state of a declaration another thread is checking.
+    // It is stored with release (and read with acquire) semantics, which
+    // need no fences on x86.
+    std::atomic<DeclCheckState> checkState{DeclCheckState::Unchecked};
+    )
 
     // The next declaration defined in the same container with the same name
     DECL_FIELD(Decl*, nextInContainerWithSameName RAW(= nullptr))
 
     RAW(
-    bool IsChecked(DeclCheckState state) { return checkState >= state; }
+    bool IsChecked(DeclCheckState state) { return checkState.load(std::memory_order_acquire) >= state; }
     void SetCheckState(DeclCheckState state)
     {
-        SLANG_RELEASE_ASSERT(state >= checkState);
-        checkState = state;
+        SLANG_RELEASE_ASSERT(state >= checkState.load(std::memory_order_relaxed));
+        checkState.store(state, std::memory_order_release);
     }
     )
 END_SYNTAX_CLASS()
@@ -115,9 +115,10 @@ void Type::accept(IValVisitor* visitor, void* extra)
     {
         // If the canonicalType !=nullptr AND it is not set to this (ie the canonicalType is another object)
         // then it needs to be released because it's owned by this object.
-        if (canonicalType && canonicalType != this)
+        Type* canType = canonicalType;
+        if (canType && canType != this)
         {
-            canonicalType->releaseReference();
+            canType->releaseReference();
         }
     }
 
@@ -151,21 +152,26 @@ void Type::accept(IValVisitor* visitor, void* extra)
     Type* Type::GetCanonicalType()
     {
         Type* et = const_cast<Type*>(this);
-        if (!et->canonicalType)
+        Type* existingType = et->canonicalType.load(std::memory_order_acquire);
+        if (!existingType)
         {
-            // TODO(tfoley): worry about thread safety here?
             auto canType = et->CreateCanonicalType();
-            et->canonicalType = canType;
+            SLANG_ASSERT(canType);
+
+            // More than one thread may compute the canonical type at the same
+            // time. Only the first result is kept, and the others are released.
+            if (!et->canonicalType.compare_exchange_strong(existingType, canType.Ptr(), std::memory_order_acq_rel))
+            {
+                return existingType;
+            }
 
             // TODO(js): That this detachs when canType == this is a little surprising. It would seem
             // as if this would create a circular reference on the object, but in practice there are
             // no leaks so appears correct.
             // That the dtor only releases if != this, also makes it surprising.
-            canType.detach();
-            
-            SLANG_ASSERT(et->canonicalType);
+            existingType = canType.detach();
         }
-        return et->canonicalType;
+        return existingType;
     }
 
     void Session::initializeTypes()
@@ -1526,8 +1532,6 @@ void Type::accept(IValVisitor* visitor, void* extra)
         UNREACHABLE_RETURN(expr);
     }
 
-    void buildMemberDictionary(ContainerDecl* decl);
-
     InterfaceDecl* findOuterInterfaceDecl(Decl* decl)
     {
         Decl* dd = decl;
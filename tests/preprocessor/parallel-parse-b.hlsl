@@ -0,0 +1,10 @@
+// Second translation unit for `parallel-parse.hlsl`
+
+#include "parallel-parse.h"
+#include "parallel-parse.h"
+
+#ifdef SHARED_VALUE
+#error in the second translation unit
+#endif
+
+float4 main() : SV_Target { return SHARED_VALUE; }
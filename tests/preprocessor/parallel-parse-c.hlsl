@@ -0,0 +1,5 @@
+// Third translation unit for `parallel-parse.hlsl`
+
+#include "parallel-parse.h"
+
+float4 main() : SV_Target { return SHARED_VALUE + ; }
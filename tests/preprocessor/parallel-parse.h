@@ -0,0 +1,6 @@
+// Header included by each translation unit of `parallel-parse.hlsl`
+#pragma once
+
+#warning in the shared header
+
+#define SHARED_VALUE float4(1, 2, 3, 4)
@@ -0,0 +1,13 @@
+//TEST:SIMPLE: -profile sm_5_0 -entry main -stage vertex tests/preprocessor/parallel-parse-b.hlsl -entry main -stage fragment tests/preprocessor/parallel-parse-c.hlsl -entry main -stage fragment
+//TEST:SIMPLE: -parallel-parse -profile sm_5_0 -entry main -stage vertex tests/preprocessor/parallel-parse-b.hlsl -entry main -stage fragment tests/preprocessor/parallel-parse-c.hlsl -entry main -stage fragment
+
+// Preprocessing the translation units in parallel must give
+// exactly the same diagnostics (and source locations) as
+// preprocessing them one after another.
+
+#include "parallel-parse.h"
+
+float4 main() : SV_Position { return SHARED_VALUE; }
+
+#line 100 "renamed.hlsl"
+#error in the first translation unit
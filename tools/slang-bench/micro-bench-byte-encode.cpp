@@ -0,0 +1,160 @@
+// micro-bench-byte-encode.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/slang-byte-encode-util.h"
+#include "../../source/core/slang-random-generator.h"
+
+using namespace Slang;
+
+// Each operation encodes (or decodes) one value
+static const UInt kValueCount = 4096;
+
+static UInt _min(UInt a, UInt b) { return a < b ? a : b; }
+
+static void _makeSmallValues(List<uint32_t>& outValues)
+{
+    // Values that mostly encode to a single byte, with occasional larger values, as is typical of
+    // arrays of ops, counts and nearby indices
+    DefaultRandomGenerator randGen(0x5123);
+
+    outValues.SetSize(kValueCount);
+    for (auto& value : outValues)
+    {
+        value = uint32_t(randGen.nextInt32UpTo(16) == 0 ? randGen.nextInt32UpTo(0x10000) : randGen.nextInt32UpTo(ByteEncodeUtil::kLiteCut1));
+    }
+}
+
+static void _makeValues(List<uint32_t>& outValues)
+{
+    // Values with a spread of encoded sizes, weighted towards small values
+    // (as is typical for the serialized IR)
+    DefaultRandomGenerator randGen(0x5123);
+
+    outValues.SetSize(kValueCount);
+    for (auto& value : outValues)
+    {
+        const int32_t bits = randGen.nextInt32UpTo(4) == 0 ? 32 : 8 + randGen.nextInt32UpTo(8);
+        value = uint32_t(randGen.nextInt32()) >> (32 - bits);
+    }
+}
+
+static void byteEncodeLiteUInt32Bench(MicroBenchState& state)
+{
+    List<uint32_t> values;
+    _makeValues(values);
+
+    List<uint8_t> encoded;
+    encoded.SetSize(kValueCount * ByteEncodeUtil::kMaxLiteEncodeUInt32);
+
+    state.startTiming();
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kValueCount);
+
+        size_t size = ByteEncodeUtil::encodeLiteUInt32(values.Buffer(), count, encoded.Buffer());
+
+        MicroBenchState::keep(size);
+        remaining -= count;
+    }
+}
+
+static void byteEncodeLiteUInt32SingleBench(MicroBenchState& state)
+{
+    List<uint32_t> values;
+    _makeValues(values);
+
+    state.startTiming();
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        uint8_t encoded[ByteEncodeUtil::kMaxLiteEncodeUInt32];
+        total += ByteEncodeUtil::encodeLiteUInt32(values[i % kValueCount], encoded);
+    }
+    MicroBenchState::keep(total);
+}
+
+typedef size_t (*DecodeLiteUInt32Func)(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut);
+
+static void _decodeLiteUInt32(MicroBenchState& state, const List<uint32_t>& values, DecodeLiteUInt32Func func)
+{
+    List<uint8_t> encoded;
+    ByteEncodeUtil::encodeLiteUInt32(values.Buffer(), values.Count(), encoded);
+
+    List<uint32_t> decoded;
+    decoded.SetSize(kValueCount);
+
+    state.startTiming();
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kValueCount);
+
+        size_t size = func(encoded.Buffer(), count, decoded.Buffer());
+
+        MicroBenchState::keep(size);
+        remaining -= count;
+    }
+}
+
+static void byteDecodeLiteUInt32Bench(MicroBenchState& state)
+{
+    List<uint32_t> values;
+    _makeValues(values);
+    _decodeLiteUInt32(state, values, &ByteEncodeUtil::decodeLiteUInt32);
+}
+
+static void byteDecodeLiteUInt32ScalarBench(MicroBenchState& state)
+{
+    List<uint32_t> values;
+    _makeValues(values);
+    _decodeLiteUInt32(state, values, &ByteEncodeUtil::decodeLiteUInt32Scalar);
+}
+
+static void byteDecodeLiteUInt32SmallBench(MicroBenchState& state)
+{
+    List<uint32_t> values;
+    _makeSmallValues(values);
+    _decodeLiteUInt32(state, values, &ByteEncodeUtil::decodeLiteUInt32);
+}
+
+static void byteDecodeLiteUInt32SmallScalarBench(MicroBenchState& state)
+{
+    List<uint32_t> values;
+    _makeSmallValues(values);
+    _decodeLiteUInt32(state, values, &ByteEncodeUtil::decodeLiteUInt32Scalar);
+}
+
+static void byteDecodeLiteUInt32SingleBench(MicroBenchState& state)
+{
+    List<uint32_t> values;
+    _makeValues(values);
+
+    List<uint8_t> encoded;
+    ByteEncodeUtil::encodeLiteUInt32(values.Buffer(), values.Count(), encoded);
+
+    state.startTiming();
+    uint64_t total = 0;
+    const uint8_t* cursor = encoded.Buffer();
+    UInt index = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        uint32_t value;
+        cursor += ByteEncodeUtil::decodeLiteUInt32(cursor, &value);
+        total += value;
+
+        if (++index == kValueCount)
+        {
+            index = 0;
+            cursor = encoded.Buffer();
+        }
+    }
+    MicroBenchState::keep(total);
+}
+
+SLANG_MICRO_BENCH("ByteEncode.encodeLiteUInt32", byteEncodeLiteUInt32Bench);
+SLANG_MICRO_BENCH("ByteEncode.encodeLiteUInt32Single", byteEncodeLiteUInt32SingleBench);
+SLANG_MICRO_BENCH("ByteEncode.decodeLiteUInt32", byteDecodeLiteUInt32Bench);
+SLANG_MICRO_BENCH("ByteEncode.decodeLiteUInt32Scalar", byteDecodeLiteUInt32ScalarBench);
+SLANG_MICRO_BENCH("ByteEncode.decodeLiteUInt32Single", byteDecodeLiteUInt32SingleBench);
+SLANG_MICRO_BENCH("ByteEncode.decodeLiteUInt32Small", byteDecodeLiteUInt32SmallBench);
+SLANG_MICRO_BENCH("ByteEncode.decodeLiteUInt32SmallScalar", byteDecodeLiteUInt32SmallScalarBench);
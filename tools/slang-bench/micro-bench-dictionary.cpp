@@ -0,0 +1,161 @@
+// micro-bench-dictionary.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/dictionary.h"
+#include "../../source/core/slang-random-generator.h"
+
+using namespace Slang;
+
+// The number of keys in each container. Each operation is one insert/lookup,
+// and a new container is started every `kKeyCount` inserts.
+static const UInt kKeyCount = 1024;
+
+// Large enough that the table is rehashed many times while growing
+static const UInt kLargeKeyCount = 64 * 1024;
+
+static void _makeIntKeys(UInt count, int32_t seed, List<int>& outKeys)
+{
+    DefaultRandomGenerator randGen(seed);
+    outKeys.SetSize(count);
+    for (UInt i = 0; i < count; ++i)
+        outKeys[i] = randGen.nextInt32();
+}
+
+static void _makeStringKeys(UInt count, int32_t seed, List<String>& outKeys)
+{
+    DefaultRandomGenerator randGen(seed);
+    outKeys.SetSize(count);
+    for (UInt i = 0; i < count; ++i)
+    {
+        // Something shaped like an identifier in a shader
+        StringBuilder builder;
+        builder << "value_" << randGen.nextInt32UpTo(1 << 20) << "_" << int32_t(i);
+        outKeys[i] = builder.ProduceString();
+    }
+}
+
+static UInt _min(UInt a, UInt b) { return a < b ? a : b; }
+
+template <typename KEY>
+static void _insert(MicroBenchState& state, List<KEY> const& keys)
+{
+    state.startTiming();
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, keys.Count());
+
+        Dictionary<KEY, int> dict;
+        for (UInt i = 0; i < count; ++i)
+            dict.AddIfNotExists(keys[i], int(i));
+
+        MicroBenchState::keep(dict.Count());
+        remaining -= count;
+    }
+}
+
+template <typename KEY>
+static void _lookup(MicroBenchState& state, List<KEY> const& keys, List<KEY> const& lookupKeys)
+{
+    Dictionary<KEY, int> dict;
+    for (UInt i = 0; i < keys.Count(); ++i)
+        dict.AddIfNotExists(keys[i], int(i));
+
+    state.startTiming();
+    uint64_t found = 0;
+    const UInt count = lookupKeys.Count();
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        found += dict.ContainsKey(lookupKeys[i % count]) ? 1 : 0;
+    }
+    MicroBenchState::keep(found);
+}
+
+static void dictionaryInsertBench(MicroBenchState& state)
+{
+    List<int> keys;
+    _makeIntKeys(kKeyCount, 0x1234, keys);
+    _insert(state, keys);
+}
+
+static void dictionaryInsertLargeBench(MicroBenchState& state)
+{
+    List<int> keys;
+    _makeIntKeys(kLargeKeyCount, 0x1234, keys);
+    _insert(state, keys);
+}
+
+static void dictionaryLookupBench(MicroBenchState& state)
+{
+    List<int> keys;
+    _makeIntKeys(kKeyCount, 0x1234, keys);
+    _lookup(state, keys, keys);
+}
+
+static void dictionaryLookupMissBench(MicroBenchState& state)
+{
+    List<int> keys, missingKeys;
+    _makeIntKeys(kKeyCount, 0x1234, keys);
+    _makeIntKeys(kKeyCount, 0x5678, missingKeys);
+    _lookup(state, keys, missingKeys);
+}
+
+static void dictionaryInsertStringBench(MicroBenchState& state)
+{
+    List<String> keys;
+    _makeStringKeys(kKeyCount, 0x1234, keys);
+    _insert(state, keys);
+}
+
+static void dictionaryLookupStringBench(MicroBenchState& state)
+{
+    List<String> keys;
+    _makeStringKeys(kKeyCount, 0x1234, keys);
+    _lookup(state, keys, keys);
+}
+
+static void hashSetAddBench(MicroBenchState& state)
+{
+    List<int> keys;
+    _makeIntKeys(kKeyCount, 0x1234, keys);
+
+    state.startTiming();
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kKeyCount);
+
+        HashSet<int> set;
+        for (UInt i = 0; i < count; ++i)
+            set.Add(keys[i]);
+
+        MicroBenchState::keep(set.Count());
+        remaining -= count;
+    }
+}
+
+static void hashSetContainsBench(MicroBenchState& state)
+{
+    List<int> keys;
+    _makeIntKeys(kKeyCount, 0x1234, keys);
+
+    HashSet<int> set;
+    for (auto key : keys)
+        set.Add(key);
+
+    state.startTiming();
+    uint64_t found = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        found += set.Contains(keys[i % kKeyCount]) ? 1 : 0;
+    }
+    MicroBenchState::keep(found);
+}
+
+SLANG_MICRO_BENCH("Dictionary.insert", dictionaryInsertBench);
+SLANG_MICRO_BENCH("Dictionary.insertLarge", dictionaryInsertLargeBench);
+SLANG_MICRO_BENCH("Dictionary.insertString", dictionaryInsertStringBench);
+SLANG_MICRO_BENCH("Dictionary.lookup", dictionaryLookupBench);
+SLANG_MICRO_BENCH("Dictionary.lookupMiss", dictionaryLookupMissBench);
+SLANG_MICRO_BENCH("Dictionary.lookupString", dictionaryLookupStringBench);
+SLANG_MICRO_BENCH("HashSet.add", hashSetAddBench);
+SLANG_MICRO_BENCH("HashSet.contains", hashSetContainsBench);
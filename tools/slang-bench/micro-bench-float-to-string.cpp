@@ -0,0 +1,99 @@
+// micro-bench-float-to-string.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/slang-float-to-string.h"
+#include "../../source/core/slang-random-generator.h"
+
+#include <locale>
+#include <sstream>
+
+using namespace Slang;
+
+// Each operation converts one value. The values are a mix of the kind of literals found in shaders (small
+// numbers with few digits), and values with all of their digits (as produced by constant folding).
+static const UInt kValueCount = 1024;
+
+static void _makeDoubles(List<double>& outValues)
+{
+    DefaultRandomGenerator randGen(0x5eed);
+
+    outValues.SetSize(kValueCount);
+    for (UInt i = 0; i < kValueCount; ++i)
+    {
+        outValues[i] = (i & 1) ?
+            double(randGen.nextInt32InRange(-1000, 1000)) / 8.0 :
+            double(randGen.nextUnitFloat32()) * 1000.0 / 3.0;
+    }
+}
+
+static void floatToStringDoubleBench(MicroBenchState& state)
+{
+    List<double> values;
+    _makeDoubles(values);
+
+    state.startTiming();
+    char buffer[FloatToStringUtil::kMaxChars];
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        total += uint64_t(FloatToStringUtil::toChars(values[i % kValueCount], buffer));
+    }
+    MicroBenchState::keep(total);
+}
+
+static void floatToStringFloatBench(MicroBenchState& state)
+{
+    List<double> values;
+    _makeDoubles(values);
+
+    state.startTiming();
+    char buffer[FloatToStringUtil::kMaxChars];
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        total += uint64_t(FloatToStringUtil::toChars(float(values[i % kValueCount]), buffer));
+    }
+    MicroBenchState::keep(total);
+}
+
+// The previous way floating point literals were emitted, for comparison
+static void floatToStringStreamBench(MicroBenchState& state)
+{
+    List<double> values;
+    _makeDoubles(values);
+
+    state.startTiming();
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        std::ostringstream stream;
+        stream.imbue(std::locale::classic());
+        stream.setf(std::ios::fixed, std::ios::floatfield);
+        stream.precision(20);
+        stream << values[i % kValueCount];
+        total += uint64_t(stream.str().length());
+    }
+    MicroBenchState::keep(total);
+}
+
+// sprintf can only find round trip digits by always printing 17 of them (and is locale dependent)
+static void floatToStringSprintfBench(MicroBenchState& state)
+{
+    List<double> values;
+    _makeDoubles(values);
+
+    state.startTiming();
+    char buffer[64];
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        total += uint64_t(sprintf(buffer, "%.17g", values[i % kValueCount]));
+    }
+    MicroBenchState::keep(total);
+}
+
+SLANG_MICRO_BENCH("FloatToString.double", floatToStringDoubleBench);
+SLANG_MICRO_BENCH("FloatToString.float", floatToStringFloatBench);
+SLANG_MICRO_BENCH("FloatToString.sprintf", floatToStringSprintfBench);
+SLANG_MICRO_BENCH("FloatToString.stream", floatToStringStreamBench);
@@ -0,0 +1,85 @@
+// micro-bench-free-list.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/slang-free-list.h"
+#include "../../source/core/slang-random-generator.h"
+
+using namespace Slang;
+
+// Each operation is one allocation (or deallocation)
+static const UInt kAllocCount = 4096;
+
+static UInt _min(UInt a, UInt b) { return a < b ? a : b; }
+
+static void freeListAllocateBench(MicroBenchState& state)
+{
+    FreeList freeList;
+    freeList.init(32, sizeof(void*), 1024);
+
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kAllocCount);
+
+        uint64_t total = 0;
+        for (UInt i = 0; i < count; ++i)
+            total += uint64_t(freeList.allocate() != nullptr);
+
+        freeList.reset();
+
+        MicroBenchState::keep(total);
+        remaining -= count;
+    }
+}
+
+static void freeListChurnBench(MicroBenchState& state)
+{
+    // Interleaved allocations and deallocations, in the same kind of
+    // pattern as the `FreeList` unit test. An operation is either one.
+    DefaultRandomGenerator randGen(0x24343);
+
+    List<bool> isAllocate;
+    List<UInt> indices;
+    UInt liveCount = 0;
+    for (UInt i = 0; i < kAllocCount; ++i)
+    {
+        const bool shouldAllocate = liveCount == 0 || randGen.nextInt32UpTo(5) < 3;
+        isAllocate.Add(shouldAllocate);
+        indices.Add(shouldAllocate ? 0 : UInt(randGen.nextInt32UpTo(int32_t(liveCount))));
+        liveCount += shouldAllocate ? 1 : -1;
+    }
+
+    FreeList freeList;
+    freeList.init(32, sizeof(void*), 1024);
+
+    List<void*> live;
+    live.Reserve(kAllocCount);
+
+    state.startTiming();
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kAllocCount);
+
+        for (UInt i = 0; i < count; ++i)
+        {
+            if (isAllocate[i])
+            {
+                live.Add(freeList.allocate());
+            }
+            else
+            {
+                const UInt index = indices[i];
+                freeList.deallocate(live[index]);
+                live.FastRemoveAt(index);
+            }
+        }
+
+        freeList.reset();
+        live.Clear();
+
+        remaining -= count;
+    }
+}
+
+SLANG_MICRO_BENCH("FreeList.allocate", freeListAllocateBench);
+SLANG_MICRO_BENCH("FreeList.churn", freeListChurnBench);
@@ -0,0 +1,65 @@
+// micro-bench-list.cpp
+
+#include "micro-bench.h"
+
+using namespace Slang;
+
+// Each operation is one `Add`, and a new list is started every `kElementCount` adds,
+// so that the cost of growing the list is included.
+static const UInt kElementCount = 1024;
+
+static UInt _min(UInt a, UInt b) { return a < b ? a : b; }
+
+static void listAddBench(MicroBenchState& state)
+{
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kElementCount);
+
+        List<int> list;
+        for (UInt i = 0; i < count; ++i)
+            list.Add(int(i));
+
+        MicroBenchState::keep(list.Count());
+        remaining -= count;
+    }
+}
+
+static void listAddStringBench(MicroBenchState& state)
+{
+    // Growing a `List<String>` moves (or copies) every element, so it is
+    // more sensitive to how growth is implemented than a list of `int`.
+    String value("some-string");
+
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kElementCount);
+
+        List<String> list;
+        for (UInt i = 0; i < count; ++i)
+            list.Add(value);
+
+        MicroBenchState::keep(list.Count());
+        remaining -= count;
+    }
+}
+
+static void listAddReservedBench(MicroBenchState& state)
+{
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kElementCount);
+
+        List<int> list;
+        list.Reserve(count);
+        for (UInt i = 0; i < count; ++i)
+            list.Add(int(i));
+
+        MicroBenchState::keep(list.Count());
+        remaining -= count;
+    }
+}
+
+SLANG_MICRO_BENCH("List.add", listAddBench);
+SLANG_MICRO_BENCH("List.addReserved", listAddReservedBench);
+SLANG_MICRO_BENCH("List.addString", listAddStringBench);
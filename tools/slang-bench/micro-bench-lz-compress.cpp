@@ -0,0 +1,81 @@
+// micro-bench-lz-compress.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/slang-lz-compress-util.h"
+#include "../../source/core/slang-random-generator.h"
+
+using namespace Slang;
+
+// Each operation compresses (or decompresses) one byte, so the time per operation in ns is the inverse of the
+// throughput in GB/s. Whole blocks of kDataSize bytes are processed, rounding up the operation count.
+static const size_t kDataSize = 64 * 1024;
+
+// Fills outData with something like an array of serialized IR instructions - small ops, and operands
+// that mostly refer to instructions close by.
+static void _makeData(List<uint8_t>& outData)
+{
+    DefaultRandomGenerator randGen(0x2341);
+
+    List<uint32_t> words;
+    const uint32_t numInsts = uint32_t(kDataSize / (sizeof(uint32_t) * 4));
+    for (uint32_t i = 0; i < numInsts; ++i)
+    {
+        const uint32_t op = uint32_t(randGen.nextInt32UpTo(24)) * 3;
+        const uint32_t numOperands = uint32_t(randGen.nextInt32UpTo(3));
+
+        words.Add(op | (numOperands << 8));
+        words.Add(randGen.nextInt32UpTo(4) ? uint32_t(randGen.nextInt32UpTo(16)) : 0);
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+            words.Add(j < numOperands ? i - uint32_t(randGen.nextInt32UpTo(i < 32 ? int32_t(i + 1) : 32)) : 0);
+        }
+    }
+
+    outData.SetSize(UInt(kDataSize));
+    memcpy(outData.begin(), words.begin(), kDataSize);
+}
+
+static UInt _calcBlockCount(const MicroBenchState& state)
+{
+    return (state.operationCount + kDataSize - 1) / kDataSize;
+}
+
+static void lzCompressBench(MicroBenchState& state)
+{
+    List<uint8_t> data;
+    _makeData(data);
+
+    List<uint8_t> compressed;
+    compressed.SetSize(UInt(LZCompressUtil::calcMaxCompressedSize(kDataSize)));
+
+    state.startTiming();
+    const UInt blockCount = _calcBlockCount(state);
+    for (UInt i = 0; i < blockCount; ++i)
+    {
+        MicroBenchState::keep(LZCompressUtil::compress(data.begin(), kDataSize, compressed.begin()));
+    }
+}
+
+static void lzDecompressBench(MicroBenchState& state)
+{
+    List<uint8_t> data;
+    _makeData(data);
+
+    List<uint8_t> compressed;
+    LZCompressUtil::compress(data.begin(), kDataSize, compressed);
+
+    List<uint8_t> decompressed;
+    decompressed.SetSize(UInt(kDataSize));
+
+    state.startTiming();
+    const UInt blockCount = _calcBlockCount(state);
+    for (UInt i = 0; i < blockCount; ++i)
+    {
+        SlangResult res = LZCompressUtil::decompress(compressed.begin(), size_t(compressed.Count()), decompressed.begin(), kDataSize);
+        MicroBenchState::keep(uint64_t(res) + decompressed[UInt(i & 0xff)]);
+    }
+}
+
+SLANG_MICRO_BENCH("LZCompress.compress", lzCompressBench);
+SLANG_MICRO_BENCH("LZCompress.decompress", lzDecompressBench);
@@ -0,0 +1,82 @@
+// micro-bench-memory-arena.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/slang-memory-arena.h"
+#include "../../source/core/slang-random-generator.h"
+
+using namespace Slang;
+
+// Each operation is one allocation. The arena is reset every `kAllocCount` allocations,
+// so that the blocks are reused as they would be by a long running user of the arena.
+static const UInt kAllocCount = 4096;
+
+static const size_t kBlockSize = 64 * 1024;
+
+static UInt _min(UInt a, UInt b) { return a < b ? a : b; }
+
+static void _allocate(MicroBenchState& state, List<size_t> const& sizes, size_t alignment)
+{
+    MemoryArena arena;
+    arena.init(kBlockSize);
+
+    state.startTiming();
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, sizes.Count());
+
+        uint64_t total = 0;
+        if (alignment)
+        {
+            for (UInt i = 0; i < count; ++i)
+                total += uint64_t(arena.allocateAligned(sizes[i], alignment) != nullptr);
+        }
+        else
+        {
+            for (UInt i = 0; i < count; ++i)
+                total += uint64_t(arena.allocate(sizes[i]) != nullptr);
+        }
+
+        arena.reset();
+
+        MicroBenchState::keep(total);
+        remaining -= count;
+    }
+}
+
+static void memoryArenaAllocateSmallBench(MicroBenchState& state)
+{
+    List<size_t> sizes;
+    sizes.SetSize(kAllocCount);
+    for (auto& size : sizes)
+        size = 16;
+    _allocate(state, sizes, 0);
+}
+
+static void memoryArenaAllocateMixedBench(MicroBenchState& state)
+{
+    // Mostly small allocations, with the occasional large one (which
+    // may not fit in the remaining space of the current block)
+    DefaultRandomGenerator randGen(0x3412);
+
+    List<size_t> sizes;
+    sizes.SetSize(kAllocCount);
+    for (auto& size : sizes)
+        size = (randGen.nextInt32UpTo(16) == 0) ? size_t(1024 + randGen.nextInt32UpTo(8192)) : size_t(8 + randGen.nextInt32UpTo(120));
+    _allocate(state, sizes, 0);
+}
+
+static void memoryArenaAllocateAlignedBench(MicroBenchState& state)
+{
+    DefaultRandomGenerator randGen(0x3412);
+
+    List<size_t> sizes;
+    sizes.SetSize(kAllocCount);
+    for (auto& size : sizes)
+        size = size_t(8 + randGen.nextInt32UpTo(120));
+    _allocate(state, sizes, 64);
+}
+
+SLANG_MICRO_BENCH("MemoryArena.allocateSmall", memoryArenaAllocateSmallBench);
+SLANG_MICRO_BENCH("MemoryArena.allocateMixed", memoryArenaAllocateMixedBench);
+SLANG_MICRO_BENCH("MemoryArena.allocateAligned", memoryArenaAllocateAlignedBench);
@@ -0,0 +1,87 @@
+// micro-bench-path.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/slang-io.h"
+
+using namespace Slang;
+
+// Representative of the paths seen for include files and imported modules
+static const char* const kPaths[] =
+{
+    "tests/compute/array-param.slang",
+    "source/slang/core.meta.slang",
+    "/home/user/project/shaders/lighting/../common/brdf.slang",
+    "C:\\Users\\user\\project\\shaders\\.\\material.hlsl",
+    "shaders/./post-process/../post-process/tonemap.slang",
+    "lib.slang",
+};
+
+static const UInt kPathCount = SLANG_COUNT_OF(kPaths);
+
+static void pathGetFileNameBench(MicroBenchState& state)
+{
+    List<String> paths;
+    for (auto path : kPaths)
+        paths.Add(path);
+
+    state.startTiming();
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+        total += Path::GetFileName(paths[i % kPathCount]).Length();
+    MicroBenchState::keep(total);
+}
+
+static void pathGetDirectoryNameBench(MicroBenchState& state)
+{
+    List<String> paths;
+    for (auto path : kPaths)
+        paths.Add(path);
+
+    state.startTiming();
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+        total += Path::GetDirectoryName(paths[i % kPathCount]).Length();
+    MicroBenchState::keep(total);
+}
+
+static void pathCombineBench(MicroBenchState& state)
+{
+    String directory("source/slang");
+    List<String> paths;
+    for (auto path : kPaths)
+        paths.Add(Path::GetFileName(path));
+
+    state.startTiming();
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+        total += Path::Combine(directory, paths[i % kPathCount]).Length();
+    MicroBenchState::keep(total);
+}
+
+static void pathSimplifyBench(MicroBenchState& state)
+{
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+        total += Path::Simplify(UnownedStringSlice(kPaths[i % kPathCount])).Length();
+    MicroBenchState::keep(total);
+}
+
+static void pathSplitBench(MicroBenchState& state)
+{
+    uint64_t total = 0;
+    List<UnownedStringSlice> elements;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        elements.Clear();
+        Path::Split(UnownedStringSlice(kPaths[i % kPathCount]), elements);
+        total += elements.Count();
+    }
+    MicroBenchState::keep(total);
+}
+
+SLANG_MICRO_BENCH("Path.getFileName", pathGetFileNameBench);
+SLANG_MICRO_BENCH("Path.getDirectoryName", pathGetDirectoryNameBench);
+SLANG_MICRO_BENCH("Path.combine", pathCombineBench);
+SLANG_MICRO_BENCH("Path.simplify", pathSimplifyBench);
+SLANG_MICRO_BENCH("Path.split", pathSplitBench);
@@ -0,0 +1,170 @@
+// micro-bench-string.cpp
+
+#include "micro-bench.h"
+
+#include "../../source/core/slang-chunked-string-builder.h"
+#include "../../source/core/slang-string-slice-pool.h"
+
+using namespace Slang;
+
+// Each operation is one append, and a new string is started every `kAppendCount` appends.
+static const UInt kAppendCount = 1024;
+
+static UInt _min(UInt a, UInt b) { return a < b ? a : b; }
+
+static void stringAppendBench(MicroBenchState& state)
+{
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kAppendCount);
+
+        String string;
+        for (UInt i = 0; i < count; ++i)
+            string.append("identifier");
+
+        MicroBenchState::keep(string.Length());
+        remaining -= count;
+    }
+}
+
+static void stringConcatBench(MicroBenchState& state)
+{
+    // `operator+` always produces a new string, so this is dominated by allocation
+    String prefix("some_prefix_");
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        String string = prefix + "identifier";
+        total += string.Length();
+    }
+    MicroBenchState::keep(total);
+}
+
+static void stringBuilderAppendBench(MicroBenchState& state)
+{
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kAppendCount);
+
+        StringBuilder builder;
+        for (UInt i = 0; i < count; ++i)
+            builder << "identifier";
+
+        MicroBenchState::keep(builder.Length());
+        remaining -= count;
+    }
+}
+
+static void stringBuilderAppendIntBench(MicroBenchState& state)
+{
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kAppendCount);
+
+        StringBuilder builder;
+        for (UInt i = 0; i < count; ++i)
+            builder << int32_t(i * 7919);
+
+        MicroBenchState::keep(builder.Length());
+        remaining -= count;
+    }
+}
+
+// For the 'large' appends, a new string is started every `kLargeAppendCount` appends (around 4MB of text),
+// and once done a prefix is added in front of it, as when emitting a large shader.
+static const UInt kLargeAppendCount = 400 * 1024;
+
+static void stringBuilderAppendLargeBench(MicroBenchState& state)
+{
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kLargeAppendCount);
+
+        StringBuilder builder;
+        for (UInt i = 0; i < count; ++i)
+            builder << "identifier";
+
+        StringBuilder result;
+        result << "#version 450\n" << builder.ProduceString();
+
+        MicroBenchState::keep(result.Length());
+        remaining -= count;
+    }
+}
+
+static void chunkedStringBuilderAppendLargeBench(MicroBenchState& state)
+{
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kLargeAppendCount);
+
+        ChunkedStringBuilder builder;
+        for (UInt i = 0; i < count; ++i)
+            builder.append("identifier");
+
+        builder.prepend(String("#version 450\n"));
+        String result = builder.produceString();
+
+        MicroBenchState::keep(result.Length());
+        remaining -= count;
+    }
+}
+
+static void _makeSlices(UInt count, List<String>& outStrings)
+{
+    outStrings.SetSize(count);
+    for (UInt i = 0; i < count; ++i)
+    {
+        StringBuilder builder;
+        builder << "name_" << int32_t(i);
+        outStrings[i] = builder.ProduceString();
+    }
+}
+
+static void stringSlicePoolAddBench(MicroBenchState& state)
+{
+    // Each operation adds a slice that isn't yet in the pool
+    List<String> strings;
+    _makeSlices(kAppendCount, strings);
+
+    state.startTiming();
+    for (UInt remaining = state.operationCount; remaining; )
+    {
+        const UInt count = _min(remaining, kAppendCount);
+
+        StringSlicePool pool;
+        for (UInt i = 0; i < count; ++i)
+            pool.add(strings[i]);
+
+        MicroBenchState::keep(pool.getNumSlices());
+        remaining -= count;
+    }
+}
+
+static void stringSlicePoolAddExistingBench(MicroBenchState& state)
+{
+    // Each operation adds a slice that is already in the pool
+    List<String> strings;
+    _makeSlices(kAppendCount, strings);
+
+    StringSlicePool pool;
+    for (auto const& string : strings)
+        pool.add(string);
+
+    state.startTiming();
+    uint64_t total = 0;
+    for (UInt i = 0; i < state.operationCount; ++i)
+    {
+        total += uint64_t(pool.add(strings[i % kAppendCount]));
+    }
+    MicroBenchState::keep(total);
+}
+
+SLANG_MICRO_BENCH("ChunkedStringBuilder.appendLarge", chunkedStringBuilderAppendLargeBench);
+SLANG_MICRO_BENCH("String.append", stringAppendBench);
+SLANG_MICRO_BENCH("String.concat", stringConcatBench);
+SLANG_MICRO_BENCH("StringBuilder.append", stringBuilderAppendBench);
+SLANG_MICRO_BENCH("StringBuilder.appendInt", stringBuilderAppendIntBench);
+SLANG_MICRO_BENCH("StringBuilder.appendLarge", stringBuilderAppendLargeBench);
+SLANG_MICRO_BENCH("StringSlicePool.add", stringSlicePoolAddBench);
+SLANG_MICRO_BENCH("StringSlicePool.addExisting", stringSlicePoolAddExistingBench);
@@ -0,0 +1,79 @@
+// micro-bench.cpp
+#include "micro-bench.h"
+
+namespace Slang {
+
+/* static */MicroBenchRegister* MicroBenchRegister::s_first;
+
+static volatile uint64_t s_keptValue;
+
+/* static */void MicroBenchState::keep(uint64_t value)
+{
+    s_keptValue = s_keptValue + value;
+}
+
+// Run `func` once for `operationCount` operations, and return the time taken in seconds
+static double _runSample(MicroBenchFunc func, UInt operationCount)
+{
+    MicroBenchState state;
+    state.operationCount = operationCount;
+
+    state.m_startTicks = Timer::now();
+    func(state);
+    if (!state.m_isStopped)
+        state.stopTiming();
+
+    return Timer::toSeconds(state.m_endTicks - state.m_startTicks);
+}
+
+static void _runMicroBenchmark(MicroBenchRegister* bench, MicroBenchOptions const& options, MicroBenchResult& outResult)
+{
+    // Find an operation count for which a sample takes long enough
+    // to be timed reliably. The first run also warms up any caches.
+    UInt operationCount = 16;
+    for (;;)
+    {
+        double time = _runSample(bench->m_func, operationCount);
+        if (time >= options.minSampleTimeInSeconds || operationCount >= (UInt(1) << 30))
+            break;
+        operationCount *= 2;
+    }
+
+    List<double> sampleTimes;
+    for (int i = 0; i < options.sampleCount; ++i)
+    {
+        sampleTimes.Add(_runSample(bench->m_func, operationCount));
+    }
+    sampleTimes.Sort();
+
+    const double nsPerSecond = 1.0e9;
+
+    outResult.name = bench->m_name;
+    outResult.operationCount = operationCount;
+    outResult.nsPerOp = sampleTimes[sampleTimes.Count() / 2] * nsPerSecond / double(operationCount);
+    outResult.minNsPerOp = sampleTimes[0] * nsPerSecond / double(operationCount);
+}
+
+void runMicroBenchmarks(MicroBenchOptions const& options, List<MicroBenchResult>& outResults)
+{
+    List<MicroBenchRegister*> benches;
+    for (MicroBenchRegister* cur = MicroBenchRegister::s_first; cur; cur = cur->m_next)
+    {
+        if (options.filter.Length() == 0 || UnownedStringSlice(cur->m_name).startsWith(options.filter.getUnownedSlice()))
+        {
+            benches.Add(cur);
+        }
+    }
+
+    // Registration order depends on link order, so sort by name to keep the output stable
+    benches.Sort([](MicroBenchRegister* a, MicroBenchRegister* b) { return strcmp(a->m_name, b->m_name) < 0; });
+
+    for (auto bench : benches)
+    {
+        MicroBenchResult result;
+        _runMicroBenchmark(bench, options, result);
+        outResults.Add(result);
+    }
+}
+
+} // namespace Slang
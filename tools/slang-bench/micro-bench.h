@@ -0,0 +1,82 @@
+// micro-bench.h
+#ifndef SLANG_MICRO_BENCH_H
+#define SLANG_MICRO_BENCH_H
+
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-timer.h"
+#include "../../source/core/list.h"
+
+namespace Slang {
+
+    /// Passed to a micro benchmark, which should perform `operationCount` operations.
+    ///
+    /// By default the whole call to the benchmark is timed. A benchmark that needs to
+    /// do setup (e.g., filling a container before timing lookups) can call `startTiming`
+    /// once the setup is done, and `stopTiming` before any teardown it doesn't want measured.
+struct MicroBenchState
+{
+        /// Restart the clock, so that any work done so far isn't measured
+    void startTiming() { m_startTicks = Timer::now(); }
+        /// Stop the clock, so that any work done after this isn't measured
+    void stopTiming() { m_endTicks = Timer::now(); m_isStopped = true; }
+
+        /// Fold `value` into a result that is visible outside the benchmark, so that
+        /// the compiler can't optimize away the work that produced it.
+    static void keep(uint64_t value);
+
+    UInt            operationCount = 0;
+
+    Timer::Ticks    m_startTicks = 0;
+    Timer::Ticks    m_endTicks = 0;
+    bool            m_isStopped = false;
+};
+
+typedef void (*MicroBenchFunc)(MicroBenchState& state);
+
+    /// Registers a micro benchmark (see `SLANG_MICRO_BENCH`)
+struct MicroBenchRegister
+{
+    MicroBenchRegister(const char* name, MicroBenchFunc func):
+        m_next(s_first),
+        m_name(name),
+        m_func(func)
+    {
+        s_first = this;
+    }
+
+    MicroBenchRegister* m_next;
+    const char* m_name;
+    MicroBenchFunc m_func;
+
+    static MicroBenchRegister* s_first;
+};
+
+#define SLANG_MICRO_BENCH(name, func) static MicroBenchRegister SLANG_CONCAT(s_microBench, __LINE__)(name, func)
+
+struct MicroBenchResult
+{
+    String  name;
+        /// Median time per operation over the samples
+    double  nsPerOp = 0.0;
+        /// Fastest time per operation over the samples
+    double  minNsPerOp = 0.0;
+        /// Number of operations performed per sample
+    UInt    operationCount = 0;
+};
+
+struct MicroBenchOptions
+{
+        /// Only run benchmarks whose name starts with this (if non-empty)
+    String  filter;
+        /// The operation count is increased until a sample takes at least this long
+    double  minSampleTimeInSeconds = 0.02;
+        /// Number of timed samples taken for each benchmark
+    int     sampleCount = 5;
+};
+
+    /// Run all the registered micro benchmarks that match `options`, in name order
+void runMicroBenchmarks(MicroBenchOptions const& options, List<MicroBenchResult>& outResults);
+
+} // namespace Slang
+
+#endif // SLANG_MICRO_BENCH_H
@@ -0,0 +1,897 @@
+// slang-bench-main.cpp
+
+// `slang-bench` measures end-to-end compiler throughput.
+//
+// A set of shader files is compiled a number of times under each
+// of several configurations (cold vs. warm session, and per target,
+// with and without a downstream compiler), and for each configuration
+// we report the time per compile, throughput, a breakdown by compiler
+// phase (from `spGetCompileStats`), and the peak memory used.
+//
+// The results can be written out as a JSON baseline, and a later run
+// can be compared against a baseline, failing if any configuration
+// is slower by more than a threshold.
+//
+// With `-micro` the tool instead runs micro benchmarks of the `core`
+// containers and utilities (see `micro-bench.h`), which are reported
+// and compared against a baseline in the same way.
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-timer.h"
+
+#include "micro-bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Slang;
+
+// A single file to compile, along with the entry point to compile in it
+struct BenchInput
+{
+    String      path;
+    String      entryPointName;
+    SlangStage  stage = SLANG_STAGE_COMPUTE;
+    size_t      sizeInBytes = 0;
+};
+
+// A target that the benchmark can compile for
+struct BenchTarget
+{
+    char const*         name;
+    SlangCompileTarget  target;
+    char const*         profileName;
+
+        /// True if compiling for this target invokes a downstream compiler
+    bool                usesDownstream;
+        /// The source target that a downstream compiler would consume
+    char const*         sourceTargetName;
+};
+
+static const BenchTarget kBenchTargets[] =
+{
+    { "hlsl",   SLANG_HLSL,     "sm_5_0",   false,  "hlsl" },
+    { "glsl",   SLANG_GLSL,     "glsl_450", false,  "glsl" },
+    { "dxbc",   SLANG_DXBC,     "sm_5_0",   true,   "hlsl" },
+    { "dxil",   SLANG_DXIL,     "sm_6_0",   true,   "hlsl" },
+    { "spirv",  SLANG_SPIRV,    "glsl_450", true,   "glsl" },
+};
+
+static BenchTarget const* _findBenchTarget(UnownedStringSlice const& name)
+{
+    for (auto const& target : kBenchTargets)
+    {
+        if (name == target.name)
+            return &target;
+    }
+    return nullptr;
+}
+
+// One configuration that the inputs are compiled under
+struct BenchConfig
+{
+    String              name;
+    bool                isWarm = false;
+    BenchTarget const*  target = nullptr;
+};
+
+// The total time spent in a phase, over all compiles in a configuration
+struct PhaseTime
+{
+    String  name;
+    double  timeInSeconds = 0.0;
+};
+
+struct BenchResult
+{
+    String  name;
+
+        /// False if the configuration could not be run (e.g., a downstream compiler is missing)
+    bool    isAvailable = false;
+
+    double  medianSecondsPerCompile = 0.0;
+    double  minSecondsPerCompile = 0.0;
+    double  compilesPerSecond = 0.0;
+    double  sourceBytesPerSecond = 0.0;
+
+        /// Peak memory used by the process, up to and including this configuration
+    uint64_t peakMemoryBytes = 0;
+
+        /// Size of the generated source code (before any downstream compiler), averaged per compile
+    double  outputBytesPerCompile = 0.0;
+
+        /// Phase times, averaged per compile
+    List<PhaseTime> phases;
+};
+
+// A named measurement that can be compared with a baseline (lower is better)
+struct BaselineEntry
+{
+    String  name;
+    double  value = 0.0;
+};
+
+struct Options
+{
+    List<BenchInput>    inputs;
+    List<String>        targetNames;
+
+    int     iterations = 10;
+    bool    runCold = true;
+    bool    runWarm = true;
+    bool    includeDownstream = false;
+
+        /// Flags (`SLANG_COMPILE_FLAG_...`) to compile every input with
+    SlangCompileFlags   compileFlags = 0;
+
+        /// Run the micro benchmarks, rather than compiling shaders
+    bool    runMicro = false;
+    MicroBenchOptions   microOptions;
+
+    String  baselinePath;
+    String  writeBaselinePath;
+
+        /// Allowed slowdown relative to the baseline, as a fraction (0.1 is 10%)
+    double  threshold = 0.1;
+};
+
+static void _printUsage()
+{
+    fprintf(stderr,
+        "usage: slang-bench [options] [<file>...]\n"
+        "\n"
+        "  -set <path>              Add the shaders listed in <path> (one '<file> [<entry> [<stage>]]' per line)\n"
+        "  -entry <name>            Entry point name for subsequent files (default 'computeMain')\n"
+        "  -stage <name>            Entry point stage for subsequent files (default 'compute')\n"
+        "  -target <name>           Target to benchmark (hlsl, glsl, dxbc, dxil, spirv); may be repeated\n"
+        "  -downstream              Also benchmark the downstream targets for each source target\n"
+        "  -parallel-check          Check function bodies in parallel (SLANG_COMPILE_FLAG_PARALLEL_CHECK)\n"
+        "  -iterations <n>          Number of timed iterations per configuration (default 10)\n"
+        "  -cold / -warm            Only run cold (new session per iteration) or warm (shared session) configurations\n"
+        "  -baseline <path>         Compare against a baseline written with -write-baseline\n"
+        "  -threshold <percent>     Allowed slowdown relative to the baseline (default 10)\n"
+        "  -write-baseline <path>   Write the results as a JSON baseline\n"
+        "  -micro                   Run the micro benchmarks of the core library instead of compiling shaders\n"
+        "  -filter <prefix>         Only run micro benchmarks whose name starts with <prefix>\n"
+        "\n"
+        "If no files are given, the shaders in 'tools/slang-bench/default-set.txt' are used.\n");
+}
+
+static SlangStage _findStage(UnownedStringSlice const& name)
+{
+    static const struct { char const* name; SlangStage stage; } kStages[] =
+    {
+        { "vertex",         SLANG_STAGE_VERTEX },
+        { "hull",           SLANG_STAGE_HULL },
+        { "domain",         SLANG_STAGE_DOMAIN },
+        { "geometry",       SLANG_STAGE_GEOMETRY },
+        { "fragment",       SLANG_STAGE_FRAGMENT },
+        { "pixel",          SLANG_STAGE_PIXEL },
+        { "compute",        SLANG_STAGE_COMPUTE },
+        { "raygeneration",  SLANG_STAGE_RAY_GENERATION },
+        { "intersection",   SLANG_STAGE_INTERSECTION },
+        { "anyhit",         SLANG_STAGE_ANY_HIT },
+        { "closesthit",     SLANG_STAGE_CLOSEST_HIT },
+        { "miss",           SLANG_STAGE_MISS },
+        { "callable",       SLANG_STAGE_CALLABLE },
+    };
+    for (auto const& entry : kStages)
+    {
+        if (name == entry.name)
+            return entry.stage;
+    }
+    return SLANG_STAGE_NONE;
+}
+
+static SlangResult _addInput(
+    Options&                    options,
+    UnownedStringSlice const&   path,
+    UnownedStringSlice const&   entryPointName,
+    UnownedStringSlice const&   stageName)
+{
+    BenchInput input;
+    input.path = path;
+    input.entryPointName = entryPointName;
+    input.stage = _findStage(stageName);
+    if (input.stage == SLANG_STAGE_NONE)
+    {
+        fprintf(stderr, "error: unknown stage '%s'\n", String(stageName).Buffer());
+        return SLANG_FAIL;
+    }
+
+    if (!File::Exists(input.path))
+    {
+        fprintf(stderr, "error: cannot open '%s'\n", input.path.Buffer());
+        return SLANG_FAIL;
+    }
+    input.sizeInBytes = File::ReadAllText(input.path).Length();
+
+    options.inputs.Add(input);
+    return SLANG_OK;
+}
+
+// Split `in` into the words separated by whitespace
+static void _splitWords(UnownedStringSlice const& in, List<UnownedStringSlice>& outWords)
+{
+    char const* cursor = in.begin();
+    char const* end = in.end();
+    for (;;)
+    {
+        while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
+            cursor++;
+        if (cursor == end)
+            break;
+
+        char const* wordBegin = cursor;
+        while (cursor != end && !(*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
+            cursor++;
+        outWords.Add(UnownedStringSlice(wordBegin, cursor));
+    }
+}
+
+static SlangResult _addInputSet(Options& options, String const& setPath)
+{
+    if (!File::Exists(setPath))
+    {
+        fprintf(stderr, "error: cannot open '%s'\n", setPath.Buffer());
+        return SLANG_FAIL;
+    }
+    String contents = File::ReadAllText(setPath);
+
+    List<UnownedStringSlice> lines;
+    StringUtil::split(contents.getUnownedSlice(), '\n', lines);
+    for (auto const& line : lines)
+    {
+        // Each line is `<file> [<entry point> [<stage>]]`
+        List<UnownedStringSlice> fields;
+        _splitWords(line, fields);
+        if (fields.Count() == 0 || fields[0][0] == '#')
+            continue;
+
+        UnownedStringSlice entryPointName = fields.Count() > 1 ? fields[1] : UnownedStringSlice::fromLiteral("computeMain");
+        UnownedStringSlice stageName = fields.Count() > 2 ? fields[2] : UnownedStringSlice::fromLiteral("compute");
+        SLANG_RETURN_ON_FAIL(_addInput(options, fields[0], entryPointName, stageName));
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _parseOptions(int argc, char** argv, Options& options)
+{
+    String entryPointName = "computeMain";
+    String stageName = "compute";
+    bool hasInputs = false;
+
+    char** argCursor = argv + 1;
+    char** argEnd = argv + argc;
+    while (argCursor != argEnd)
+    {
+        String arg = *argCursor++;
+        if (arg.Length() == 0 || arg[0] != '-')
+        {
+            SLANG_RETURN_ON_FAIL(_addInput(options, arg.getUnownedSlice(), entryPointName.getUnownedSlice(), stageName.getUnownedSlice()));
+            hasInputs = true;
+            continue;
+        }
+
+        if (arg == "-downstream")
+        {
+            options.includeDownstream = true;
+            continue;
+        }
+        else if (arg == "-parallel-check")
+        {
+            options.compileFlags |= SLANG_COMPILE_FLAG_PARALLEL_CHECK;
+            continue;
+        }
+        else if (arg == "-cold")
+        {
+            options.runCold = true;
+            options.runWarm = false;
+            continue;
+        }
+        else if (arg == "-warm")
+        {
+            options.runCold = false;
+            options.runWarm = true;
+            continue;
+        }
+        else if (arg == "-micro")
+        {
+            options.runMicro = true;
+            continue;
+        }
+        else if (arg == "-h" || arg == "-help")
+        {
+            _printUsage();
+            return SLANG_FAIL;
+        }
+
+        // All remaining options take a value
+        if (argCursor == argEnd)
+        {
+            fprintf(stderr, "error: expected an argument for option '%s'\n", arg.Buffer());
+            return SLANG_FAIL;
+        }
+        String value = *argCursor++;
+
+        if (arg == "-set")
+        {
+            SLANG_RETURN_ON_FAIL(_addInputSet(options, value));
+            hasInputs = true;
+        }
+        else if (arg == "-entry")
+        {
+            entryPointName = value;
+        }
+        else if (arg == "-stage")
+        {
+            stageName = value;
+        }
+        else if (arg == "-target")
+        {
+            if (!_findBenchTarget(value.getUnownedSlice()))
+            {
+                fprintf(stderr, "error: unknown target '%s'\n", value.Buffer());
+                return SLANG_FAIL;
+            }
+            options.targetNames.Add(value);
+        }
+        else if (arg == "-iterations")
+        {
+            options.iterations = atoi(value.Buffer());
+            if (options.iterations <= 0)
+            {
+                fprintf(stderr, "error: -iterations must be positive\n");
+                return SLANG_FAIL;
+            }
+        }
+        else if (arg == "-baseline")
+        {
+            options.baselinePath = value;
+        }
+        else if (arg == "-write-baseline")
+        {
+            options.writeBaselinePath = value;
+        }
+        else if (arg == "-filter")
+        {
+            options.microOptions.filter = value;
+        }
+        else if (arg == "-threshold")
+        {
+            options.threshold = atof(value.Buffer()) / 100.0;
+        }
+        else
+        {
+            fprintf(stderr, "error: unknown option '%s'\n", arg.Buffer());
+            _printUsage();
+            return SLANG_FAIL;
+        }
+    }
+
+    if (!hasInputs && !options.runMicro)
+    {
+        SLANG_RETURN_ON_FAIL(_addInputSet(options, "tools/slang-bench/default-set.txt"));
+    }
+
+    if (options.targetNames.Count() == 0)
+    {
+        options.targetNames.Add("hlsl");
+        options.targetNames.Add("glsl");
+    }
+
+    return SLANG_OK;
+}
+
+static uint64_t _getPeakMemoryUsed()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return uint64_t(counters.PeakWorkingSetSize);
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#   ifdef __APPLE__
+    // `ru_maxrss` is in bytes on macOS...
+    return uint64_t(usage.ru_maxrss);
+#   else
+    // ... and in kilobytes on Linux
+    return uint64_t(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+static void _addPhaseTime(List<PhaseTime>& phases, char const* name, double timeInSeconds)
+{
+    for (auto& phase : phases)
+    {
+        if (phase.name == name)
+        {
+            phase.timeInSeconds += timeInSeconds;
+            return;
+        }
+    }
+
+    PhaseTime phase;
+    phase.name = name;
+    phase.timeInSeconds = timeInSeconds;
+    phases.Add(phase);
+}
+
+static SlangResult _compileInput(
+    SlangSession*       session,
+    BenchConfig const&  config,
+    Options const&      options,
+    BenchInput const&   input,
+    List<PhaseTime>&    ioPhases,
+    uint64_t&           ioOutputBytes)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    spSetCompileFlags(request, options.compileFlags);
+    spSetCodeGenTarget(request, config.target->target);
+    spSetTargetProfile(request, 0, spFindProfile(session, config.target->profileName));
+    spSetRecordCompileStats(request, 1);
+
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceFile(request, translationUnitIndex, input.path.Buffer());
+    spAddEntryPoint(request, translationUnitIndex, input.entryPointName.Buffer(), input.stage);
+
+    SlangResult result = spCompile(request);
+    if (SLANG_SUCCEEDED(result))
+    {
+        SlangCompileStats stats;
+        if (SLANG_SUCCEEDED(spGetCompileStats(request, &stats)))
+        {
+            for (SlangUInt i = 0; i < stats.phaseCount; ++i)
+                _addPhaseTime(ioPhases, stats.phases[i].name, stats.phases[i].timeInSeconds);
+            for (SlangUInt i = 0; i < stats.counterCount; ++i)
+            {
+                if (strcmp(stats.counters[i].name, "bytesEmitted") == 0)
+                    ioOutputBytes += stats.counters[i].value;
+            }
+        }
+    }
+    else
+    {
+        fprintf(stderr, "%s: failed to compile '%s':\n%s",
+            config.name.Buffer(),
+            input.path.Buffer(),
+            spGetDiagnosticOutput(request));
+    }
+
+    spDestroyCompileRequest(request);
+    return result;
+}
+
+static SlangResult _compileAllInputs(
+    SlangSession*       session,
+    BenchConfig const&  config,
+    Options const&      options,
+    List<PhaseTime>&    ioPhases,
+    uint64_t&           ioOutputBytes)
+{
+    for (auto const& input : options.inputs)
+    {
+        SLANG_RETURN_ON_FAIL(_compileInput(session, config, options, input, ioPhases, ioOutputBytes));
+    }
+    return SLANG_OK;
+}
+
+static void _runConfig(
+    BenchConfig const&  config,
+    Options const&      options,
+    BenchResult&        outResult)
+{
+    outResult.name = config.name;
+
+    // Check that the target is usable before timing anything, so that
+    // a missing downstream compiler is reported as such, rather than as
+    // a failure to compile each input.
+    {
+        SlangSession* session = spCreateSession(nullptr);
+        SlangResult supportResult = spSessionCheckCompileTargetSupport(session, config.target->target);
+        spDestroySession(session);
+        if (SLANG_FAILED(supportResult))
+            return;
+    }
+
+    List<double> iterationTimes;
+    List<PhaseTime> phases;
+    uint64_t outputBytes = 0;
+
+    SlangSession* warmSession = nullptr;
+    if (config.isWarm)
+    {
+        // The first compile in a session does one-time work (e.g.,
+        // loading downstream compilers), so we do an untimed pass
+        // over the inputs before measuring a warm session.
+        warmSession = spCreateSession(nullptr);
+        List<PhaseTime> warmupPhases;
+        uint64_t warmupOutputBytes = 0;
+        if (SLANG_FAILED(_compileAllInputs(warmSession, config, options, warmupPhases, warmupOutputBytes)))
+        {
+            spDestroySession(warmSession);
+            return;
+        }
+    }
+
+    for (int i = 0; i < options.iterations; ++i)
+    {
+        Timer::Ticks startTicks = Timer::now();
+
+        SlangSession* session = warmSession ? warmSession : spCreateSession(nullptr);
+        SlangResult result = _compileAllInputs(session, config, options, phases, outputBytes);
+        if (!warmSession)
+            spDestroySession(session);
+
+        Timer::Ticks endTicks = Timer::now();
+
+        if (SLANG_FAILED(result))
+        {
+            if (warmSession)
+                spDestroySession(warmSession);
+            return;
+        }
+        iterationTimes.Add(Timer::toSeconds(endTicks - startTicks));
+    }
+
+    if (warmSession)
+        spDestroySession(warmSession);
+
+    iterationTimes.Sort();
+
+    const double compilesPerIteration = double(options.inputs.Count());
+    const double compileCount = compilesPerIteration * options.iterations;
+
+    size_t bytesPerIteration = 0;
+    for (auto const& input : options.inputs)
+        bytesPerIteration += input.sizeInBytes;
+
+    const double medianIterationTime = iterationTimes[iterationTimes.Count() / 2];
+
+    outResult.isAvailable = true;
+    outResult.medianSecondsPerCompile = medianIterationTime / compilesPerIteration;
+    outResult.minSecondsPerCompile = iterationTimes[0] / compilesPerIteration;
+    outResult.compilesPerSecond = compilesPerIteration / medianIterationTime;
+    outResult.sourceBytesPerSecond = double(bytesPerIteration) / medianIterationTime;
+    outResult.peakMemoryBytes = _getPeakMemoryUsed();
+    outResult.outputBytesPerCompile = double(outputBytes) / compileCount;
+
+    for (auto& phase : phases)
+        phase.timeInSeconds /= compileCount;
+    outResult.phases = phases;
+}
+
+static void _printResult(BenchResult const& result)
+{
+    if (!result.isAvailable)
+    {
+        printf("%-16s unavailable\n", result.name.Buffer());
+        return;
+    }
+
+    printf("%-16s %10.3f ms/compile (min %.3f)  %8.1f compiles/s  %8.1f KB/s  peak %.1f MB  output %.0f B/compile\n",
+        result.name.Buffer(),
+        result.medianSecondsPerCompile * 1000.0,
+        result.minSecondsPerCompile * 1000.0,
+        result.compilesPerSecond,
+        result.sourceBytesPerSecond / 1024.0,
+        double(result.peakMemoryBytes) / (1024.0 * 1024.0),
+        result.outputBytesPerCompile);
+
+    for (auto const& phase : result.phases)
+    {
+        printf("    %-40s %10.3f ms\n", phase.name.Buffer(), phase.timeInSeconds * 1000.0);
+    }
+}
+
+static void _appendBaseline(List<BenchResult> const& results, Options const& options, StringBuilder& out)
+{
+    out << "{\n";
+    StringUtil::appendFormat(out, "  \"iterations\": %d,\n", options.iterations);
+    out << "  \"results\": [";
+
+    bool isFirst = true;
+    for (auto const& result : results)
+    {
+        if (!result.isAvailable)
+            continue;
+
+        out << (isFirst ? "\n" : ",\n");
+        isFirst = false;
+
+        StringUtil::appendFormat(out,
+            "    { \"name\": \"%s\", \"msPerCompile\": %.6f, \"compilesPerSecond\": %.3f, \"peakMemoryBytes\": %llu, \"outputBytesPerCompile\": %.1f }",
+            result.name.Buffer(),
+            result.medianSecondsPerCompile * 1000.0,
+            result.compilesPerSecond,
+            (unsigned long long)result.peakMemoryBytes,
+            result.outputBytesPerCompile);
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Read the `name`/`<valueKey>` pairs back from a baseline written by `_appendBaseline`
+// or `_appendMicroBaseline`.
+//
+// This is not a general JSON parser; it only handles the layout that we write.
+static SlangResult _readBaseline(String const& path, char const* valueKey, List<BaselineEntry>& outEntries)
+{
+    if (!File::Exists(path))
+    {
+        fprintf(stderr, "error: cannot open baseline '%s'\n", path.Buffer());
+        return SLANG_FAIL;
+    }
+    String contents = File::ReadAllText(path);
+
+    static const char kNameKey[] = "\"name\":";
+
+    StringBuilder valueKeyBuilder;
+    valueKeyBuilder << "\"" << valueKey << "\":";
+    String timeKey = valueKeyBuilder.ProduceString();
+
+    UInt cursor = 0;
+    for (;;)
+    {
+        UInt nameKeyIndex = contents.IndexOf(kNameKey, cursor);
+        if (nameKeyIndex == UInt(-1))
+            break;
+
+        UInt nameStart = contents.IndexOf('"', nameKeyIndex + sizeof(kNameKey) - 1);
+        UInt nameEnd = nameStart == UInt(-1) ? UInt(-1) : contents.IndexOf('"', nameStart + 1);
+        UInt timeKeyIndex = nameEnd == UInt(-1) ? UInt(-1) : contents.IndexOf(timeKey, nameEnd);
+        if (timeKeyIndex == UInt(-1))
+        {
+            fprintf(stderr, "error: malformed baseline '%s'\n", path.Buffer());
+            return SLANG_FAIL;
+        }
+
+        BaselineEntry entry;
+        entry.name = contents.SubString(nameStart + 1, nameEnd - nameStart - 1);
+        entry.value = atof(contents.Buffer() + timeKeyIndex + timeKey.Length());
+        outEntries.Add(entry);
+
+        cursor = timeKeyIndex;
+    }
+    return SLANG_OK;
+}
+
+// Returns the number of measurements that regressed relative to the baseline.
+static int _compareWithBaseline(
+    List<BaselineEntry> const&  current,
+    List<BaselineEntry> const&  baseline,
+    double                      threshold,
+    char const*                 unit)
+{
+    printf("\nComparison with baseline (threshold %.1f%%):\n", threshold * 100.0);
+
+    int regressionCount = 0;
+    for (auto const& measurement : current)
+    {
+        BaselineEntry const* baselineEntry = nullptr;
+        for (auto const& entry : baseline)
+        {
+            if (entry.name == measurement.name)
+            {
+                baselineEntry = &entry;
+                break;
+            }
+        }
+
+        if (!baselineEntry || baselineEntry->value <= 0.0)
+        {
+            printf("%-36s %10.3f %s (no baseline)\n", measurement.name.Buffer(), measurement.value, unit);
+            continue;
+        }
+
+        const double change = measurement.value / baselineEntry->value - 1.0;
+        const bool isRegression = change > threshold;
+        if (isRegression)
+            regressionCount++;
+
+        printf("%-36s %10.3f %s vs %10.3f %s  %+6.1f%%%s\n",
+            measurement.name.Buffer(),
+            measurement.value,
+            unit,
+            baselineEntry->value,
+            unit,
+            change * 100.0,
+            isRegression ? "  REGRESSION" : "");
+    }
+    return regressionCount;
+}
+
+static SlangResult _writeTextFile(String const& path, StringBuilder const& text)
+{
+    FILE* file = fopen(path.Buffer(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "error: cannot write '%s'\n", path.Buffer());
+        return SLANG_FAIL;
+    }
+    fwrite(text.Buffer(), text.Length(), 1, file);
+    fclose(file);
+    return SLANG_OK;
+}
+
+static void _appendMicroBaseline(List<MicroBenchResult> const& results, StringBuilder& out)
+{
+    out << "{\n";
+    out << "  \"results\": [";
+
+    bool isFirst = true;
+    for (auto const& result : results)
+    {
+        out << (isFirst ? "\n" : ",\n");
+        isFirst = false;
+
+        StringUtil::appendFormat(out,
+            "    { \"name\": \"%s\", \"nsPerOp\": %.4f, \"minNsPerOp\": %.4f, \"operationCount\": %llu }",
+            result.name.Buffer(),
+            result.nsPerOp,
+            result.minNsPerOp,
+            (unsigned long long)result.operationCount);
+    }
+    out << "\n  ]\n}\n";
+}
+
+static SlangResult _runMicroBenchmarks(Options const& options, int& outRegressionCount)
+{
+    printf("slang-bench: micro benchmarks\n\n");
+
+    List<MicroBenchResult> results;
+    runMicroBenchmarks(options.microOptions, results);
+
+    List<BaselineEntry> current;
+    for (auto const& result : results)
+    {
+        printf("%-36s %10.3f ns/op (min %.3f)  %12.0f ops/s\n",
+            result.name.Buffer(),
+            result.nsPerOp,
+            result.minNsPerOp,
+            result.nsPerOp > 0.0 ? 1.0e9 / result.nsPerOp : 0.0);
+
+        BaselineEntry entry;
+        entry.name = result.name;
+        entry.value = result.nsPerOp;
+        current.Add(entry);
+    }
+
+    if (options.writeBaselinePath.Length())
+    {
+        StringBuilder baseline;
+        _appendMicroBaseline(results, baseline);
+        SLANG_RETURN_ON_FAIL(_writeTextFile(options.writeBaselinePath, baseline));
+    }
+
+    if (options.baselinePath.Length())
+    {
+        List<BaselineEntry> baseline;
+        SLANG_RETURN_ON_FAIL(_readBaseline(options.baselinePath, "nsPerOp", baseline));
+        outRegressionCount = _compareWithBaseline(current, baseline, options.threshold, "ns/op");
+    }
+
+    return SLANG_OK;
+}
+
+static void _addConfigs(Options const& options, bool isWarm, List<BenchConfig>& outConfigs)
+{
+    for (auto const& targetName : options.targetNames)
+    {
+        BenchTarget const* target = _findBenchTarget(targetName.getUnownedSlice());
+
+        BenchConfig config;
+        config.isWarm = isWarm;
+        config.target = target;
+        config.name = String(isWarm ? "warm/" : "cold/") + target->name;
+        outConfigs.Add(config);
+
+        // With `-downstream`, each source target is also benchmarked
+        // through the downstream compiler(s) that consume it.
+        if (options.includeDownstream && !target->usesDownstream)
+        {
+            for (auto const& downstreamTarget : kBenchTargets)
+            {
+                if (!downstreamTarget.usesDownstream || !(targetName == downstreamTarget.sourceTargetName))
+                    continue;
+
+                config.target = &downstreamTarget;
+                config.name = String(isWarm ? "warm/" : "cold/") + downstreamTarget.name;
+                outConfigs.Add(config);
+            }
+        }
+    }
+}
+
+static SlangResult _innerMain(int argc, char** argv, int& outRegressionCount)
+{
+    Options options;
+    SLANG_RETURN_ON_FAIL(_parseOptions(argc, argv, options));
+
+    if (options.runMicro)
+        return _runMicroBenchmarks(options, outRegressionCount);
+
+    List<BenchConfig> configs;
+    if (options.runCold)
+        _addConfigs(options, false, configs);
+    if (options.runWarm)
+        _addConfigs(options, true, configs);
+
+    printf("slang-bench: %d file(s), %d iteration(s) per configuration\n\n",
+        int(options.inputs.Count()),
+        options.iterations);
+
+    List<BenchResult> results;
+    for (auto const& config : configs)
+    {
+        BenchResult result;
+        _runConfig(config, options, result);
+        _printResult(result);
+        results.Add(result);
+    }
+
+    if (options.writeBaselinePath.Length())
+    {
+        StringBuilder baseline;
+        _appendBaseline(results, options, baseline);
+        SLANG_RETURN_ON_FAIL(_writeTextFile(options.writeBaselinePath, baseline));
+    }
+
+    if (options.baselinePath.Length())
+    {
+        List<BaselineEntry> current;
+        List<BaselineEntry> currentOutput;
+        for (auto const& result : results)
+        {
+            if (!result.isAvailable)
+                continue;
+
+            BaselineEntry entry;
+            entry.name = result.name;
+            entry.value = result.medianSecondsPerCompile * 1000.0;
+            current.Add(entry);
+
+            entry.value = result.outputBytesPerCompile;
+            currentOutput.Add(entry);
+        }
+
+        List<BaselineEntry> baseline;
+        SLANG_RETURN_ON_FAIL(_readBaseline(options.baselinePath, "msPerCompile", baseline));
+        outRegressionCount = _compareWithBaseline(current, baseline, options.threshold, "ms");
+
+        // The size of the generated code is compared too, so that changes
+        // to the optimization passes show up in the same report.
+        List<BaselineEntry> outputBaseline;
+        SLANG_RETURN_ON_FAIL(_readBaseline(options.baselinePath, "outputBytesPerCompile", outputBaseline));
+        outRegressionCount += _compareWithBaseline(currentOutput, outputBaseline, options.threshold, "B");
+    }
+
+    return SLANG_OK;
+}
+
+int main(int argc, char** argv)
+{
+    int regressionCount = 0;
+    SlangResult res = _innerMain(argc, argv, regressionCount);
+    if (SLANG_FAILED(res))
+        return 2;
+    return regressionCount ? 1 : 0;
+}
@@ -1895,6 +1895,8 @@ SlangResult innerMain(int argc, char** argv)
     auto vulkanTestCategory = categorySet.add("vulkan", fullTestCategory);
     auto unitTestCatagory = categorySet.add("unit-test", fullTestCategory);
     auto compatibilityIssueCatagory = categorySet.add("compatibility-issue", fullTestCategory);
+    // Tests that take too long to be part of `full`, and so are only run when asked for
+    categorySet.add("long-running", nullptr);
     
 #if SLANG_WINDOWS_FAMILY
     auto windowsCatagory = categorySet.add("windows", fullTestCategory);
@@ -2005,8 +2007,10 @@ SlangResult innerMain(int argc, char** argv)
                 StringBuilder filePath;
                 filePath << "unit-tests/" << cur->m_name << ".internal";
 
+                TestCategory* testCategory = cur->m_category ? categorySet.find(cur->m_category) : unitTestCatagory;
+
                 TestOptions testOptions;
-                testOptions.categories.Add(unitTestCatagory);
+                testOptions.categories.Add(testCategory ? testCategory : unitTestCatagory);
                 testOptions.command = filePath;
 
                 if (shouldRunTest(&context, testOptions.command))
@@ -15,22 +15,26 @@ struct TestRegister
 {
     typedef void (*TestFunc)();
 
-    TestRegister(const char* name, TestFunc func):
+    TestRegister(const char* name, TestFunc func, const char* category = nullptr):
         m_next(s_first),
         m_name(name),
-        m_func(func)
+        m_func(func),
+        m_category(category)
     {
         s_first = this;
     }
 
     TestFunc m_func;
     const char* m_name;
+    const char* m_category;                 ///< The category of the test. If nullptr the test is in the 'unit-test' category
     TestRegister* m_next;
 
     static TestRegister* s_first;
 };
 
-#define SLANG_UNIT_TEST(name, func) static TestRegister s_unitTest##__LINE__(name, func)
+#define SLANG_UNIT_TEST(name, func) static TestRegister SLANG_CONCAT(s_unitTest, __LINE__)(name, func)
+    /// Register a unit test that is only run when `category` is selected (such as 'long-running')
+#define SLANG_UNIT_TEST_IN_CATEGORY(name, category, func) static TestRegister SLANG_CONCAT(s_unitTest, __LINE__)(name, func, category)
 
 enum class TestOutputMode
 {
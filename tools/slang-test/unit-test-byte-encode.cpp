@@ -116,6 +116,49 @@ static void byteEncodeUnitTest()
         SLANG_CHECK(memcmp(decodeBuffer.begin(), initialBuffer.begin(), sizeof(uint32_t) * blockSize) == 0);
     }
 
+    {
+        // Mostly single byte values, with multi byte values in runs and on their own, so that the SIMD decode
+        // (which decodes runs of single byte values) has to move in and out of runs in every position
+        const int blockSize = 1000;
+
+        List<uint32_t> initialBuffer;
+        initialBuffer.SetSize(blockSize);
+        for (int i = 0; i < blockSize; i++)
+        {
+            const int32_t kind = randGen.nextInt32UpTo(16);
+            uint32_t value = uint32_t(randGen.nextInt32());
+            if (kind < 12)
+            {
+                value %= ByteEncodeUtil::kLiteCut1;
+            }
+            else if (kind < 15)
+            {
+                value &= 0xffff;
+            }
+            initialBuffer[i] = value;
+        }
+
+        List<uint8_t> encodedBuffer;
+        ByteEncodeUtil::encodeLiteUInt32(initialBuffer.begin(), blockSize, encodedBuffer);
+
+        List<uint32_t> decodeBuffer;
+        decodeBuffer.SetSize(blockSize);
+        List<uint32_t> scalarDecodeBuffer;
+        scalarDecodeBuffer.SetSize(blockSize);
+
+        // Decode different amounts, so all the ways the tail can be handled are tested
+        for (int numValues = 0; numValues <= blockSize; numValues += 1 + (numValues >> 2))
+        {
+            const size_t numBytes = ByteEncodeUtil::decodeLiteUInt32(encodedBuffer.begin(), numValues, decodeBuffer.begin());
+            const size_t numScalarBytes = ByteEncodeUtil::decodeLiteUInt32Scalar(encodedBuffer.begin(), numValues, scalarDecodeBuffer.begin());
+
+            SLANG_CHECK(numBytes == numScalarBytes);
+            SLANG_CHECK(numBytes == ByteEncodeUtil::calcEncodeLiteSizeUInt32(initialBuffer.begin(), numValues));
+            SLANG_CHECK(memcmp(decodeBuffer.begin(), initialBuffer.begin(), sizeof(uint32_t) * numValues) == 0);
+            SLANG_CHECK(memcmp(scalarDecodeBuffer.begin(), initialBuffer.begin(), sizeof(uint32_t) * numValues) == 0);
+        }
+    }
+
     {
         checkUInt32(uint32_t(0));
         checkUInt32(uint32_t(0x7fffff));
@@ -0,0 +1,103 @@
+// unit-test-chunked-string-builder.cpp
+
+#include "../../source/core/slang-chunked-string-builder.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/list.h"
+
+using namespace Slang;
+
+static void chunkedStringBuilderUnitTest()
+{
+    DefaultRandomGenerator randGen(0x4e21a7);
+
+    {
+        ChunkedStringBuilder builder;
+        SLANG_CHECK(builder.getLength() == 0);
+        SLANG_CHECK(builder.produceString() == "");
+
+        builder.append("world");
+        builder.prepend(String("Hello "));
+        builder.append(UnownedStringSlice("!"));
+        SLANG_CHECK(builder.getLength() == 12);
+        SLANG_CHECK(builder.produceString() == "Hello world!");
+
+        builder.clear();
+        SLANG_CHECK(builder.getLength() == 0 && builder.produceString() == "");
+    }
+
+    // Build a large string from appends of random sizes, and check it matches one built with a StringBuilder
+    {
+        StringBuilder expected;
+        ChunkedStringBuilder builder;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            StringBuilder piece;
+            const int32_t length = randGen.nextInt32UpTo(randGen.nextInt32UpTo(8) == 0 ? 5000 : 50);
+            for (int32_t j = 0; j < length; ++j)
+            {
+                piece.append(char('a' + randGen.nextInt32UpTo(26)));
+            }
+
+            if (randGen.nextInt32UpTo(2))
+            {
+                builder.append(piece.begin(), piece.end());
+            }
+            else
+            {
+                builder.append(piece.ProduceString());
+            }
+            expected.append(piece.ProduceString());
+        }
+
+        // Text appended should never have been moved, so there are multiple chunks, none of which is too big
+        SLANG_CHECK(builder.getChunks().Count() > 1);
+        UInt totalLength = 0;
+        bool chunksAreSmall = true;
+        for (const auto& chunk : builder.getChunks())
+        {
+            totalLength += chunk.Length();
+            chunksAreSmall = chunksAreSmall && chunk.Length() <= ChunkedStringBuilder::kMaxChunkSize;
+        }
+        SLANG_CHECK(chunksAreSmall);
+        SLANG_CHECK(totalLength == builder.getLength());
+        SLANG_CHECK(builder.getLength() == expected.Length());
+
+        // Prepend another builder
+        ChunkedStringBuilder prefix;
+        prefix.append("#version 450\n");
+        prefix.append("#extension GL_EXT_nonuniform_qualifier : require\n");
+
+        String prefixString = prefix.produceString();
+        builder.prepend(prefix);
+        SLANG_CHECK(prefix.getLength() == 0);
+
+        StringBuilder expectedWithPrefix;
+        expectedWithPrefix << prefixString << expected;
+        SLANG_CHECK(builder.produceString() == expectedWithPrefix.ProduceString());
+    }
+
+    // A single chunk is shared rather than copied
+    {
+        ChunkedStringBuilder builder;
+        builder.append("tiny");
+
+        String a = builder.produceString();
+        String b = builder.produceString();
+        SLANG_CHECK(a == "tiny" && a.getStringRepresentation() == b.getStringRepresentation());
+
+        // Appending after the chunk has been shared mustn't change the produced string
+        builder.append(" and more");
+        SLANG_CHECK(a == "tiny");
+        SLANG_CHECK(builder.produceString() == "tiny and more");
+    }
+}
+
+SLANG_UNIT_TEST("ChunkedStringBuilder", chunkedStringBuilderUnitTest);
@@ -0,0 +1,248 @@
+// unit-test-float-to-string.cpp
+
+#include "../../source/core/slang-float-to-string.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+// Returns the number of significant digits in text
+static int _calcSignificantDigitCount(const char* text)
+{
+    const char* first = nullptr;
+    const char* last = nullptr;
+    for (const char* cur = text; *cur && *cur != 'e'; ++cur)
+    {
+        if (*cur >= '1' && *cur <= '9')
+        {
+            first = first ? first : cur;
+            last = cur;
+        }
+    }
+    if (!first)
+    {
+        return 1;
+    }
+    int count = 0;
+    for (const char* cur = first; cur <= last; ++cur)
+    {
+        count += (*cur >= '0' && *cur <= '9') ? 1 : 0;
+    }
+    return count;
+}
+
+// Checks the text converts back to the same value, and that there isn't any shorter text that does
+static bool _checkFloat(float value)
+{
+    char text[FloatToStringUtil::kMaxChars + 1];
+    text[FloatToStringUtil::toChars(value, text)] = 0;
+
+    const float parsed = strtof(text, nullptr);
+    if (memcmp(&parsed, &value, sizeof(value)) != 0 || !strchr(text, '.'))
+    {
+        return false;
+    }
+
+    const int digitCount = _calcSignificantDigitCount(text);
+    if (digitCount > 1)
+    {
+        char shorter[64];
+        snprintf(shorter, sizeof(shorter), "%.*g", digitCount - 1, value);
+        return strtof(shorter, nullptr) != value;
+    }
+    return true;
+}
+
+static bool _checkDouble(double value)
+{
+    char text[FloatToStringUtil::kMaxChars + 1];
+    text[FloatToStringUtil::toChars(value, text)] = 0;
+
+    const double parsed = strtod(text, nullptr);
+    if (memcmp(&parsed, &value, sizeof(value)) != 0 || !strchr(text, '.'))
+    {
+        return false;
+    }
+
+    const int digitCount = _calcSignificantDigitCount(text);
+    if (digitCount > 1)
+    {
+        char shorter[64];
+        snprintf(shorter, sizeof(shorter), "%.*g", digitCount - 1, value);
+        return strtod(shorter, nullptr) != value;
+    }
+    return true;
+}
+
+static float _floatFromBits(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// True unless value is a NaN or an infinity, which are written as 'nan' and 'inf' rather than as numbers
+static bool _isFinite(float value)
+{
+    return value - value == 0.0f;
+}
+
+static double _doubleFromBits(uint64_t bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool _isEqual(double value, const char* expected)
+{
+    char text[FloatToStringUtil::kMaxChars + 1];
+    text[FloatToStringUtil::toChars(value, text)] = 0;
+    return strcmp(text, expected) == 0;
+}
+
+static bool _isEqual(float value, const char* expected)
+{
+    char text[FloatToStringUtil::kMaxChars + 1];
+    text[FloatToStringUtil::toChars(value, text)] = 0;
+    return strcmp(text, expected) == 0;
+}
+
+static void floatToStringUnitTest()
+{
+    DefaultRandomGenerator randGen(0x1f2e3d4c);
+
+    // Formatting
+    {
+        SLANG_CHECK(_isEqual(0.0, "0.0"));
+        SLANG_CHECK(_isEqual(-0.0, "-0.0"));
+        SLANG_CHECK(_isEqual(2.0, "2.0"));
+        SLANG_CHECK(_isEqual(-0.5, "-0.5"));
+        SLANG_CHECK(_isEqual(0.1, "0.1"));
+        SLANG_CHECK(_isEqual(1234.5, "1234.5"));
+        SLANG_CHECK(_isEqual(0.00001, "0.00001"));
+        SLANG_CHECK(_isEqual(1.5e-7, "1.5e-7"));
+        SLANG_CHECK(_isEqual(1e15, "1000000000000000.0"));
+        SLANG_CHECK(_isEqual(1e30, "1.0e30"));
+        SLANG_CHECK(_isEqual(5e-324, "5.0e-324"));
+        SLANG_CHECK(_isEqual(1.7976931348623157e308, "1.7976931348623157e308"));
+
+        const double zero = 0.0;
+        SLANG_CHECK(_isEqual(1.0 / zero, "inf"));
+        SLANG_CHECK(_isEqual(-1.0 / zero, "-inf"));
+        SLANG_CHECK(_isEqual(zero / zero, "nan"));
+
+        // A float only needs the digits to round trip as a float
+        SLANG_CHECK(_isEqual(0.1f, "0.1"));
+        SLANG_CHECK(_isEqual(double(0.1f), "0.10000000149011612"));
+        SLANG_CHECK(_isEqual(16777216.0f, "16777216.0"));
+        SLANG_CHECK(_isEqual(3.4028235e38f, "3.4028235e38"));
+        SLANG_CHECK(_isEqual(_floatFromBits(1), "1.0e-45"));
+    }
+
+    // String and StringBuilder use the shortest text by default
+    {
+        StringBuilder builder;
+        builder << 0.3 << " " << 0.3f << " " << 100.0;
+        SLANG_CHECK(builder == "0.3 0.3 100.0");
+        SLANG_CHECK(String(1.0e-10) == "1.0e-10");
+        SLANG_CHECK(String(1.5, "%.3f") == "1.500");
+    }
+
+    // Edge cases
+    {
+        const uint32_t floatBits[] =
+        {
+            0x00000001, 0x00000007, 0x00000008, 0x007fffff, 0x00800000, 0x00800001, 0x7f7fffff,
+            0x3f800000, 0x3f7fffff, 0x3f800001, 0x4b800000, 0x4b7fffff,
+        };
+        for (auto bits : floatBits)
+        {
+            SLANG_CHECK(_checkFloat(_floatFromBits(bits)));
+            SLANG_CHECK(_checkFloat(-_floatFromBits(bits)));
+        }
+
+        const uint64_t doubleBits[] =
+        {
+            1, 2, 3, SLANG_UINT64(0x000fffffffffffff), SLANG_UINT64(0x0010000000000000), SLANG_UINT64(0x0010000000000001),
+            SLANG_UINT64(0x7fefffffffffffff), SLANG_UINT64(0x3ff0000000000000), SLANG_UINT64(0x3fefffffffffffff),
+            SLANG_UINT64(0x4340000000000000), SLANG_UINT64(0x433fffffffffffff),
+        };
+        for (auto bits : doubleBits)
+        {
+            SLANG_CHECK(_checkDouble(_doubleFromBits(bits)));
+            SLANG_CHECK(_checkDouble(-_doubleFromBits(bits)));
+        }
+
+        // Powers of 10 and 2, where the rounding interval can be asymmetric
+        double pow10 = 1.0;
+        double pow2 = 1.0;
+        bool allPassed = true;
+        for (int i = 0; i < 300; ++i)
+        {
+            allPassed = allPassed && _checkDouble(pow10) && _checkDouble(1.0 / pow10) && _checkDouble(pow2) && _checkDouble(1.0 / pow2);
+            if (pow10 < 1e38)
+            {
+                allPassed = allPassed && _checkFloat(float(pow10)) && _checkFloat(float(1.0 / pow10)) && _checkFloat(float(pow2)) && _checkFloat(float(1.0 / pow2));
+            }
+            pow10 *= 10.0;
+            pow2 *= 2.0;
+        }
+        SLANG_CHECK(allPassed);
+    }
+
+    // Random doubles, with exponents of any size, and with significands with lots of trailing zeros
+    {
+        bool allPassed = true;
+        for (int i = 0; i < 100000; ++i)
+        {
+            uint64_t bits = uint64_t(randGen.nextInt64());
+            bits = (i & 1) ? (bits & ~SLANG_UINT64(0xffffffff)) : bits;
+            const double value = _doubleFromBits(bits);
+            if (value == value)
+            {
+                allPassed = allPassed && _checkDouble(value);
+            }
+        }
+        SLANG_CHECK(allPassed);
+    }
+
+    // A spread of floats. Every float is tested by the long running FloatToStringAllFloats test.
+    {
+        bool allPassed = true;
+        for (int64_t i = 0; i < SLANG_INT64(0x100000000); i += 9973)
+        {
+            const float value = _floatFromBits(uint32_t(i));
+            if (_isFinite(value))
+            {
+                allPassed = allPassed && _checkFloat(value);
+            }
+        }
+        SLANG_CHECK(allPassed);
+    }
+}
+
+static void floatToStringAllFloatsUnitTest()
+{
+    bool allPassed = true;
+    for (int64_t i = 0; i < SLANG_INT64(0x100000000); ++i)
+    {
+        const float value = _floatFromBits(uint32_t(i));
+        if (_isFinite(value))
+        {
+            allPassed = allPassed && _checkFloat(value);
+        }
+    }
+    SLANG_CHECK(allPassed);
+}
+
+SLANG_UNIT_TEST("FloatToString", floatToStringUnitTest);
+SLANG_UNIT_TEST_IN_CATEGORY("FloatToStringAllFloats", "long-running", floatToStringAllFloatsUnitTest);
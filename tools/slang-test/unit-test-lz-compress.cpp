@@ -0,0 +1,135 @@
+// unit-test-lz-compress.cpp
+
+#include "../../source/core/slang-lz-compress-util.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/list.h"
+
+using namespace Slang;
+
+static void checkRoundTrip(const List<uint8_t>& data)
+{
+    const size_t size = size_t(data.Count());
+
+    List<uint8_t> compressed;
+    LZCompressUtil::compress(data.begin(), size, compressed);
+
+    SLANG_CHECK(size_t(compressed.Count()) <= LZCompressUtil::calcMaxCompressedSize(size));
+
+    // Add some space at the end, to check nothing is written past the decompressed size
+    List<uint8_t> decompressed;
+    decompressed.SetSize(UInt(size + 16));
+    memset(decompressed.begin(), 0xcd, size + 16);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(LZCompressUtil::decompress(compressed.begin(), size_t(compressed.Count()), decompressed.begin(), size)));
+    SLANG_CHECK(memcmp(decompressed.begin(), data.begin(), size) == 0);
+
+    bool isGuardIntact = true;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        isGuardIntact = isGuardIntact && decompressed[UInt(size + i)] == 0xcd;
+    }
+    SLANG_CHECK(isGuardIntact);
+
+    // Decompressing to the wrong size must fail
+    if (size > 0)
+    {
+        SLANG_CHECK(SLANG_FAILED(LZCompressUtil::decompress(compressed.begin(), size_t(compressed.Count()), decompressed.begin(), size - 1)));
+    }
+    SLANG_CHECK(SLANG_FAILED(LZCompressUtil::decompress(compressed.begin(), size_t(compressed.Count()), decompressed.begin(), size + 1)));
+}
+
+static void lzCompressUnitTest()
+{
+    DefaultRandomGenerator randGen(0x73a8e2c1);
+
+    // Empty and tiny inputs
+    {
+        List<uint8_t> data;
+        checkRoundTrip(data);
+        for (int i = 0; i < 20; ++i)
+        {
+            data.Add(uint8_t(i & 3));
+            checkRoundTrip(data);
+        }
+    }
+
+    // Runs of a single byte (match offset of 1), and short repeating patterns (overlapping matches)
+    for (int period = 1; period <= 17; ++period)
+    {
+        List<uint8_t> data;
+        for (int i = 0; i < 1000; ++i)
+        {
+            data.Add(uint8_t((i % period) * 31));
+        }
+        checkRoundTrip(data);
+    }
+
+    // Random data that doesn't compress
+    {
+        List<uint8_t> data;
+        data.SetSize(5000);
+        for (auto& b : data)
+        {
+            b = uint8_t(randGen.nextInt32());
+        }
+        checkRoundTrip(data);
+    }
+
+    // Data built from random pieces of earlier data, with random bytes in between, so there are literals
+    // and matches of all lengths and offsets (including past the largest offset)
+    {
+        List<uint8_t> data;
+        while (data.Count() < 200000)
+        {
+            if (data.Count() < 16 || randGen.nextInt32UpTo(4) == 0)
+            {
+                const int numLiterals = randGen.nextInt32UpTo(300);
+                for (int i = 0; i < numLiterals; ++i)
+                {
+                    data.Add(uint8_t(randGen.nextInt32()));
+                }
+            }
+            else
+            {
+                const UInt start = UInt(randGen.nextInt32UpTo(int32_t(data.Count()) - 8));
+                const UInt length = UInt(randGen.nextInt32UpTo(600));
+                for (UInt i = 0; i < length && start + i < data.Count(); ++i)
+                {
+                    data.Add(data[start + i]);
+                }
+            }
+        }
+        checkRoundTrip(data);
+    }
+
+    // Truncated compressed data must fail without reading past the end
+    {
+        List<uint8_t> data;
+        for (int i = 0; i < 2000; ++i)
+        {
+            data.Add(uint8_t((i * i) >> 5));
+        }
+
+        List<uint8_t> compressed;
+        LZCompressUtil::compress(data.begin(), size_t(data.Count()), compressed);
+
+        List<uint8_t> decompressed;
+        decompressed.SetSize(data.Count());
+
+        bool allFailed = true;
+        for (UInt i = 0; i < compressed.Count(); ++i)
+        {
+            allFailed = allFailed && SLANG_FAILED(LZCompressUtil::decompress(compressed.begin(), size_t(i), decompressed.begin(), size_t(data.Count())));
+        }
+        SLANG_CHECK(allFailed);
+    }
+}
+
+SLANG_UNIT_TEST("LZCompress", lzCompressUnitTest);
@@ -263,6 +263,53 @@ static void memoryArenaUnitTest()
             }
         }
     }
+    {
+        // Allocations with a larger alignment than the block alignment must be aligned,
+        // including when they are the first allocation in a new block
+        MemoryArena arena;
+        arena.init(1024);
+
+        for (int i = 0; i < 100; i++)
+        {
+            void* mem = arena.allocateAligned(100, 64);
+            SLANG_CHECK((size_t(mem) & 63) == 0);
+        }
+    }
+    {
+        // Swapping arenas transfers ownership of all allocations
+        MemoryArena arena;
+        arena.init(1024);
+
+        MemoryArena otherArena;
+        otherArena.init(1024);
+
+        List<Block> blocks;
+        for (int i = 0; i < 100; i++)
+        {
+            Block block;
+            block.m_size = 100;
+            block.m_value = uint8_t(i);
+            block.m_data = arena.allocate(block.m_size);
+            ::memset(block.m_data, block.m_value, block.m_size);
+            blocks.Add(block);
+        }
+        const size_t usedSize = arena.calcTotalMemoryUsed();
+
+        arena.swapWith(otherArena);
+
+        SLANG_CHECK(arena.calcTotalMemoryUsed() == 0);
+        SLANG_CHECK(otherArena.calcTotalMemoryUsed() == usedSize);
+        for (int i = 0; i < int(blocks.Count()); ++i)
+        {
+            const Block& block = blocks[i];
+            SLANG_CHECK(otherArena.isValid(block.m_data, block.m_size));
+            SLANG_CHECK(hasValue((uint8_t*)block.m_data, block.m_size, block.m_value));
+        }
+
+        // Both arenas remain usable
+        SLANG_CHECK(arena.allocate(100) != nullptr);
+        SLANG_CHECK(otherArena.allocate(100) != nullptr);
+    }
     {
         // Do lots of allocations and test out rewind
         